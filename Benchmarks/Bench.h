@@ -0,0 +1,226 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+
+namespace avt {
+
+	namespace bench {
+
+		// heap allocations made by the process, counted by the operator new replacement in MathBench.cpp
+		std::atomic<size_t>& allocations();
+
+		// forces value to be computed and stored without the compiler seeing what reads it
+#if defined(_MSC_VER)
+		extern const volatile void* escape;
+
+		template<typename T>
+		inline void keep(const T& value) {
+			escape = &value;
+			_ReadWriteBarrier();
+		}
+#else
+		template<typename T>
+		inline void keep(const T& value) {
+			asm volatile("" : : "r"(&value) : "memory");
+		}
+#endif
+
+		struct Result {
+			std::string group;
+			std::string name;
+			std::string simd; // level of the kernel behind the operation, "none" for plain C++
+			size_t batch; // elements processed by one op
+			double nsPerOp; // median of the samples
+			double nsPerOpMin;
+			double allocsPerOp;
+			size_t iterations; // per sample
+		};
+
+		struct Case {
+			std::string group;
+			std::string name;
+			std::string simd;
+			size_t batch;
+			std::function<void(size_t)> run; // runs the op n times
+		};
+
+		// the loop lives inside the std::function so the call overhead is paid once per sample
+		template<typename F>
+		std::function<void(size_t)> loop(F body) {
+			return [body](size_t n) mutable {
+				for (size_t i = 0; i < n; i++) body(i);
+			};
+		}
+
+		class Runner {
+		private:
+			std::vector<Case> _cases;
+			double _minSampleMs = 10.0;
+			int _samples = 5;
+
+		public:
+			void setMinSampleTime(double ms) {
+				_minSampleMs = ms;
+			}
+
+			void setSamples(int samples) {
+				_samples = samples < 1 ? 1 : samples;
+			}
+
+			template<typename F>
+			void add(const std::string& group, const std::string& name, F body, const std::string& simd = "none", size_t batch = 1) {
+				_cases.push_back({ group, name, simd, batch, loop(body) });
+			}
+
+			// cases whose "group::name" contains filter (all when empty)
+			std::vector<Result> run(const std::string& filter) const {
+				using clock = std::chrono::steady_clock;
+				std::vector<Result> results;
+
+				for (const Case& c : _cases) {
+					std::string full = c.group + "::" + c.name;
+					if (!filter.empty() && full.find(filter) == std::string::npos) continue;
+
+					// an untimed run first, so scratch buffers growing on first use aren't counted
+					c.run(1);
+
+					// grow the iteration count until one sample takes long enough to time
+					size_t n = 1;
+					for (;;) {
+						auto t0 = clock::now();
+						c.run(n);
+						double ms = std::chrono::duration<double, std::milli>(clock::now() - t0).count();
+						if (ms >= _minSampleMs || n >= (size_t(1) << 34)) break;
+						n = ms <= 0.01 ? n * 16 : static_cast<size_t>(n * (_minSampleMs * 1.2 / ms)) + 1;
+					}
+
+					std::vector<double> ns;
+					size_t allocs = 0;
+					for (int s = 0; s < _samples; s++) {
+						size_t a0 = allocations().load();
+						auto t0 = clock::now();
+						c.run(n);
+						auto t1 = clock::now();
+						allocs += allocations().load() - a0;
+						ns.push_back(std::chrono::duration<double, std::nano>(t1 - t0).count() / n);
+					}
+					std::sort(ns.begin(), ns.end());
+
+					results.push_back({ c.group, c.name, c.simd, c.batch, ns[ns.size() / 2], ns[0],
+						static_cast<double>(allocs) / (static_cast<double>(n) * _samples), n });
+				}
+
+				return results;
+			}
+		};
+
+		// minimal JSON output, enough for flat objects of strings, numbers and booleans
+		class JsonWriter {
+		private:
+			std::string _out;
+			std::vector<bool> _first;
+
+			void comma() {
+				if (_first.empty()) return;
+				if (!_first.back()) _out += ",";
+				_first.back() = false;
+				_out += "\n" + std::string(2 * _first.size(), ' ');
+			}
+
+			void key(const char* k) {
+				comma();
+				if (k) {
+					_out += quote(k) + ": ";
+				}
+			}
+
+		public:
+			static std::string quote(const std::string& s) {
+				std::string q = "\"";
+				for (char c : s) {
+					if (c == '"' || c == '\\') q += '\\';
+					q += c;
+				}
+				return q + "\"";
+			}
+
+			JsonWriter& beginObject(const char* k = nullptr) {
+				key(k);
+				_out += "{";
+				_first.push_back(true);
+				return *this;
+			}
+
+			JsonWriter& endObject() {
+				_first.pop_back();
+				_out += "\n" + std::string(2 * _first.size(), ' ') + "}";
+				return *this;
+			}
+
+			JsonWriter& beginArray(const char* k = nullptr) {
+				key(k);
+				_out += "[";
+				_first.push_back(true);
+				return *this;
+			}
+
+			JsonWriter& endArray() {
+				_first.pop_back();
+				_out += "\n" + std::string(2 * _first.size(), ' ') + "]";
+				return *this;
+			}
+
+			JsonWriter& value(const char* k, const std::string& v) {
+				key(k);
+				_out += quote(v);
+				return *this;
+			}
+
+			JsonWriter& value(const char* k, const char* v) {
+				return value(k, std::string(v));
+			}
+
+			JsonWriter& value(const char* k, double v) {
+				key(k);
+				if (!std::isfinite(v)) { // not representable in JSON
+					_out += "null";
+					return *this;
+				}
+				char buf[32];
+				std::snprintf(buf, sizeof(buf), "%.6g", v);
+				_out += buf;
+				return *this;
+			}
+
+			JsonWriter& value(const char* k, size_t v) {
+				key(k);
+				_out += std::to_string(v);
+				return *this;
+			}
+
+			JsonWriter& value(const char* k, bool v) {
+				key(k);
+				_out += v ? "true" : "false";
+				return *this;
+			}
+
+			const std::string& str() const {
+				return _out;
+			}
+		};
+
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,1185 @@
+// Microbenchmarks and accuracy sweeps of the math layer. Needs no window or GL context.
+//
+//   math_bench [--json] [--out FILE] [--filter TEXT] [--min-time MS] [--samples N]
+//              [--no-perf] [--no-accuracy] [--check]
+//
+// --check makes the exit code 1 when an accuracy bound is exceeded, a batch kernel
+// gives different bits at different SIMD levels or a TransformHierarchy update allocates.
+
+#include "Bench.h"
+#include "../HeaderFiles/TaskSystem.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <new>
+#include <random>
+
+#include "../HeaderFiles/Mesh.h"
+#include "../HeaderFiles/Material.h"
+#include "../HeaderFiles/CommandBackend.h"
+#include "../HeaderFiles/avt_math.h"
+#include "../HeaderFiles/MathKernels.h"
+#include "../HeaderFiles/FastMath.h"
+#include "../HeaderFiles/Vector3Stream.h"
+#include "../HeaderFiles/QuaternionStream.h"
+#include "../HeaderFiles/BoundsStream.h"
+#include "../HeaderFiles/TransformHierarchy.h"
+#include "../HeaderFiles/DynamicBVH.h"
+#include "../HeaderFiles/Scene.h"
+#include "../HeaderFiles/RenderMesh.h"
+
+
+////////////////////////////////////////////////////////////////////////////////// ALLOCATION COUNTING
+
+namespace avt {
+	namespace bench {
+
+		std::atomic<size_t>& allocations() {
+			static std::atomic<size_t> count(0);
+			return count;
+		}
+
+#if defined(_MSC_VER)
+		const volatile void* escape = nullptr;
+#endif
+
+		// the one allocation and the one release behind every replaced operator below, so GCC
+		// sees each new paired with a free of memory from malloc
+		void* allocate(size_t size) {
+			allocations()++;
+			if (void* p = std::malloc(size ? size : 1)) return p;
+			throw std::bad_alloc();
+		}
+
+		void release(void* p) noexcept {
+			std::free(p);
+		}
+
+	}
+}
+
+void* operator new(size_t size) {
+	return avt::bench::allocate(size);
+}
+
+void* operator new[](size_t size) {
+	return avt::bench::allocate(size);
+}
+
+void operator delete(void* p) noexcept {
+	avt::bench::release(p);
+}
+
+void operator delete[](void* p) noexcept {
+	avt::bench::release(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+	avt::bench::release(p);
+}
+
+void operator delete[](void* p, size_t) noexcept {
+	avt::bench::release(p);
+}
+
+namespace {
+
+	using namespace avt;
+	using bench::keep;
+
+	const size_t INPUTS = 256; // power of two, inputs are picked with i & MASK
+	const size_t MASK = INPUTS - 1;
+	const size_t BATCH = 1024;
+	const size_t SPAWN_NODES = 1000;
+	const size_t CUBE_NODES = 200000; // main.cpp's 40 x 40 cubes, scaled up
+	const unsigned THREADS[] = { 1, 2, 4, 8 };
+	const size_t HIERARCHY_NODES = 100000;
+	const size_t BVH_LEAVES = 100000;
+	const size_t BVH_MOVED = 1000;
+	const size_t COMPONENT_NODES = 100000; // 1 in 4 with a renderable
+	const size_t RECORD_DRAWS = 100000;
+
+	struct Inputs {
+		std::vector<float> f;
+		std::vector<Vector2> v2;
+		std::vector<Vector3> v3;
+		std::vector<Vector4> v4;
+		std::vector<Mat2> m2;
+		std::vector<Mat3> m3;
+		std::vector<Mat4> m4;
+		std::vector<Quaternion> q;
+		std::vector<Affine> aff;
+		std::vector<AABB> box;
+		std::vector<Sphere> sphere;
+
+		Inputs() {
+			std::mt19937 gen(1234);
+			std::uniform_real_distribution<float> u(-1.0f, 1.0f);
+			std::uniform_real_distribution<float> pos(0.25f, 2.0f);
+
+			for (size_t i = 0; i < INPUTS; i++) {
+				f.push_back(pos(gen));
+				v2.push_back(Vector2(u(gen), u(gen)));
+				v3.push_back(Vector3(u(gen), u(gen), u(gen)));
+				v4.push_back(Vector4(u(gen), u(gen), u(gen), u(gen)));
+
+				// diagonally dominant, so every one is invertible
+				Mat2 a;
+				Mat3 b;
+				Mat4 c;
+				for (int k = 0; k < 4; k++) a[k] = u(gen);
+				for (int k = 0; k < 9; k++) b[k] = u(gen);
+				for (int k = 0; k < 16; k++) c[k] = u(gen);
+				for (int k = 0; k < 2; k++) a.at(k, k) += 3;
+				for (int k = 0; k < 3; k++) b.at(k, k) += 3;
+				for (int k = 0; k < 4; k++) c.at(k, k) += 3;
+				m2.push_back(a);
+				m3.push_back(b);
+				m4.push_back(c);
+
+				Quaternion rot(Vector3(u(gen), u(gen), u(gen)) + Vector3(0, 0, 2), u(gen) * 3);
+				q.push_back(rot);
+				aff.push_back(Affine::fromTRS(Vector3(u(gen), u(gen), u(gen)) * 10, rot, Vector3(pos(gen), pos(gen), pos(gen))));
+				box.push_back(AABB::fromCenterExtent(Vector3(u(gen), u(gen), u(gen)) * 50, Vector3(pos(gen), pos(gen), pos(gen))));
+				sphere.push_back(Sphere(Vector3(u(gen), u(gen), u(gen)) * 50, pos(gen)));
+			}
+		}
+	};
+
+	const Inputs& in() {
+		static Inputs inputs;
+		return inputs;
+	}
+
+	// which level provides an entry of the active kernel table
+	template<typename Fn>
+	std::string levelOf(Fn KernelTable::* entry) {
+		Fn fn = MathKernels::get().*entry;
+		if (kernels::avx2() && kernels::avx2()->*entry == fn) return "avx2";
+		if (kernels::sse2() && kernels::sse2()->*entry == fn) return "sse2";
+		if (kernels::neon() && kernels::neon()->*entry == fn) return "neon";
+		return "scalar";
+	}
+
+	Frustum benchFrustum() {
+		Mat4 proj = { 1.2f, 0, 0, 0, 0, 1.6f, 0, 0, 0, 0, -1.002f, -1, 0, 0, -0.2002f, 0 };
+		return Frustum(proj);
+	}
+
+
+	////////////////////////////////////////////////////////////////////////////// OPERATORS
+
+	void addVectors(bench::Runner& r) {
+		const Inputs& d = in();
+
+		r.add("Vector2", "operator+", [&](size_t i) { keep(d.v2[i & MASK] + d.v2[(i + 1) & MASK]); });
+		r.add("Vector2", "operator-", [&](size_t i) { keep(d.v2[i & MASK] - d.v2[(i + 1) & MASK]); });
+		r.add("Vector2", "operator*(float)", [&](size_t i) { keep(d.v2[i & MASK] * d.f[i & MASK]); });
+		r.add("Vector2", "operator/(float)", [&](size_t i) { keep(d.v2[i & MASK] / d.f[i & MASK]); });
+		r.add("Vector2", "operator+=", [&](size_t i) { Vector2 v = d.v2[i & MASK]; v += d.v2[(i + 1) & MASK]; keep(v); });
+		r.add("Vector2", "operator*=(Vector2)", [&](size_t i) { Vector2 v = d.v2[i & MASK]; v *= d.v2[(i + 1) & MASK]; keep(v); });
+		r.add("Vector2", "operator==", [&](size_t i) { keep(d.v2[i & MASK] == d.v2[(i + 1) & MASK]); });
+		r.add("Vector2", "dot", [&](size_t i) { keep(d.v2[i & MASK].dot(d.v2[(i + 1) & MASK])); });
+		r.add("Vector2", "length", [&](size_t i) { keep(d.v2[i & MASK].length()); });
+		r.add("Vector2", "normalized", [&](size_t i) { keep(d.v2[i & MASK].normalized()); });
+		r.add("Vector2", "angleTo", [&](size_t i) { keep(d.v2[i & MASK].angleTo(d.v2[(i + 1) & MASK])); });
+		r.add("Vector2", "distanceTo", [&](size_t i) { keep(d.v2[i & MASK].distanceTo(d.v2[(i + 1) & MASK])); });
+		r.add("Vector2", "to3D", [&](size_t i) { keep(d.v2[i & MASK].to3D()); });
+
+		r.add("Vector3", "operator+", [&](size_t i) { keep(d.v3[i & MASK] + d.v3[(i + 1) & MASK]); });
+		r.add("Vector3", "operator-", [&](size_t i) { keep(d.v3[i & MASK] - d.v3[(i + 1) & MASK]); });
+		r.add("Vector3", "operator-()", [&](size_t i) { keep(-d.v3[i & MASK]); });
+		r.add("Vector3", "operator*(float)", [&](size_t i) { keep(d.v3[i & MASK] * d.f[i & MASK]); });
+		r.add("Vector3", "operator/(float)", [&](size_t i) { keep(d.v3[i & MASK] / d.f[i & MASK]); });
+		r.add("Vector3", "operator*(Vector3)", [&](size_t i) { keep(d.v3[i & MASK] * d.v3[(i + 1) & MASK]); });
+		r.add("Vector3", "operator+=", [&](size_t i) { Vector3 v = d.v3[i & MASK]; v += d.v3[(i + 1) & MASK]; keep(v); });
+		r.add("Vector3", "operator-=", [&](size_t i) { Vector3 v = d.v3[i & MASK]; v -= d.v3[(i + 1) & MASK]; keep(v); });
+		r.add("Vector3", "operator*=(Vector3)", [&](size_t i) { Vector3 v = d.v3[i & MASK]; v *= d.v3[(i + 1) & MASK]; keep(v); });
+		r.add("Vector3", "operator/=", [&](size_t i) { Vector3 v = d.v3[i & MASK]; v /= d.f[i & MASK]; keep(v); });
+		r.add("Vector3", "operator==", [&](size_t i) { keep(d.v3[i & MASK] == d.v3[(i + 1) & MASK]); });
+		r.add("Vector3", "dot", [&](size_t i) { keep(d.v3[i & MASK].dot(d.v3[(i + 1) & MASK])); });
+		r.add("Vector3", "cross", [&](size_t i) { keep(d.v3[i & MASK].cross(d.v3[(i + 1) & MASK])); });
+		r.add("Vector3", "length", [&](size_t i) { keep(d.v3[i & MASK].length()); });
+		r.add("Vector3", "quadrance", [&](size_t i) { keep(d.v3[i & MASK].quadrance()); });
+		r.add("Vector3", "normalized<Exact>", [&](size_t i) { keep(d.v3[i & MASK].normalized<precision::Exact>()); });
+		r.add("Vector3", "normalized<Fast>", [&](size_t i) { keep(d.v3[i & MASK].normalized<precision::Fast>()); });
+		r.add("Vector3", "angleTo<Exact>", [&](size_t i) { keep(d.v3[i & MASK].angleTo<precision::Exact>(d.v3[(i + 1) & MASK])); });
+		r.add("Vector3", "angleTo<Fast>", [&](size_t i) { keep(d.v3[i & MASK].angleTo<precision::Fast>(d.v3[(i + 1) & MASK])); });
+		r.add("Vector3", "distanceTo", [&](size_t i) { keep(d.v3[i & MASK].distanceTo(d.v3[(i + 1) & MASK])); });
+		r.add("Vector3", "pow", [&](size_t i) { keep(d.v3[i & MASK].pow(d.f[i & MASK])); });
+		r.add("Vector3", "rotateOnAxis", [&](size_t i) { keep(d.v3[i & MASK].rotateOnAxis(Vector3(0, 1, 0), d.f[i & MASK])); });
+		r.add("Vector3", "rotateOnQuat", [&](size_t i) { keep(d.v3[i & MASK].rotateOnQuat(d.q[i & MASK])); });
+		r.add("Vector3", "to4D", [&](size_t i) { keep(d.v3[i & MASK].to4D()); });
+		r.add("Vector3", "quadProd", [&](size_t i) {
+			keep(Vector3::quadProd(d.v3[i & MASK], d.v3[(i + 1) & MASK], d.v3[(i + 2) & MASK], d.v3[(i + 3) & MASK]));
+		});
+
+		r.add("Vector4", "operator+", [&](size_t i) { keep(d.v4[i & MASK] + d.v4[(i + 1) & MASK]); });
+		r.add("Vector4", "operator-", [&](size_t i) { keep(d.v4[i & MASK] - d.v4[(i + 1) & MASK]); });
+		r.add("Vector4", "operator*(float)", [&](size_t i) { keep(d.v4[i & MASK] * d.f[i & MASK]); });
+		r.add("Vector4", "operator/(float)", [&](size_t i) { keep(d.v4[i & MASK] / d.f[i & MASK]); });
+		r.add("Vector4", "operator+=", [&](size_t i) { Vector4 v = d.v4[i & MASK]; v += d.v4[(i + 1) & MASK]; keep(v); });
+		r.add("Vector4", "operator*=(Vector4)", [&](size_t i) { Vector4 v = d.v4[i & MASK]; v *= d.v4[(i + 1) & MASK]; keep(v); });
+		r.add("Vector4", "operator==", [&](size_t i) { keep(d.v4[i & MASK] == d.v4[(i + 1) & MASK]); });
+		r.add("Vector4", "dot", [&](size_t i) { keep(d.v4[i & MASK].dot(d.v4[(i + 1) & MASK])); });
+		r.add("Vector4", "length", [&](size_t i) { keep(d.v4[i & MASK].length()); });
+		r.add("Vector4", "normalized", [&](size_t i) { keep(d.v4[i & MASK].normalized()); });
+		r.add("Vector4", "angleTo", [&](size_t i) { keep(d.v4[i & MASK].angleTo(d.v4[(i + 1) & MASK])); });
+		r.add("Vector4", "to3D", [&](size_t i) { keep(d.v4[i & MASK].to3D()); });
+	}
+
+	void addMatrices(bench::Runner& r) {
+		const Inputs& d = in();
+
+		r.add("Mat2", "operator+", [&](size_t i) { keep(d.m2[i & MASK] + d.m2[(i + 1) & MASK]); });
+		r.add("Mat2", "operator*(float)", [&](size_t i) { keep(d.m2[i & MASK] * d.f[i & MASK]); });
+		r.add("Mat2", "operator*(Mat2)", [&](size_t i) { keep(d.m2[i & MASK] * d.m2[(i + 1) & MASK]); });
+		r.add("Mat2", "operator*(Vector2)", [&](size_t i) { keep(d.m2[i & MASK] * d.v2[i & MASK]); });
+		r.add("Mat2", "operator*=", [&](size_t i) { Mat2 m = d.m2[i & MASK]; m *= d.m2[(i + 1) & MASK]; keep(m); });
+		r.add("Mat2", "operator==", [&](size_t i) { keep(d.m2[i & MASK] == d.m2[(i + 1) & MASK]); });
+		r.add("Mat2", "T", [&](size_t i) { keep(d.m2[i & MASK].T()); });
+		r.add("Mat2", "det", [&](size_t i) { keep(d.m2[i & MASK].det()); });
+		r.add("Mat2", "inverted", [&](size_t i) { keep(d.m2[i & MASK].inverted()); });
+		r.add("Mat2", "identity", [&](size_t i) { Mat2 m = Mat2::identity(); m[0] = d.f[i & MASK]; keep(m); });
+
+		r.add("Mat3", "operator+", [&](size_t i) { keep(d.m3[i & MASK] + d.m3[(i + 1) & MASK]); });
+		r.add("Mat3", "operator*(float)", [&](size_t i) { keep(d.m3[i & MASK] * d.f[i & MASK]); });
+		r.add("Mat3", "operator*(Mat3)", [&](size_t i) { keep(d.m3[i & MASK] * d.m3[(i + 1) & MASK]); });
+		r.add("Mat3", "operator*(Vector3)", [&](size_t i) { keep(d.m3[i & MASK] * d.v3[i & MASK]); });
+		r.add("Mat3", "operator*=", [&](size_t i) { Mat3 m = d.m3[i & MASK]; m *= d.m3[(i + 1) & MASK]; keep(m); });
+		r.add("Mat3", "operator==", [&](size_t i) { keep(d.m3[i & MASK] == d.m3[(i + 1) & MASK]); });
+		r.add("Mat3", "T", [&](size_t i) { keep(d.m3[i & MASK].T()); });
+		r.add("Mat3", "det", [&](size_t i) { keep(d.m3[i & MASK].det()); });
+		r.add("Mat3", "inverted", [&](size_t i) { keep(d.m3[i & MASK].inverted()); });
+		r.add("Mat3", "dual", [&](size_t i) { keep(Mat3::dual(d.v3[i & MASK])); });
+
+		r.add("Mat4", "operator+", [&](size_t i) { keep(d.m4[i & MASK] + d.m4[(i + 1) & MASK]); });
+		r.add("Mat4", "operator-", [&](size_t i) { keep(d.m4[i & MASK] - d.m4[(i + 1) & MASK]); });
+		r.add("Mat4", "operator*(float)", [&](size_t i) { keep(d.m4[i & MASK] * d.f[i & MASK]); });
+		r.add("Mat4", "operator==", [&](size_t i) { keep(d.m4[i & MASK] == d.m4[(i + 1) & MASK]); });
+		r.add("Mat4", "det", [&](size_t i) { keep(d.m4[i & MASK].det()); });
+		r.add("Mat4", "invertedAffine", [&](size_t i) { keep(d.aff[i & MASK].toMat4().invertedAffine()); });
+		r.add("Mat4", "normalMatrix", [&](size_t i) { keep(d.m4[i & MASK].normalMatrix()); });
+		r.add("Mat4", "identity", [&](size_t i) { Mat4 m = Mat4::identity(); m[0] = d.f[i & MASK]; keep(m); });
+		r.add("Mat4", "scale", [&](size_t i) { keep(Mat4::scale(d.v3[i & MASK])); });
+		r.add("Mat4", "translation", [&](size_t i) { keep(Mat4::translation(d.v3[i & MASK])); });
+		r.add("Mat4", "rotationX", [&](size_t i) { keep(Mat4::rotationX(d.f[i & MASK])); });
+		r.add("Mat4", "rotationY", [&](size_t i) { keep(Mat4::rotationY(d.f[i & MASK])); });
+		r.add("Mat4", "rotationZ", [&](size_t i) { keep(Mat4::rotationZ(d.f[i & MASK])); });
+
+		r.add("Affine", "operator*(Affine)", [&](size_t i) { keep(d.aff[i & MASK] * d.aff[(i + 1) & MASK]); });
+		r.add("Affine", "operator*(Vector3)", [&](size_t i) { keep(d.aff[i & MASK] * d.v3[i & MASK]); });
+		r.add("Affine", "transformVector", [&](size_t i) { keep(d.aff[i & MASK].transformVector(d.v3[i & MASK])); });
+		r.add("Affine", "inverted", [&](size_t i) { keep(d.aff[i & MASK].inverted()); });
+		r.add("Affine", "normalMatrix", [&](size_t i) { keep(d.aff[i & MASK].normalMatrix()); });
+		r.add("Affine", "toMat4", [&](size_t i) { keep(d.aff[i & MASK].toMat4()); });
+		r.add("Affine", "fromTRS", [&](size_t i) { keep(Affine::fromTRS(d.v3[i & MASK], d.q[i & MASK], d.v3[(i + 1) & MASK])); });
+		r.add("Affine", "fromMat4", [&](size_t i) { keep(Affine::fromMat4(d.m4[i & MASK])); });
+	}
+
+	void addQuaternions(bench::Runner& r) {
+		const Inputs& d = in();
+
+		r.add("Quaternion", "Quaternion(axis, angle)", [&](size_t i) { keep(Quaternion(d.v3[i & MASK], d.f[i & MASK])); });
+		r.add("Quaternion", "operator+", [&](size_t i) { keep(d.q[i & MASK] + d.q[(i + 1) & MASK]); });
+		r.add("Quaternion", "operator*(float)", [&](size_t i) { keep(d.q[i & MASK] * d.f[i & MASK]); });
+		r.add("Quaternion", "operator*(Quaternion)", [&](size_t i) { keep(d.q[i & MASK] * d.q[(i + 1) & MASK]); });
+		r.add("Quaternion", "operator*=", [&](size_t i) { Quaternion q = d.q[i & MASK]; q *= d.q[(i + 1) & MASK]; keep(q); });
+		r.add("Quaternion", "operator==", [&](size_t i) { keep(d.q[i & MASK] == d.q[(i + 1) & MASK]); });
+		r.add("Quaternion", "conj", [&](size_t i) { keep(d.q[i & MASK].conj()); });
+		r.add("Quaternion", "inv", [&](size_t i) { keep(d.q[i & MASK].inv()); });
+		r.add("Quaternion", "normalized", [&](size_t i) { keep(d.q[i & MASK].normalized()); });
+		r.add("Quaternion", "getAxis", [&](size_t i) { keep(d.q[i & MASK].getAxis()); });
+		r.add("Quaternion", "getAngle", [&](size_t i) { keep(d.q[i & MASK].getAngle()); });
+		r.add("Quaternion", "toMat", [&](size_t i) { keep(d.q[i & MASK].toMat()); });
+		r.add("Quaternion", "lerp", [&](size_t i) { keep((d.q[i & MASK].lerp)(d.q[(i + 1) & MASK], 0.3f)); });
+		r.add("Quaternion", "slerp", [&](size_t i) { keep(d.q[i & MASK].slerp(d.q[(i + 1) & MASK], 0.3f)); });
+	}
+
+	void addGeometry(bench::Runner& r) {
+		const Inputs& d = in();
+		static const Frustum frustum = benchFrustum();
+		static const Ray ray(Vector3(0, 0, 60), Vector3(0.01f, 0.02f, -1).normalized());
+
+		r.add("Frustum", "Frustum(Mat4)", [&](size_t i) { keep(Frustum(d.m4[i & MASK])); });
+		r.add("Frustum", "intersects(AABB)", [&](size_t i) { keep(frustum.intersects(d.box[i & MASK])); }, levelOf(&KernelTable::frustumAABB));
+		r.add("Frustum", "intersects(Sphere)", [&](size_t i) { keep(frustum.intersects(d.sphere[i & MASK])); }, levelOf(&KernelTable::frustumSphere));
+		r.add("AABB", "transformed", [&](size_t i) { keep(d.box[i & MASK].transformed(d.aff[i & MASK])); }, levelOf(&KernelTable::aabbTransform));
+		r.add("AABB", "expand", [&](size_t i) { AABB b = d.box[i & MASK]; b.expand(d.v3[i & MASK]); keep(b); });
+		r.add("Sphere", "transformed", [&](size_t i) { keep(d.sphere[i & MASK].transformed(d.aff[i & MASK])); });
+		r.add("Ray", "intersects(AABB)", [&](size_t i) { float t; keep(ray.intersects(d.box[i & MASK], t)); }, levelOf(&KernelTable::rayAABB));
+		r.add("Ray", "intersects(triangle)", [&](size_t i) {
+			float t;
+			keep(ray.intersects(d.v3[i & MASK], d.v3[(i + 1) & MASK], d.v3[(i + 2) & MASK], t));
+		}, levelOf(&KernelTable::rayTriangle));
+	}
+
+
+	////////////////////////////////////////////////////////////////////////////// BATCH KERNELS
+
+	// the stream classes run at whatever level is active when the runner executes
+	struct Streams {
+		Vector3Stream a, b, out;
+		QuaternionStream qa, qb, qout;
+		AABBStream boxes, worldBoxes;
+		SphereStream spheres;
+		std::vector<Affine> affs;
+		std::vector<float> floats;
+		std::vector<uint8_t> visible;
+		TransformHierarchy hierarchy;
+		TransformHierarchy::Id hierarchyRoot, hierarchyLeaf;
+		Scene scene;
+		SceneNode heapRoot; // children allocated with new
+		std::vector<SceneNode*> spawned;
+		TransformHierarchy cubes;
+		TransformHierarchy::Id cubesRoot;
+		std::vector<std::unique_ptr<TaskSystem>> tasks;
+		DynamicBVH bvh;
+		std::vector<DynamicBVH::Proxy> bvhProxies;
+		AABBStream bvhBoxes; // the same boxes, for the linear cull
+		std::vector<uint8_t> bvhVisible;
+		Scene componentScene;
+		std::vector<SceneNode*> walk; // stack of the node walk
+		Mesh drawMeshes[32]; // never set up, only pointed to
+		std::vector<Vertex> vertices; // of a mesh
+		std::vector<std::unique_ptr<Material>> drawMaterials;
+		std::vector<CommandBuffer> commands; // one per recording thread
+		size_t recorded = 0; // buffers filled by the last recordDraws
+		HeadlessBackend headless;
+
+		Streams() {
+			const Inputs& d = in();
+			for (size_t i = 0; i < BATCH; i++) {
+				a.push_back(d.v3[i & MASK]);
+				b.push_back(d.v3[(i * 7 + 3) & MASK]);
+				qa.push_back(d.q[i & MASK]);
+				qb.push_back(d.q[(i * 7 + 3) & MASK]);
+				boxes.push_back(d.box[i & MASK]);
+				spheres.push_back(d.sphere[i & MASK]);
+				affs.push_back(d.aff[(i * 5 + 1) & MASK]);
+			}
+			vertices.resize(BATCH);
+			for (size_t i = 0; i < BATCH; i++) {
+				vertices[i].position = d.v3[i & MASK];
+			}
+			out.resize(BATCH);
+			qout.resize(BATCH);
+			floats.resize(BATCH);
+			visible.resize(BATCH);
+
+			// 8 children per node, every node with a non-trivial TRS
+			hierarchy.reserve(HIERARCHY_NODES);
+			std::vector<TransformHierarchy::Id> ids;
+			ids.push_back(hierarchy.create());
+			for (size_t i = 1; i < HIERARCHY_NODES; i++) {
+				TransformHierarchy::Id id = hierarchy.create(ids[(i - 1) / 8]);
+				hierarchy.setTranslation(id, d.v3[i & MASK]);
+				hierarchy.setRotation(id, d.q[i & MASK]);
+				ids.push_back(id);
+			}
+			hierarchyRoot = ids[0];
+			hierarchyLeaf = ids.back();
+			hierarchy.update();
+
+			spawned.reserve(SPAWN_NODES);
+
+			// every cube straight under the root, like the stress scene
+			cubes.reserve(CUBE_NODES + 1);
+			cubesRoot = cubes.create();
+			for (size_t i = 0; i < CUBE_NODES; i++) {
+				TransformHierarchy::Id id = cubes.create(cubesRoot);
+				cubes.setTranslation(id, d.v3[i & MASK]);
+				cubes.setRotation(id, d.q[i & MASK]);
+			}
+			cubes.update();
+
+			// unit boxes scattered over a 1000 units wide cube, the bench frustum sees about 1 in 200
+			for (size_t i = 0; i < BVH_LEAVES; i++) {
+				Vector3 c(float(i * 7919 % 1000) - 500.0f, float(i * 104729 % 1000) - 500.0f, float(i * 1299709 % 1000) - 500.0f);
+				AABB box(c - Vector3(1, 1, 1), c + Vector3(1, 1, 1));
+				bvhProxies.push_back(bvh.insert(box, static_cast<uint32_t>(i)));
+				bvhBoxes.push_back(box);
+			}
+			bvh.build();
+			bvhVisible.resize(BVH_LEAVES);
+
+			// 8 children per node again, a few renderables shared by many nodes
+			std::shared_ptr<Renderable> rends[8];
+			for (auto& rend : rends) rend = std::make_shared<RenderMesh>(nullptr, nullptr);
+			std::vector<SceneNode*> nodes;
+			nodes.push_back(componentScene.createNode());
+			for (size_t i = 1; i < COMPONENT_NODES; i++) {
+				SceneNode* node = nodes[(i - 1) / 8]->createNode(i % 4 == 0 ? rends[i / 4 % 8] : nullptr);
+				node->setTranslation(d.v3[i & MASK]);
+				nodes.push_back(node);
+			}
+			componentScene.updateTransforms();
+			walk.reserve(COMPONENT_NODES);
+
+			for (int i = 0; i < 8; i++) {
+				drawMaterials.emplace_back(new Material(nullptr));
+			}
+			recordDraws(nullptr);
+		}
+
+		// RECORD_DRAWS draws split into one command buffer per thread, materials changing every
+		// 1024 draws and meshes every 8, the order a sorted queue would give
+		void recordDraws(TaskSystem* tasks) {
+			size_t shares = tasks ? tasks->threads() : 1;
+			if (commands.size() < shares) commands.resize(shares);
+
+			auto record = [this, shares](size_t begin, size_t end) {
+				for (size_t b = begin; b < end; b++) {
+					CommandBuffer& buffer = commands[b];
+					buffer.clear();
+					size_t first = b * RECORD_DRAWS / shares, last = (b + 1) * RECORD_DRAWS / shares;
+					for (size_t i = first; i < last; i++) {
+						if (i == first || i % 1024 == 0) buffer.bindPipeline(drawMaterials[i / 1024 % 8].get());
+						if (i == first || i % 8 == 0) buffer.bindMesh(&drawMeshes[i / 8 % 32]);
+						buffer.setTransform(affs[i % BATCH]);
+						buffer.draw(DrawMode::Triangles);
+					}
+				}
+			};
+			if (tasks) tasks->parallelFor(shares, 1, record);
+			else record(0, shares);
+			recorded = shares;
+		}
+
+		// SPAWN_NODES children under parent, then deletes them in creation order
+		void spawnDespawn(SceneNode* parent) {
+			for (size_t i = 0; i < SPAWN_NODES; i++) {
+				spawned.push_back(parent->createNode());
+			}
+			for (SceneNode* node : spawned) {
+				parent->deleteNode(node);
+			}
+			spawned.clear();
+			parent->getHierarchy()->update();
+		}
+	};
+
+	void addBatches(bench::Runner& r, Streams& s) {
+		static const Frustum frustum = benchFrustum();
+		static const Ray ray(Vector3(0, 0, 60), Vector3(0.01f, 0.02f, -1).normalized());
+		const Mat4 rot = Quaternion(Vector3(1, 2, 3), 0.5f).toMat();
+		const Inputs& d = in();
+
+		// the Mat4 operators that go through the kernel table, one matrix at a time
+		r.add("Mat4", "operator*(Mat4)", [&d](size_t i) { keep(d.m4[i & MASK] * d.m4[(i + 1) & MASK]); }, levelOf(&KernelTable::mat4Mul));
+		r.add("Mat4", "operator*(Vector4)", [&d](size_t i) { keep(d.m4[i & MASK] * d.v4[i & MASK]); }, levelOf(&KernelTable::mat4MulVec4));
+		r.add("Mat4", "operator*=", [&d](size_t i) { Mat4 m = d.m4[i & MASK]; m *= d.m4[(i + 1) & MASK]; keep(m); }, levelOf(&KernelTable::mat4Mul));
+		r.add("Mat4", "T", [&d](size_t i) { keep(d.m4[i & MASK].T()); }, levelOf(&KernelTable::mat4Transpose));
+		r.add("Mat4", "inverted", [&d](size_t i) { keep(d.m4[i & MASK].inverted()); }, levelOf(&KernelTable::mat4Inverse));
+		// what Mesh::applyTransform runs over its vertices, Mesh.cpp itself needs GL
+		r.add("Mesh", "applyTransform", [&s, rot](size_t) {
+			MathKernels::get().mat4TransformPoints(rot.data(), &s.vertices[0].position.x, s.vertices.size(), sizeof(Vertex));
+			keep(s.vertices[0].position);
+		}, levelOf(&KernelTable::mat4TransformPoints), BATCH);
+
+
+		r.add("Vector3Stream", "dot", [&s](size_t) { s.a.dot(s.b, s.floats.data()); keep(s.floats[0]); }, levelOf(&KernelTable::vec3Dot), BATCH);
+		r.add("Vector3Stream", "cross", [&s](size_t) { s.a.cross(s.b, s.out); keep(s.out.x()[0]); }, levelOf(&KernelTable::vec3Cross), BATCH);
+		r.add("Vector3Stream", "length", [&s](size_t) { s.a.length(s.floats.data()); keep(s.floats[0]); }, levelOf(&KernelTable::vec3Length), BATCH);
+		r.add("Vector3Stream", "normalize", [&s](size_t) { s.a.normalize(); keep(s.a.x()[0]); }, levelOf(&KernelTable::vec3Normalize), BATCH);
+		r.add("Vector3Stream", "transform", [&s, rot](size_t) { s.a.transform(rot); keep(s.a.x()[0]); }, levelOf(&KernelTable::vec3Transform), BATCH);
+		r.add("Vector3Stream", "bounds", [&s](size_t) { Vector3 lo, hi; s.a.bounds(lo, hi); keep(lo); keep(hi); }, levelOf(&KernelTable::vec3MinMax), BATCH);
+		r.add("QuaternionStream", "multiply", [&s](size_t) { QuaternionStream::multiply(s.qa, s.qb, s.qout); keep(s.qout[0]); }, levelOf(&KernelTable::quatMul), BATCH);
+		r.add("QuaternionStream", "nlerp", [&s](size_t) { QuaternionStream::nlerp(s.qa, s.qb, 0.3f, s.qout); keep(s.qout[0]); }, levelOf(&KernelTable::quatNlerp), BATCH);
+		r.add("QuaternionStream", "slerp", [&s](size_t) { QuaternionStream::slerp(s.qa, s.qb, 0.3f, s.qout); keep(s.qout[0]); }, levelOf(&KernelTable::quatSlerp), BATCH);
+		r.add("QuaternionStream", "toAffine", [&s](size_t) { s.qa.toAffine(s.affs.data()); keep(s.affs[0]); }, levelOf(&KernelTable::quatToAffine), BATCH);
+		r.add("AABBStream", "cull", [&s](size_t) { keep(s.boxes.cull(frustum, s.visible.data())); }, levelOf(&KernelTable::frustumAABB), BATCH);
+		r.add("AABBStream", "raycast", [&s](size_t) { s.boxes.raycast(ray, s.floats.data()); keep(s.floats[0]); }, levelOf(&KernelTable::rayAABB), BATCH);
+		r.add("AABBStream", "transform", [&s](size_t) { s.boxes.transform(s.affs.data(), s.worldBoxes); keep(s.worldBoxes[0]); }, levelOf(&KernelTable::aabbTransform), BATCH);
+		r.add("SphereStream", "cull", [&s](size_t) { keep(s.spheres.cull(frustum, s.visible.data())); }, levelOf(&KernelTable::frustumSphere), BATCH);
+		r.add("Ray", "intersects(Vector3Stream)", [&s](size_t) { keep(ray.intersects(s.a, s.b, s.out, s.floats.data())); }, levelOf(&KernelTable::rayTriangle), BATCH);
+		r.add("TransformHierarchy", "update (root moved)", [&s](size_t) {
+			s.hierarchy.setTranslation(s.hierarchyRoot, s.hierarchy.getTranslation(s.hierarchyRoot));
+			s.hierarchy.update();
+			keep(s.hierarchy.getWorld(s.hierarchyRoot));
+		}, levelOf(&KernelTable::affineMulIndexed), HIERARCHY_NODES);
+		r.add("TransformHierarchy", "update (one leaf moved)", [&s](size_t) {
+			s.hierarchy.setTranslation(s.hierarchyLeaf, s.hierarchy.getTranslation(s.hierarchyLeaf));
+			s.hierarchy.update();
+			keep(s.hierarchy.getWorld(s.hierarchyLeaf));
+		}, levelOf(&KernelTable::affineMulIndexed), HIERARCHY_NODES);
+		r.add("TransformHierarchy", "update (nothing moved)", [&s](size_t) {
+			s.hierarchy.update();
+			keep(s.hierarchy.getWorld(s.hierarchyRoot));
+		}, "none", HIERARCHY_NODES);
+	}
+
+
+	////////////////////////////////////////////////////////////////////////////// SCENE
+
+	void addScene(bench::Runner& r, Streams& s) {
+		static const Frustum frustum = benchFrustum();
+		static const Ray ray(Vector3(0, 0, 60), Vector3(0.01f, 0.02f, -1).normalized());
+
+		r.add("Scene", "spawn + despawn (pool)", [&s](size_t) {
+			s.spawnDespawn(s.scene.getRoot());
+			keep(s.scene.nodeCount());
+		}, "none", SPAWN_NODES);
+		r.add("Scene", "spawn + despawn (new / delete)", [&s](size_t) {
+			s.spawnDespawn(&s.heapRoot);
+			keep(s.heapRoot.children().size());
+		}, "none", SPAWN_NODES);
+		r.add("Scene", "spawn + clear", [&s](size_t) {
+			for (size_t i = 0; i < SPAWN_NODES; i++) {
+				s.scene.createNode();
+			}
+			s.scene.clear();
+			keep(s.scene.nodeCount());
+		}, "none", SPAWN_NODES);
+
+		// what a render system reads per renderable: its id and world matrix
+		r.add("Scene", "visit renderables (component set, 100k nodes)", [&s](size_t) {
+			const TransformHierarchy& transforms = s.componentScene.transforms();
+			float sum = 0;
+			s.componentScene.components().renderableIds().each([&](uint32_t entity, const RenderableId& id) {
+				sum += transforms.getWorld(entity)[9] + float(id.index);
+			});
+			keep(sum);
+		}, "none", COMPONENT_NODES / 4);
+		r.add("Scene", "visit renderables (node walk, 100k nodes)", [&s](size_t) {
+			const EntityRegistry& components = s.componentScene.components();
+			float sum = 0;
+			s.walk.push_back(s.componentScene.getRoot());
+			while (!s.walk.empty()) {
+				SceneNode* node = s.walk.back();
+				s.walk.pop_back();
+				if (node->getRenderable()) sum += node->getWorldTransform()[9] + float(components.renderableIds().get(node->getTransformId()).index);
+				for (SceneNode* child : *node) s.walk.push_back(child);
+			}
+			keep(sum);
+		}, "none", COMPONENT_NODES / 4);
+
+		// the same update spread over more threads, one more worker each time
+		for (unsigned threads : THREADS) {
+			s.tasks.emplace_back(new TaskSystem(threads - 1));
+			TaskSystem* tasks = s.tasks.back().get();
+
+			r.add("TransformHierarchy", "update 200k cubes (root moved, " + std::to_string(threads) + " threads)", [&s, tasks](size_t) {
+				s.cubes.setTranslation(s.cubesRoot, s.cubes.getTranslation(s.cubesRoot));
+				s.cubes.update(tasks);
+				keep(s.cubes.getWorld(s.cubesRoot));
+			}, levelOf(&KernelTable::affineMulIndexed), CUBE_NODES);
+		}
+
+		// draw commands recorded on more threads, each into its own buffer, and their replay without a GL context
+		for (auto& tasks : s.tasks) {
+			TaskSystem* t = tasks.get();
+			r.add("CommandBuffer", "record 100k draws (" + std::to_string(t->threads()) + " threads)", [&s, t](size_t) {
+				s.recordDraws(t);
+				keep(s.commands[0].size());
+			}, "none", RECORD_DRAWS);
+		}
+		r.add("HeadlessBackend", "replay 100k draws", [&s](size_t) {
+			s.headless.reset();
+			for (size_t b = 0; b < s.recorded; b++) {
+				s.headless.execute(s.commands[b]);
+			}
+			keep(s.headless.checksum());
+		}, "none", RECORD_DRAWS);
+
+		r.add("DynamicBVH", "frustum query (100k leaves)", [&s](size_t) {
+			size_t visible = 0;
+			s.bvh.query(frustum, [&visible](uint32_t) { visible++; });
+			keep(visible);
+		}, "none", BVH_LEAVES);
+		r.add("AABBStream", "cull (100k boxes, linear)", [&s](size_t) {
+			keep(s.bvhBoxes.cull(frustum, s.bvhVisible.data()));
+		}, levelOf(&KernelTable::frustumAABB), BVH_LEAVES);
+		r.add("DynamicBVH", "raycast closest (100k leaves)", [&s](size_t) {
+			uint32_t closest = DynamicBVH::NONE;
+			s.bvh.raycast(ray, [&closest](uint32_t value, float t) {
+				closest = value;
+				return t;
+			});
+			keep(closest);
+		}, "none", BVH_LEAVES);
+		// back and forth by half a unit, the tree keeps its shape
+		r.add("DynamicBVH", "update + refit (1000 of 100k leaves moved)", [&s](size_t i) {
+			float step = (i & 1) ? 0.5f : -0.5f;
+			for (size_t k = 0; k < BVH_MOVED; k++) {
+				DynamicBVH::Proxy proxy = s.bvhProxies[k * 97 % BVH_LEAVES];
+				AABB box = s.bvh.bounds(proxy);
+				box.lower.x += step;
+				box.upper.x += step;
+				s.bvh.update(proxy, box);
+			}
+			s.bvh.refit();
+			keep(s.bvh.stats().refitted);
+		}, "none", BVH_MOVED);
+	}
+
+
+	////////////////////////////////////////////////////////////////////////////// ACCURACY
+
+	struct Accuracy {
+		std::string name;
+		std::string metric;
+		double error;
+		double bound;
+
+		bool pass() const {
+			return error <= bound;
+		}
+	};
+
+	struct Identity {
+		std::string kernel;
+		std::string level;
+		bool identical;
+	};
+
+	float fromBits(uint32_t bits) {
+		float f;
+		std::memcpy(&f, &bits, sizeof(f));
+		return f;
+	}
+
+	// every 97th positive normal float
+	template<typename F>
+	double sweepRelative(F approx, double (*exact)(double)) {
+		double worst = 0;
+		for (uint32_t bits = 0x00800000u; bits < 0x7f800000u; bits += 97) {
+			float x = fromBits(bits);
+			double ref = exact(x);
+			double err = std::fabs(approx(x) - ref) / ref;
+			worst = err > worst ? err : worst;
+		}
+		return worst;
+	}
+
+	template<typename F>
+	double sweepAbsolute(F approx, double (*exact)(double), float from, float to, int steps) {
+		double worst = 0;
+		for (int i = 0; i <= steps; i++) {
+			float x = from + (to - from) * (static_cast<float>(i) / steps);
+			double err = std::fabs(approx(x) - exact(x));
+			worst = err > worst ? err : worst;
+		}
+		return worst;
+	}
+
+	double refRsqrt(double x) {
+		return 1.0 / std::sqrt(x);
+	}
+
+	double refSqrt(double x) {
+		return std::sqrt(x);
+	}
+
+	double refSin(double x) {
+		return std::sin(x);
+	}
+
+	double refCos(double x) {
+		return std::cos(x);
+	}
+
+	double refAcos(double x) {
+		return std::acos(x);
+	}
+
+	std::vector<Accuracy> runAccuracy() {
+		using F = precision::Fast;
+		std::vector<Accuracy> res;
+
+		// bounds are the ones documented in FastMath.h and MathKernels.h
+#ifdef AVT_FAST_RSQRT_SSE
+		const double rsqrtBound = 3e-7;
+#else
+		const double rsqrtBound = 5e-6;
+#endif
+		res.push_back({ "Fast::rsqrt", "relative", sweepRelative([](float x) { return F::rsqrt(x); }, refRsqrt), rsqrtBound });
+		res.push_back({ "Fast::sqrt", "relative", sweepRelative([](float x) { return F::sqrt(x); }, refSqrt), rsqrtBound * 1.1 });
+
+		const struct { float range; double bound; } trig[] = { { 3.14159265f, 2.5e-7 }, { 100, 4e-6 }, { 1e3f, 8e-5 }, { 1e5f, 7e-3 } };
+		for (const auto& t : trig) {
+			char range[32];
+			std::snprintf(range, sizeof(range), "|x| <= %g", t.range);
+			res.push_back({ std::string("Fast::sin ") + range, "absolute", sweepAbsolute([](float x) { return F::sin(x); }, refSin, -t.range, t.range, 2000000), t.bound });
+			res.push_back({ std::string("Fast::cos ") + range, "absolute", sweepAbsolute([](float x) { return F::cos(x); }, refCos, -t.range, t.range, 2000000), t.bound });
+		}
+		res.push_back({ "Fast::acos", "absolute", sweepAbsolute([](float x) { return F::acos(x); }, refAcos, -1, 1, 4000000), 5e-7 });
+
+		const Inputs& d = in();
+
+		// batch slerp against Quaternion::slerp on the same hemisphere
+		{
+			QuaternionStream qa, qb, out;
+			std::vector<float> k;
+			for (size_t i = 0; i < INPUTS; i++) {
+				Quaternion a = d.q[i], b = d.q[(i * 7 + 3) & MASK];
+				if (a.t * b.t + a.x * b.x + a.y * b.y + a.z * b.z < 0) b = b * -1.0f;
+				for (int j = 0; j <= 16; j++) {
+					qa.push_back(a);
+					qb.push_back(b);
+					k.push_back(j / 16.0f);
+				}
+			}
+			QuaternionStream::slerp(qa, qb, k.data(), out);
+
+			double worst = 0;
+			for (size_t i = 0; i < out.size(); i++) {
+				Quaternion ref = qa[i].slerp(qb[i], k[i]);
+				Quaternion got = out[i];
+				const double err[4] = { std::fabs(got.t - ref.t), std::fabs(got.x - ref.x), std::fabs(got.y - ref.y), std::fabs(got.z - ref.z) };
+				for (double e : err) worst = e > worst ? e : worst;
+			}
+			res.push_back({ "QuaternionStream::slerp vs Quaternion::slerp", "absolute", worst, 1e-6 });
+		}
+
+		// M * inverse(M) against the identity
+		{
+			double worst = 0;
+			for (const Mat4& m : d.m4) {
+				Mat4 p = m * m.inverted();
+				for (int c = 0; c < 16; c++) {
+					double e = std::fabs(p[c] - (c % 5 == 0 ? 1.0 : 0.0));
+					worst = e > worst ? e : worst;
+				}
+			}
+			res.push_back({ "Mat4::inverted (M * inverse(M) - I)", "absolute", worst, 1e-4 });
+		}
+
+		return res;
+	}
+
+	// output bytes of every batch kernel on odd-sized inputs (so the tails run too)
+	struct KernelRun {
+		const char* name;
+		std::vector<uint8_t> (*run)();
+	};
+
+	const size_t ODD = 1003;
+
+	struct KernelInputs {
+		std::vector<float> v[12];
+		std::vector<float> m;
+
+		KernelInputs() {
+			std::mt19937 gen(99);
+			std::uniform_real_distribution<float> u(-2.0f, 2.0f);
+			for (auto& arr : v) {
+				for (size_t i = 0; i < ODD; i++) arr.push_back(u(gen));
+			}
+			for (size_t i = 0; i < ODD; i++) v[11][i] = std::fabs(v[11][i]); // extents and radii
+			for (size_t i = 0; i < 12 * ODD; i++) m.push_back(u(gen));
+		}
+
+		Vec3SoA soa(int first) const {
+			return { const_cast<float*>(v[first].data()), const_cast<float*>(v[first + 1].data()), const_cast<float*>(v[first + 2].data()) };
+		}
+
+		QuatSoA quat(int first) const {
+			return { const_cast<float*>(v[first].data()), const_cast<float*>(v[first + 1].data()),
+				const_cast<float*>(v[first + 2].data()), const_cast<float*>(v[first + 3].data()) };
+		}
+	};
+
+	const KernelInputs& kin() {
+		static KernelInputs inputs;
+		return inputs;
+	}
+
+	template<typename T>
+	void append(std::vector<uint8_t>& bytes, const T* data, size_t count) {
+		size_t at = bytes.size();
+		bytes.resize(at + count * sizeof(T));
+		std::memcpy(bytes.data() + at, data, count * sizeof(T));
+	}
+
+	struct SoAOut {
+		std::vector<float> x, y, z, w;
+
+		SoAOut() : x(ODD), y(ODD), z(ODD), w(ODD) {}
+
+		Vec3SoA v3() {
+			return { x.data(), y.data(), z.data() };
+		}
+
+		QuatSoA q() {
+			return { w.data(), x.data(), y.data(), z.data() };
+		}
+
+		std::vector<uint8_t> bytes(bool withW) const {
+			std::vector<uint8_t> b;
+			append(b, x.data(), ODD);
+			append(b, y.data(), ODD);
+			append(b, z.data(), ODD);
+			if (withW) append(b, w.data(), ODD);
+			return b;
+		}
+	};
+
+	const KernelRun KERNEL_RUNS[] = {
+		{ "mat4Mul", [] {
+			const KernelInputs& k = kin();
+			std::vector<float> out(16 * 62);
+			for (size_t i = 0; i < 62; i++) MathKernels::get().mat4Mul(k.m.data() + 16 * i, k.m.data() + 16 * (i + 1), out.data() + 16 * i);
+			std::vector<uint8_t> b; append(b, out.data(), out.size()); return b;
+		} },
+		{ "mat4MulVec4", [] {
+			const KernelInputs& k = kin();
+			std::vector<float> out(4 * 62);
+			for (size_t i = 0; i < 62; i++) MathKernels::get().mat4MulVec4(k.m.data() + 16 * i, k.v[0].data() + 4 * i, out.data() + 4 * i);
+			std::vector<uint8_t> b; append(b, out.data(), out.size()); return b;
+		} },
+		{ "mat4Transpose", [] {
+			const KernelInputs& k = kin();
+			std::vector<float> out(16 * 62);
+			for (size_t i = 0; i < 62; i++) MathKernels::get().mat4Transpose(k.m.data() + 16 * i, out.data() + 16 * i);
+			std::vector<uint8_t> b; append(b, out.data(), out.size()); return b;
+		} },
+		{ "mat4TransformPoints", [] {
+			const KernelInputs& k = kin();
+			std::vector<float> pts(k.v[0].begin(), k.v[0].begin() + 3 * 333);
+			MathKernels::get().mat4TransformPoints(k.m.data(), pts.data(), 333, 3 * sizeof(float));
+			std::vector<uint8_t> b; append(b, pts.data(), pts.size()); return b;
+		} },
+		{ "vec3Dot", [] {
+			std::vector<float> out(ODD);
+			MathKernels::get().vec3Dot(kin().soa(0), kin().soa(3), out.data(), ODD);
+			std::vector<uint8_t> b; append(b, out.data(), ODD); return b;
+		} },
+		{ "vec3Cross", [] {
+			SoAOut out;
+			MathKernels::get().vec3Cross(kin().soa(0), kin().soa(3), out.v3(), ODD);
+			return out.bytes(false);
+		} },
+		{ "vec3Length", [] {
+			std::vector<float> out(ODD);
+			MathKernels::get().vec3Length(kin().soa(0), out.data(), ODD);
+			std::vector<uint8_t> b; append(b, out.data(), ODD); return b;
+		} },
+		{ "vec3Normalize", [] {
+			SoAOut out;
+			out.x = kin().v[0]; out.y = kin().v[1]; out.z = kin().v[2];
+			MathKernels::get().vec3Normalize(out.v3(), ODD);
+			return out.bytes(false);
+		} },
+		{ "vec3Transform", [] {
+			SoAOut out;
+			out.x = kin().v[0]; out.y = kin().v[1]; out.z = kin().v[2];
+			MathKernels::get().vec3Transform(kin().m.data(), out.v3(), ODD, 1.0f);
+			return out.bytes(false);
+		} },
+		{ "vec3MinMax", [] {
+			float mn[3], mx[3];
+			MathKernels::get().vec3MinMax(kin().soa(0), ODD, mn, mx);
+			std::vector<uint8_t> b; append(b, mn, 3); append(b, mx, 3); return b;
+		} },
+		{ "quatMul", [] {
+			SoAOut out;
+			MathKernels::get().quatMul(kin().quat(0), kin().quat(4), out.q(), ODD);
+			return out.bytes(true);
+		} },
+		{ "quatNlerp", [] {
+			SoAOut out;
+			MathKernels::get().quatNlerp(kin().quat(0), kin().quat(4), kin().v[11].data(), 1, out.q(), ODD);
+			return out.bytes(true);
+		} },
+		{ "quatSlerp", [] {
+			// k in [0, 1]
+			std::vector<float> k(ODD);
+			for (size_t i = 0; i < ODD; i++) k[i] = (i % 17) / 16.0f;
+			SoAOut out;
+			MathKernels::get().quatSlerp(kin().quat(0), kin().quat(4), k.data(), 1, out.q(), ODD);
+			return out.bytes(true);
+		} },
+		{ "quatToAffine", [] {
+			std::vector<float> out(12 * ODD);
+			MathKernels::get().quatToAffine(kin().quat(0), out.data(), ODD);
+			std::vector<uint8_t> b; append(b, out.data(), out.size()); return b;
+		} },
+		{ "affineFromTRS", [] {
+			const float* m = kin().m.data();
+			std::vector<float> out(12 * ODD);
+			MathKernels::get().affineFromTRS(m, m + 3 * ODD, m + 7 * ODD, out.data(), ODD);
+			std::vector<uint8_t> b; append(b, out.data(), out.size()); return b;
+		} },
+		{ "affineMulIndexed", [] {
+			std::vector<uint32_t> index(ODD);
+			for (size_t i = 0; i < ODD; i++) index[i] = static_cast<uint32_t>((i * 7) % ODD);
+			std::vector<float> out(kin().m.rbegin(), kin().m.rend());
+			MathKernels::get().affineMulIndexed(kin().m.data(), index.data(), out.data(), out.data(), ODD);
+			std::vector<uint8_t> b; append(b, out.data(), out.size()); return b;
+		} },
+		{ "frustumAABB", [] {
+			std::vector<uint8_t> out(ODD);
+			Frustum f = benchFrustum();
+			SoAOut ext;
+			ext.x = kin().v[11]; ext.y = kin().v[11]; ext.z = kin().v[11];
+			size_t n = MathKernels::get().frustumAABB(f.data(), kin().soa(0), ext.v3(), out.data(), ODD);
+			out.push_back(static_cast<uint8_t>(n));
+			return out;
+		} },
+		{ "frustumSphere", [] {
+			std::vector<uint8_t> out(ODD);
+			Frustum f = benchFrustum();
+			size_t n = MathKernels::get().frustumSphere(f.data(), kin().soa(0), kin().v[11].data(), out.data(), ODD);
+			out.push_back(static_cast<uint8_t>(n));
+			return out;
+		} },
+		{ "rayAABB", [] {
+			float ray[7];
+			Ray(Vector3(0.1f, 0.2f, 3), Vector3(0.1f, -0.2f, -1).normalized()).pack(ray, true);
+			SoAOut ext;
+			ext.x = kin().v[11]; ext.y = kin().v[11]; ext.z = kin().v[11];
+			std::vector<float> out(ODD);
+			MathKernels::get().rayAABB(ray, kin().soa(0), ext.v3(), out.data(), ODD);
+			std::vector<uint8_t> b; append(b, out.data(), ODD); return b;
+		} },
+		{ "rayTriangle", [] {
+			float ray[7];
+			Ray(Vector3(0.1f, 0.2f, 3), Vector3(0.1f, -0.2f, -1).normalized()).pack(ray, false);
+			std::vector<float> out(ODD);
+			MathKernels::get().rayTriangle(ray, kin().soa(0), kin().soa(3), kin().soa(6), out.data(), ODD);
+			std::vector<uint8_t> b; append(b, out.data(), ODD); return b;
+		} },
+		{ "aabbTransform", [] {
+			SoAOut c, e, ext;
+			ext.x = kin().v[11]; ext.y = kin().v[11]; ext.z = kin().v[11];
+			MathKernels::get().aabbTransform(kin().m.data(), 12, kin().soa(0), ext.v3(), c.v3(), e.v3(), ODD);
+			std::vector<uint8_t> b = c.bytes(false);
+			std::vector<uint8_t> be = e.bytes(false);
+			b.insert(b.end(), be.begin(), be.end());
+			return b;
+		} },
+	};
+
+	const SimdLevel LEVELS[] = { SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::NEON };
+
+	std::vector<Identity> runIdentity() {
+		std::vector<Identity> res;
+		SimdLevel best = MathKernels::level();
+
+		for (const KernelRun& k : KERNEL_RUNS) {
+			MathKernels::setLevel(SimdLevel::Scalar);
+			std::vector<uint8_t> ref = k.run();
+
+			for (SimdLevel level : LEVELS) {
+				if (level == SimdLevel::Scalar || !MathKernels::supported(level)) continue;
+				MathKernels::setLevel(level);
+				res.push_back({ k.name, MathKernels::name(level), k.run() == ref });
+			}
+		}
+
+		MathKernels::setLevel(best);
+		return res;
+	}
+
+
+	////////////////////////////////////////////////////////////////////////////// OUTPUT
+
+	const char* compilerName() {
+#if defined(__clang__)
+		return "clang " __clang_version__;
+#elif defined(__GNUC__)
+		return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+		return "msvc";
+#else
+		return "unknown";
+#endif
+	}
+
+	void writeJson(std::ostream& os, const std::vector<bench::Result>& perf, const std::vector<Accuracy>& acc, const std::vector<Identity>& ident) {
+		bench::JsonWriter w;
+		w.beginObject();
+
+		w.beginObject("environment");
+		w.value("compiler", compilerName());
+#ifdef NDEBUG
+		w.value("optimized", true);
+#else
+		w.value("optimized", false);
+#endif
+#ifdef AVT_FAST_MATH
+		w.value("defaultPrecision", "fast");
+#else
+		w.value("defaultPrecision", "exact");
+#endif
+		w.value("detectedSimd", MathKernels::name(MathKernels::detect()));
+		w.beginArray("supportedSimd");
+		for (SimdLevel level : LEVELS) {
+			if (MathKernels::supported(level)) w.value(nullptr, MathKernels::name(level));
+		}
+		w.endArray();
+		w.endObject();
+
+		w.beginArray("benchmarks");
+		for (const bench::Result& r : perf) {
+			w.beginObject();
+			w.value("group", r.group);
+			w.value("name", r.name);
+			w.value("simd", r.simd);
+			w.value("vectorized", r.simd != "none" && r.simd != "scalar");
+			w.value("batch", r.batch);
+			w.value("nsPerOp", r.nsPerOp);
+			w.value("nsPerOpMin", r.nsPerOpMin);
+			w.value("nsPerElement", r.nsPerOp / r.batch);
+			w.value("allocsPerOp", r.allocsPerOp);
+			w.value("iterations", r.iterations);
+			w.endObject();
+		}
+		w.endArray();
+
+		w.beginArray("accuracy");
+		for (const Accuracy& a : acc) {
+			w.beginObject();
+			w.value("name", a.name);
+			w.value("metric", a.metric);
+			w.value("maxError", a.error);
+			w.value("bound", a.bound);
+			w.value("pass", a.pass());
+			w.endObject();
+		}
+		w.endArray();
+
+		w.beginArray("levelIdentity");
+		for (const Identity& i : ident) {
+			w.beginObject();
+			w.value("kernel", i.kernel);
+			w.value("level", i.level);
+			w.value("identical", i.identical);
+			w.endObject();
+		}
+		w.endArray();
+
+		w.endObject();
+		os << w.str() << std::endl;
+	}
+
+	void writeText(std::ostream& os, const std::vector<bench::Result>& perf, const std::vector<Accuracy>& acc, const std::vector<Identity>& ident) {
+		char line[256];
+		os << "simd: " << MathKernels::name(MathKernels::detect()) << ", compiler: " << compilerName() << std::endl;
+
+		if (!perf.empty()) {
+			std::snprintf(line, sizeof(line), "\n%-44s %-7s %6s %12s %12s %10s\n", "benchmark", "simd", "batch", "ns/op", "ns/element", "allocs/op");
+			os << line;
+			for (const bench::Result& r : perf) {
+				std::string name = r.group + "::" + r.name;
+				std::snprintf(line, sizeof(line), "%-44s %-7s %6zu %12.2f %12.3f %10.3f\n", name.c_str(), r.simd.c_str(), r.batch,
+					r.nsPerOp, r.nsPerOp / r.batch, r.allocsPerOp);
+				os << line;
+			}
+		}
+
+		if (!acc.empty()) {
+			std::snprintf(line, sizeof(line), "\n%-48s %-10s %12s %12s\n", "accuracy", "metric", "max error", "bound");
+			os << line;
+			for (const Accuracy& a : acc) {
+				std::snprintf(line, sizeof(line), "%-48s %-10.10s %12.3g %12.3g %s\n", a.name.c_str(), a.metric.c_str(), a.error, a.bound,
+					a.pass() ? "" : "FAIL");
+				os << line;
+			}
+		}
+
+		if (!ident.empty()) {
+			os << "\nbatch kernels identical to scalar:";
+			bool all = true;
+			for (const Identity& i : ident) {
+				if (!i.identical) {
+					os << "\n  " << i.kernel << " differs at " << i.level;
+					all = false;
+				}
+			}
+			os << (all ? " yes" : "") << std::endl;
+		}
+	}
+
+}
+
+
+int main(int argc, char** argv) {
+	bool json = false, perf = true, accuracy = true, check = false;
+	std::string out, filter;
+	double minTime = 10.0;
+	int samples = 5;
+
+	for (int i = 1; i < argc; i++) {
+		std::string arg = argv[i];
+		bool hasValue = i + 1 < argc;
+		if (arg == "--json") json = true;
+		else if (arg == "--out" && hasValue) out = argv[++i];
+		else if (arg == "--filter" && hasValue) filter = argv[++i];
+		else if (arg == "--min-time" && hasValue) minTime = std::atof(argv[++i]);
+		else if (arg == "--samples" && hasValue) samples = std::atoi(argv[++i]);
+		else if (arg == "--no-perf") perf = false;
+		else if (arg == "--no-accuracy") accuracy = false;
+		else if (arg == "--check") check = true;
+		else {
+			std::cerr << "usage: " << argv[0] << " [--json] [--out FILE] [--filter TEXT] [--min-time MS] [--samples N]"
+				" [--no-perf] [--no-accuracy] [--check]" << std::endl;
+			return 2;
+		}
+	}
+
+	std::vector<bench::Result> results;
+	if (perf) {
+		// batch kernels and the Mat4 operators backed by kernels once per level the CPU supports,
+		// everything else at the best one
+		Streams streams;
+		for (SimdLevel level : LEVELS) {
+			if (!MathKernels::setLevel(level)) continue;
+			bench::Runner runner;
+			runner.setMinSampleTime(minTime);
+			runner.setSamples(samples);
+			addBatches(runner, streams);
+			std::vector<bench::Result> r = runner.run(filter);
+			results.insert(results.end(), r.begin(), r.end());
+		}
+		MathKernels::setLevel(MathKernels::detect());
+
+		bench::Runner runner;
+		runner.setMinSampleTime(minTime);
+		runner.setSamples(samples);
+		addVectors(runner);
+		addMatrices(runner);
+		addQuaternions(runner);
+		addGeometry(runner);
+		addScene(runner, streams);
+		std::vector<bench::Result> r = runner.run(filter);
+		results.insert(results.end(), r.begin(), r.end());
+	}
+
+	std::vector<Accuracy> acc;
+	std::vector<Identity> ident;
+	if (accuracy) {
+		acc = runAccuracy();
+		ident = runIdentity();
+	}
+
+	std::ofstream file;
+	if (!out.empty()) {
+		file.open(out);
+		if (!file) {
+			std::cerr << "can't write " << out << std::endl;
+			return 2;
+		}
+	}
+	std::ostream& os = out.empty() ? std::cout : file;
+
+	if (json) writeJson(os, results, acc, ident);
+	else writeText(os, results, acc, ident);
+
+	if (check) {
+		for (const Accuracy& a : acc) {
+			if (!a.pass()) return 1;
+		}
+		for (const Identity& i : ident) {
+			if (!i.identical) return 1;
+		}
+		for (const bench::Result& r : results) {
+			if (r.group == "TransformHierarchy" && r.allocsPerOp != 0) return 1;
+		}
+	}
+	return 0;
+}
\ No newline at end of file
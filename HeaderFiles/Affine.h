@@ -0,0 +1,100 @@
+#pragma once
+
+#include <iostream>
+#include <type_traits>
+
+#include "Vector3.h"
+#include "Quaternion.h"
+#include "Mat3.h"
+#include "Mat4.h"
+
+
+namespace avt {
+
+	// 3x4 affine transform (3x3 linear part + translation), the implicit last row is (0, 0, 0, 1).
+	// Stored column major like Mat4 minus the bottom row: cells 0-8 are the linear columns,
+	// cells 9-11 the translation.
+	class Affine {
+	private:
+		alignas(16) float _cells[12];
+
+	public:
+		// identity
+		constexpr Affine()
+			: _cells{ 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0 } {}
+
+		constexpr float operator[](int i) const {
+			return _cells[i];
+		}
+
+		float& operator[](int i) {
+			return _cells[i];
+		}
+
+		constexpr const float* data() const {
+			return _cells;
+		}
+
+		float* data() {
+			return _cells;
+		}
+
+		constexpr float at(int row, int col) const {
+			return _cells[3 * col + row];
+		}
+
+		float& at(int row, int col) {
+			return _cells[3 * col + row];
+		}
+
+		Vector3 translation() const {
+			return Vector3(_cells[9], _cells[10], _cells[11]);
+		}
+
+		// parent * child, 36 multiplies
+		Affine operator*(const Affine& aff) const;
+
+		Affine& operator*=(const Affine& aff);
+
+		// transforms a point (w = 1)
+		Vector3 operator*(const Vector3& vec) const;
+
+		// transforms a direction (w = 0)
+		Vector3 transformVector(const Vector3& vec) const;
+
+		bool operator==(const Affine& aff) const;
+
+		bool operator!=(const Affine& aff) const;
+
+		friend std::ostream& operator<<(std::ostream& os, const Affine& aff);
+
+		float det() const;
+
+		Affine& invert();
+
+		Affine inverted() const;
+
+		// inverse transpose of the linear part, for transforming normals.
+		// Equals the linear part itself for rotation-only transforms; returned as is when singular
+		Mat3 normalMatrix() const;
+
+		Mat4 toMat4() const;
+
+		// writes the 16 column-major floats of the equivalent Mat4
+		void toMat4(float* out) const;
+
+		static constexpr Affine identity() {
+			return Affine();
+		}
+
+		// same result as Mat4::translation(t) * r.toMat() * Mat4::scale(s) without the two 4x4 products
+		static Affine fromTRS(const Vector3& t, const Quaternion& r, const Vector3& s);
+
+		// drops the bottom row
+		static Affine fromMat4(const Mat4& mat);
+	};
+
+	static_assert(std::is_trivially_copyable<Affine>::value, "Affine must stay a plain value type");
+	static_assert(sizeof(Affine) == 12 * sizeof(float), "Affine arrays must be packed 12-float records");
+
+}
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Geometry.h"
+#include "MathKernels.h"
+#include "SoAStorage.h"
+
+
+namespace avt {
+
+	// Structure-of-arrays boxes stored as center + half extent, the form the batch culling,
+	// ray and transform kernels work on (see SoAStorage)
+	class AABBStream {
+	private:
+		SoAStorage<6> _data;
+
+	public:
+		AABBStream() {}
+
+		explicit AABBStream(size_t size) {
+			_data.resize(size);
+		}
+
+		size_t size() const {
+			return _data.size();
+		}
+
+		bool empty() const {
+			return _data.size() == 0;
+		}
+
+		// keeps the current elements, new ones are zero
+		void resize(size_t size) {
+			_data.resize(size);
+		}
+
+		void reserve(size_t capacity) {
+			_data.reserve(capacity);
+		}
+
+		void clear() {
+			_data.clear();
+		}
+
+		void push_back(const AABB& box) {
+			set(_data.grow(), box);
+		}
+
+		AABB operator[](size_t i) const {
+			return AABB::fromCenterExtent(Vector3(_data[0][i], _data[1][i], _data[2][i]), Vector3(_data[3][i], _data[4][i], _data[5][i]));
+		}
+
+		void set(size_t i, const AABB& box) {
+			Vector3 c = box.center();
+			Vector3 e = box.extent();
+			_data[0][i] = c.x;
+			_data[1][i] = c.y;
+			_data[2][i] = c.z;
+			_data[3][i] = e.x;
+			_data[4][i] = e.y;
+			_data[5][i] = e.z;
+		}
+
+		// kernels take mutable pointers, const methods only pass these to read-only inputs
+		Vec3SoA centers() const {
+			return { const_cast<float*>(_data[0]), const_cast<float*>(_data[1]), const_cast<float*>(_data[2]) };
+		}
+
+		Vec3SoA extents() const {
+			return { const_cast<float*>(_data[3]), const_cast<float*>(_data[4]), const_cast<float*>(_data[5]) };
+		}
+
+		// visible[i] = frustum.intersects(this[i]), returns how many are visible
+		size_t cull(const Frustum& frustum, uint8_t* visible) const;
+
+		// t[i] = hit distance of the ray with box i or +infinity
+		void raycast(const Ray& ray, float* t) const;
+
+		// every box by the same transform
+		AABBStream& transform(const Affine& aff);
+
+		// out[i] = this[i].transformed(affs[i]), out is resized (and may be *this)
+		void transform(const Affine* affs, AABBStream& out) const;
+	};
+
+	class SphereStream {
+	private:
+		SoAStorage<4> _data;
+
+	public:
+		SphereStream() {}
+
+		explicit SphereStream(size_t size) {
+			_data.resize(size);
+		}
+
+		size_t size() const {
+			return _data.size();
+		}
+
+		bool empty() const {
+			return _data.size() == 0;
+		}
+
+		void resize(size_t size) {
+			_data.resize(size);
+		}
+
+		void reserve(size_t capacity) {
+			_data.reserve(capacity);
+		}
+
+		void clear() {
+			_data.clear();
+		}
+
+		void push_back(const Sphere& sphere) {
+			set(_data.grow(), sphere);
+		}
+
+		Sphere operator[](size_t i) const {
+			return Sphere(Vector3(_data[0][i], _data[1][i], _data[2][i]), _data[3][i]);
+		}
+
+		void set(size_t i, const Sphere& sphere) {
+			_data[0][i] = sphere.center.x;
+			_data[1][i] = sphere.center.y;
+			_data[2][i] = sphere.center.z;
+			_data[3][i] = sphere.radius;
+		}
+
+		Vec3SoA centers() const {
+			return { const_cast<float*>(_data[0]), const_cast<float*>(_data[1]), const_cast<float*>(_data[2]) };
+		}
+
+		const float* radii() const {
+			return _data[3];
+		}
+
+		// visible[i] = frustum.intersects(this[i]), returns how many are visible
+		size_t cull(const Frustum& frustum, uint8_t* visible) const;
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "CommandBuffer.h"
+
+
+namespace avt {
+
+	// Replays command buffers. execute walks a buffer's commands in order and hands each to the
+	// matching hook; a backend turns them into device calls (GLCommandBackend) or only tracks what
+	// they would do (HeadlessBackend). Nothing carries over from one buffer to the next
+	class CommandBackend {
+	protected:
+		virtual void begin(const CommandBuffer&) {}
+		virtual void bindPipeline(Material* material) = 0;
+		virtual void bindMesh(Mesh* mesh) = 0;
+		// transforms [first, first + count) of the buffer begun
+		virtual void setTransforms(uint32_t first, uint32_t count) = 0;
+		virtual void draw(DrawMode mode, uint32_t instances) = 0;
+		virtual void end() {}
+
+	public:
+		virtual ~CommandBackend() {}
+
+		void execute(const CommandBuffer& buffer);
+	};
+
+	// Executes commands without a GL context: keeps the bound state, checks each draw against it,
+	// counts the work and reads every transform drawn, so recording and replay throughput can be
+	// measured on a machine with no window
+	class HeadlessBackend : public CommandBackend {
+	public:
+		struct Stats {
+			size_t buffers = 0;
+			size_t commands = 0;
+			size_t pipelineBinds = 0;
+			size_t meshBinds = 0;
+			size_t draws = 0;
+			size_t instances = 0;
+			size_t vertices = 0;
+			size_t invalid = 0; // draws with nothing bound or fewer transforms than instances, skipped
+		};
+
+	private:
+		const CommandBuffer* _buffer = nullptr;
+		Material* _material = nullptr;
+		Mesh* _mesh = nullptr;
+		uint32_t _first = 0, _count = 0;
+		Stats _stats;
+		float _checksum = 0;
+
+	protected:
+		void begin(const CommandBuffer& buffer) override;
+		void bindPipeline(Material* material) override;
+		void bindMesh(Mesh* mesh) override;
+		void setTransforms(uint32_t first, uint32_t count) override;
+		void draw(DrawMode mode, uint32_t instances) override;
+
+	public:
+		HeadlessBackend() = default;
+
+		void reset() {
+			_stats = Stats();
+			_checksum = 0;
+		}
+
+		// since the last reset
+		const Stats& stats() const {
+			return _stats;
+		}
+
+		// sum of the drawn model matrices' translations, depends on every transform drawn
+		float checksum() const {
+			return _checksum;
+		}
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Affine.h"
+#include "Renderable.h"
+
+
+namespace avt {
+
+	class Material;
+	class Mesh;
+	class RenderQueue;
+
+	// Draws recorded as plain commands, with no device call made while recording: bind a pipeline
+	// (a material and its shader), bind a mesh, set the transforms the next draw reads (one per
+	// instance, from the buffer's own array), draw. A buffer is recorded by one thread, any thread,
+	// and replayed later by a CommandBackend on the thread that owns the device; several threads
+	// can each record their own buffer at once. The objects pointed to must outlive the replay,
+	// and a mesh isn't set up or updated until then. Clearing keeps the capacity
+	class CommandBuffer {
+	public:
+		enum class Op : uint8_t {
+			BindPipeline,
+			BindMesh,
+			SetTransforms,
+			Draw
+		};
+
+		struct Command {
+			Op op;
+			DrawMode mode; // Draw
+			uint16_t materialId; // BindPipeline, for object buffer shaders
+			uint32_t first; // SetTransforms, into transforms()
+			uint32_t count; // SetTransforms: transforms, Draw: instances
+			Material* material; // BindPipeline
+			Mesh* mesh; // BindMesh
+		};
+
+	private:
+		std::vector<Command> _commands;
+		std::vector<Affine> _transforms;
+
+	public:
+		CommandBuffer() = default;
+
+		void clear() {
+			_commands.clear();
+			_transforms.clear();
+		}
+
+		// the objects drawn until the next bind carry materialId
+		void bindPipeline(Material* material, uint16_t materialId = 0) {
+			_commands.push_back({ Op::BindPipeline, DrawMode::Triangles, materialId, 0, 0, material, nullptr });
+		}
+
+		void bindMesh(Mesh* mesh) {
+			_commands.push_back({ Op::BindMesh, DrawMode::Triangles, 0, 0, 0, nullptr, mesh });
+		}
+
+		// copied into the buffer
+		void setTransforms(const Affine* worlds, size_t count);
+
+		void setTransform(const Affine& world) {
+			setTransforms(&world, 1);
+		}
+
+		// instances of the bound mesh, instance i at the i-th of the last transforms set
+		void draw(DrawMode mode, uint32_t instances = 1) {
+			_commands.push_back({ Op::Draw, mode, 0, 0, instances, nullptr, nullptr });
+		}
+
+		// the queue's items in its current order, binding only what changes from one to the next, each
+		// material with the queue's id for it.
+		// Under an instanced or object buffer shader a run of the same mesh, material and mode is
+		// one draw of many instances
+		void record(const RenderQueue& queue);
+
+		// only the items [begin, end)
+		void record(const RenderQueue& queue, size_t begin, size_t end);
+
+		const std::vector<Command>& commands() const {
+			return _commands;
+		}
+
+		const std::vector<Affine>& transforms() const {
+			return _transforms;
+		}
+
+		size_t size() const {
+			return _commands.size();
+		}
+
+		bool empty() const {
+			return _commands.empty();
+		}
+	};
+
+}
\ No newline at end of file
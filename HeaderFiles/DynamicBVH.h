@@ -0,0 +1,273 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "Geometry.h"
+
+
+namespace avt {
+
+	// Bounding volume hierarchy over boxes that move, appear and disappear: a binary tree with one
+	// box per leaf, each leaf carrying a user value. Inserting descends toward the sibling that adds
+	// the least surface area, a moved leaf only marks its path up and refit recomputes the marked
+	// nodes bottom-up. Once the tree's surface area drifts too far above what its last build had,
+	// refit starts a binned SAH build of the current boxes on a background thread and later swaps
+	// it in, with the changes made in the meantime replayed on it.
+	class DynamicBVH {
+	public:
+		using Proxy = uint32_t;
+		static constexpr uint32_t NONE = 0xffffffffu;
+
+		// leaves before refit considers a rebuild
+		static const size_t MIN_REBUILD = 64;
+
+		struct Stats {
+			size_t leaves = 0;
+			size_t refitted = 0; // inner nodes recomputed by the last refit
+			size_t rebuilds = 0; // builds swapped in so far
+			float cost = 0; // surface area of the inner nodes over the root's
+			float builtCost = 0; // the same right after the last build
+		};
+
+	private:
+		struct Node {
+			AABB box;
+			uint32_t parent;
+			uint32_t child[2]; // NONE for a leaf
+			Proxy proxy; // leaves only
+			uint32_t dirty; // a descendant moved since the last refit
+		};
+
+		struct Rebuild; // the background build, see DynamicBVH.cpp
+
+		// a traversal stack on the call stack, on the heap only for very deep trees
+		template<typename T>
+		class Stack {
+		private:
+			T _local[64];
+			std::vector<T> _spill;
+			size_t _size = 0;
+
+		public:
+			bool empty() const {
+				return _size == 0;
+			}
+
+			void push(const T& value) {
+				if (_size < 64) _local[_size] = value;
+				else _spill.push_back(value);
+				_size++;
+			}
+
+			T pop() {
+				_size--;
+				if (_size < 64) return _local[_size];
+				T value = _spill.back();
+				_spill.pop_back();
+				return value;
+			}
+		};
+
+		std::vector<Node> _nodes;
+		std::vector<uint32_t> _freeNodes;
+		uint32_t _root = NONE;
+
+		// per proxy
+		std::vector<AABB> _box;
+		std::vector<uint32_t> _value;
+		std::vector<uint32_t> _leaf; // NONE for a free proxy
+		std::vector<Proxy> _freeProxies;
+
+		std::vector<uint32_t> _order; // scratch of refit
+		double _area = 0; // of the inner nodes, kept up to date by every box change
+		float _rebuildRatio = 1.5f;
+		size_t _leaves = 0;
+		bool _built = false;
+		Stats _stats;
+
+		std::unique_ptr<Rebuild> _rebuild;
+		std::vector<Proxy> _changed; // proxies touched while a rebuild runs
+
+		static float area(const AABB& box) {
+			if (box.empty()) return 0;
+			Vector3 d = box.upper - box.lower;
+			return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+		}
+
+		static AABB merge(const AABB& a, const AABB& b) {
+			AABB box = a;
+			return box.expand(b);
+		}
+
+		bool isLeaf(uint32_t n) const {
+			return _nodes[n].child[0] == NONE;
+		}
+
+		uint32_t allocate();
+		void setBox(uint32_t n, const AABB& box);
+		void markPath(uint32_t n);
+		void insertLeaf(uint32_t leaf);
+		void removeLeaf(uint32_t leaf);
+		std::unique_ptr<Rebuild> snapshot() const;
+		void adopt(Rebuild& rebuild);
+		void refitMarked();
+		double innerArea() const;
+
+		// slab test, t is where the ray enters (0 from inside)
+		static bool hit(const Vector3& origin, const Vector3& inverse, float tMax, const AABB& box, float& t) {
+			float t0 = 0, t1 = tMax;
+			for (int i = 0; i < 3; i++) {
+				float o = (&origin.x)[i], inv = (&inverse.x)[i];
+				float a = ((&box.lower.x)[i] - o) * inv;
+				float b = ((&box.upper.x)[i] - o) * inv;
+				if (a > b) std::swap(a, b);
+				t0 = a > t0 ? a : t0; // NaN (ray in the slab plane) keeps the previous bound
+				t1 = b < t1 ? b : t1;
+			}
+			t = t0;
+			return t0 <= t1;
+		}
+
+		static bool visible(const Frustum& frustum, const AABB& box) {
+			Vector3 c = box.center(), e = box.extent();
+			const float* p = frustum.data();
+			for (int i = 0; i < 6; i++, p += 4) {
+				float r = e.x * (p[0] < 0 ? -p[0] : p[0]) + e.y * (p[1] < 0 ? -p[1] : p[1]) + e.z * (p[2] < 0 ? -p[2] : p[2]);
+				if (p[0] * c.x + p[1] * c.y + p[2] * c.z + p[3] + r < 0) return false;
+			}
+			return true;
+		}
+
+	public:
+		DynamicBVH();
+
+		DynamicBVH(const DynamicBVH&) = delete;
+		DynamicBVH& operator=(const DynamicBVH&) = delete;
+
+		// waits for a running rebuild
+		~DynamicBVH();
+
+		// drops every leaf, a running rebuild is waited for and discarded
+		void clear();
+
+		Proxy insert(const AABB& box, uint32_t value);
+
+		void remove(Proxy proxy);
+
+		// the leaf takes the new box at once, the nodes above it on the next refit
+		void update(Proxy proxy, const AABB& box);
+
+		// the nodes on the paths of updated leaves, then the rebuild: a finished one is swapped in,
+		// a new one is started when the cost grew past rebuildRatio times the last build's
+		void refit();
+
+		// SAH build of the current leaves on this thread, for after a bulk load
+		void build();
+
+		// cost over the last build's cost that starts a rebuild, 0 disables them
+		void setRebuildRatio(float ratio) {
+			_rebuildRatio = ratio;
+		}
+
+		bool rebuilding() const {
+			return _rebuild != nullptr;
+		}
+
+		const AABB& bounds(Proxy proxy) const {
+			return _box[proxy];
+		}
+
+		uint32_t value(Proxy proxy) const {
+			return _value[proxy];
+		}
+
+		size_t size() const {
+			return _leaves;
+		}
+
+		// of the whole tree, as of the last refit
+		AABB bounds() const {
+			return _root == NONE ? AABB() : _nodes[_root].box;
+		}
+
+		const Stats& stats() const {
+			return _stats;
+		}
+
+		// queries see inner boxes as of the last refit
+
+		// visit(value) for the leaves whose box overlaps box
+		template<typename F>
+		void query(const AABB& box, F visit) const {
+			if (_root == NONE) return;
+			Stack<uint32_t> stack;
+			stack.push(_root);
+			while (!stack.empty()) {
+				const Node& node = _nodes[stack.pop()];
+				if (!node.box.intersects(box)) continue;
+				if (node.child[0] == NONE) visit(_value[node.proxy]);
+				else {
+					stack.push(node.child[0]);
+					stack.push(node.child[1]);
+				}
+			}
+		}
+
+		// visit(value) for the leaves not fully outside one of the planes
+		template<typename F>
+		void query(const Frustum& frustum, F visit) const {
+			if (_root == NONE) return;
+			Stack<uint32_t> stack;
+			stack.push(_root);
+			while (!stack.empty()) {
+				const Node& node = _nodes[stack.pop()];
+				if (!visible(frustum, node.box)) continue;
+				if (node.child[0] == NONE) visit(_value[node.proxy]);
+				else {
+					stack.push(node.child[0]);
+					stack.push(node.child[1]);
+				}
+			}
+		}
+
+		// hit(value, t) for the leaves the ray enters before its current tMax, nearer boxes first.
+		// hit returns the new tMax: its t to keep only closer hits, the old one to see them all
+		template<typename F>
+		void raycast(const Ray& ray, F hit) const {
+			if (_root == NONE) return;
+			Vector3 inverse(1.0f / ray.direction.x, 1.0f / ray.direction.y, 1.0f / ray.direction.z);
+			float tMax = ray.tMax, t;
+			if (!DynamicBVH::hit(ray.origin, inverse, tMax, _nodes[_root].box, t)) return;
+
+			Stack<std::pair<uint32_t, float>> stack;
+			stack.push({ _root, t });
+			while (!stack.empty()) {
+				auto entry = stack.pop();
+				if (entry.second > tMax) continue;
+
+				const Node& node = _nodes[entry.first];
+				if (node.child[0] == NONE) {
+					float limit = hit(_value[node.proxy], entry.second);
+					tMax = limit < tMax ? limit : tMax;
+					continue;
+				}
+
+				float t0, t1;
+				bool h0 = DynamicBVH::hit(ray.origin, inverse, tMax, _nodes[node.child[0]].box, t0);
+				bool h1 = DynamicBVH::hit(ray.origin, inverse, tMax, _nodes[node.child[1]].box, t1);
+				if (h0 && h1 && t1 < t0) { // farther one below
+					stack.push({ node.child[0], t0 });
+					stack.push({ node.child[1], t1 });
+				} else {
+					if (h1) stack.push({ node.child[1], t1 });
+					if (h0) stack.push({ node.child[0], t0 });
+				}
+			}
+		}
+	};
+
+}
\ No newline at end of file
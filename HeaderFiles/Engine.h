@@ -6,6 +6,8 @@
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
 
+// ahead of avt_math.h, its min / max macros break <thread>
+#include "TaskSystem.h"
 
 #include "App.h"
 
@@ -17,6 +19,7 @@
 #include "Renderer.h"
 #include "avt_math.h"
 #include "ErrorManager.h"
+#include "GLState.h"
 #include "Texture.h"
 #include "PerspectiveCamera.h"
 #include "OrthographicCamera.h"
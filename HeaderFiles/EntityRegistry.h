@@ -0,0 +1,170 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "Geometry.h"
+#include "SparseSet.h"
+#include "TransformHierarchy.h"
+
+
+namespace avt {
+
+	class Renderable;
+	class Prefab;
+	struct PrefabOverrides;
+
+	// Objects many entities point at, each stored once and counted by its users. Components hold
+	// the index, a slot is freed and reused once its last user lets go
+	template<typename T>
+	class SharedTable {
+	public:
+		static constexpr uint32_t NONE = 0xffffffffu;
+
+	private:
+		std::vector<std::shared_ptr<T>> _values;
+		std::vector<uint32_t> _uses;
+		std::vector<uint32_t> _free;
+		std::vector<std::pair<const T*, uint32_t>> _lookup; // sorted by pointer
+
+	public:
+		// the slot of value, one more use. NONE for nullptr
+		uint32_t acquire(const std::shared_ptr<T>& value);
+
+		// one use less, NONE is ignored
+		void release(uint32_t index);
+
+		const std::shared_ptr<T>& at(uint32_t index) const {
+			return _values[index];
+		}
+
+		// free ones (empty) included
+		size_t slots() const {
+			return _values.size();
+		}
+
+		void clear();
+	};
+
+	template<typename T>
+	constexpr uint32_t SharedTable<T>::NONE;
+
+	// components, each in a SparseSet of the registry
+
+	// index into EntityRegistry::renderableAt
+	struct RenderableId {
+		uint32_t index;
+	};
+
+	// world box of the renderable's mesh as of the last Scene::updateTransforms, see SceneBounds
+	struct WorldBounds {
+		AABB box;
+	};
+
+	// stencil value of a picking target, see StencilPicker
+	struct PickId {
+		unsigned int stencil;
+	};
+
+	// placement of a Prefab, indices into EntityRegistry::prefabAt and overridesAt
+	struct PrefabInstance {
+		uint32_t prefab;
+		uint32_t overrides; // NONE for none
+	};
+
+	// Component storage for the nodes of one TransformHierarchy, an entity being a transform id.
+	// Transform and WorldMatrix are the hierarchy's own arrays (dense, depth-ordered); renderable,
+	// prefab, bounds and picking data sit in sparse sets here. A system that needs one kind of data runs over
+	// that set alone instead of walking the nodes, SceneNode stays as the facade reading and writing it
+	class EntityRegistry {
+	public:
+		using Entity = TransformHierarchy::Id;
+
+	private:
+		SparseSet<RenderableId> _renderableIds;
+		SparseSet<PrefabInstance> _prefabInstances;
+		SparseSet<WorldBounds> _bounds;
+		SparseSet<PickId> _picks;
+
+		SharedTable<Renderable> _renderables;
+		SharedTable<const Prefab> _prefabs;
+		SharedTable<const PrefabOverrides> _overrides;
+
+	public:
+		EntityRegistry() = default;
+
+		EntityRegistry(const EntityRegistry&) = delete;
+		EntityRegistry& operator=(const EntityRegistry&) = delete;
+
+		// nullptr drops the component. Taken by value, rend may be one of this registry's own slots
+		void setRenderable(Entity e, std::shared_ptr<Renderable> rend);
+
+		// empty when the entity has none. Valid until the next setRenderable or remove
+		const std::shared_ptr<Renderable>& renderable(Entity e) const;
+
+		const std::shared_ptr<Renderable>& renderableAt(uint32_t index) const {
+			return _renderables.at(index);
+		}
+
+		// renderable slots, free ones (empty) included
+		size_t renderableSlots() const {
+			return _renderables.slots();
+		}
+
+		// nullptr prefab drops the component, overrides may be nullptr
+		void setPrefab(Entity e, std::shared_ptr<const Prefab> prefab, std::shared_ptr<const PrefabOverrides> overrides);
+
+		// empty when the entity has none. Valid until the next setPrefab or remove
+		const std::shared_ptr<const Prefab>& prefab(Entity e) const;
+		const std::shared_ptr<const PrefabOverrides>& prefabOverrides(Entity e) const;
+
+		const std::shared_ptr<const Prefab>& prefabAt(uint32_t index) const {
+			return _prefabs.at(index);
+		}
+
+		const std::shared_ptr<const PrefabOverrides>& overridesAt(uint32_t index) const {
+			return _overrides.at(index);
+		}
+
+		// 0 drops the component
+		void setPick(Entity e, unsigned int stencil) {
+			if (stencil) _picks.set(e, { stencil });
+			else _picks.remove(e);
+		}
+
+		// 0 when the entity is no picking target
+		unsigned int pick(Entity e) const {
+			const PickId* p = _picks.find(e);
+			return p ? p->stencil : 0;
+		}
+
+		const SparseSet<RenderableId>& renderableIds() const {
+			return _renderableIds;
+		}
+
+		const SparseSet<PrefabInstance>& prefabInstances() const {
+			return _prefabInstances;
+		}
+
+		SparseSet<WorldBounds>& bounds() {
+			return _bounds;
+		}
+
+		const SparseSet<WorldBounds>& bounds() const {
+			return _bounds;
+		}
+
+		const SparseSet<PickId>& picks() const {
+			return _picks;
+		}
+
+		// every component of the entity, before its transform id is reused
+		void remove(Entity e);
+
+		void clear();
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cmath>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#include <xmmintrin.h>
+#define AVT_FAST_RSQRT_SSE 1
+#else
+#include <cstring>
+#endif
+
+
+namespace avt {
+
+	// Precision policies for the math layer, passed as a template parameter
+	// (e.g. vec.normalized<precision::Fast>()).
+	// Exact calls the C library. Fast uses the approximations below, with these maximum errors
+	// (measured over the whole float range unless stated otherwise):
+	//   rsqrt  relative 3e-7 with SSE (rsqrtss + one Newton step), 5e-6 elsewhere (bit trick + two steps)
+	//   sqrt   relative, same as rsqrt; sqrt(0) = 0
+	//   sin    absolute 2.5e-7 for |x| <= pi, grows with |x| from the range reduction:
+	//          4e-6 at |x| = 100, 8e-5 at 1e3, 7e-3 at 1e5
+	//   cos    no worse than sin
+	//   acos   absolute 5e-7; the input is clamped to [-1, 1] instead of returning NaN
+	// Building with AVT_FAST_MATH defined makes Fast the default policy everywhere one is not named.
+	namespace precision {
+
+		// polynomial coefficients, highest degree first. Also used by the batch quaternion kernels
+		namespace poly {
+			constexpr float PI = 3.14159265f;
+			constexpr float HALF_PI = 1.57079633f;
+			constexpr float TWO_PI = 6.28318531f;
+			constexpr float INV_TWO_PI = 0.159154943f;
+
+			// acos(d) = sqrt(1 - d) * poly(d) on [0, 1], |error| <= 2e-8 (Abramowitz & Stegun 4.4.46)
+			constexpr float ACOS[8] = { -0.0012624911f, 0.0066700901f, -0.0170881256f, 0.0308918810f,
+				-0.0501743046f, 0.0889789874f, -0.2145988016f, 1.5707963050f };
+
+			// sin(y) = y * poly(y^2) on [-pi/2, pi/2], Taylor to y^11, |error| < 6e-8
+			constexpr float SIN[6] = { -2.5052108e-8f, 2.7557319e-6f, -1.9841270e-4f, 8.3333333e-3f,
+				-1.6666667e-1f, 1.0f };
+
+			// 2 pi split in two so the range reduction keeps the low bits (Cody-Waite)
+			constexpr float TWO_PI_HI = 6.28125f;
+			constexpr float TWO_PI_LO = 1.9353071795864769e-3f;
+
+			inline float acos01(float d) {
+				float p = ACOS[0];
+				for (int j = 1; j < 8; j++) p = p * d + ACOS[j];
+				return std::sqrt(1.0f - d) * p;
+			}
+
+			inline float sinHalfPi(float y) {
+				float y2 = y * y;
+				float p = SIN[0];
+				for (int j = 1; j < 6; j++) p = p * y2 + SIN[j];
+				return y * p;
+			}
+
+			// x - 2 pi * round(x / 2 pi), clamped to [-pi, pi] since huge x have no fractional bits left
+			inline float reduce(float x) {
+				float k = std::floor(x * INV_TWO_PI + 0.5f);
+				float r = (x - k * TWO_PI_HI) - k * TWO_PI_LO;
+				return r > PI ? PI : (r < -PI ? -PI : r);
+			}
+		}
+
+		struct Exact {
+			static constexpr bool EXACT = true;
+
+			static float sqrt(float x) {
+				return std::sqrt(x);
+			}
+
+			static float rsqrt(float x) {
+				return 1.0f / std::sqrt(x);
+			}
+
+			static float sin(float x) {
+				return std::sin(x);
+			}
+
+			static float cos(float x) {
+				return std::cos(x);
+			}
+
+			static float acos(float x) {
+				return std::acos(x);
+			}
+		};
+
+		struct Fast {
+			static constexpr bool EXACT = false;
+
+			static float rsqrt(float x) {
+#ifdef AVT_FAST_RSQRT_SSE
+				float y = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(x)));
+				return y * (1.5f - 0.5f * x * y * y);
+#else
+				unsigned int i;
+				std::memcpy(&i, &x, sizeof(i));
+				i = 0x5f375a86 - (i >> 1);
+				float y;
+				std::memcpy(&y, &i, sizeof(y));
+				y = y * (1.5f - 0.5f * x * y * y);
+				return y * (1.5f - 0.5f * x * y * y);
+#endif
+			}
+
+			static float sqrt(float x) {
+				return x > 0 ? x * rsqrt(x) : 0.0f;
+			}
+
+			static float sin(float x) {
+				float r = poly::reduce(x);
+				if (r > poly::HALF_PI) r = poly::PI - r;
+				else if (r < -poly::HALF_PI) r = -poly::PI - r;
+				return poly::sinHalfPi(r);
+			}
+
+			// cos(x) = sin(pi/2 - |x|) with |x| in [0, pi]
+			static float cos(float x) {
+				float r = poly::reduce(x);
+				return poly::sinHalfPi(poly::HALF_PI - std::fabs(r));
+			}
+
+			static float acos(float x) {
+				float a = std::fabs(x);
+				a = a > 1.0f ? 1.0f : a;
+				float r = poly::acos01(a);
+				return x < 0 ? poly::PI - r : r;
+			}
+		};
+
+#ifdef AVT_FAST_MATH
+		using Default = Fast;
+#else
+		using Default = Exact;
+#endif
+
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <memory>
+#include <vector>
+
+#include "CommandBackend.h"
+#include "MeshArena.h"
+#include "StorageBuffer.h"
+#include "VertexBuffer.h"
+#include "Mat4.h"
+
+
+namespace avt {
+
+	class Shader;
+
+	// Replays command buffers as GL calls, on the thread that owns the context. A mesh is set up
+	// or updated when bound, as the renderer would while drawing. A draw under a plain shader is
+	// one glDrawArrays per instance with the model matrix as uniforms; under an instanced shader it
+	// reads its matrices from the buffer's transforms, uploaded once per buffer; under an object
+	// buffer shader it goes through the mesh arena with the buffer's transforms as the objects,
+	// starting at its first one as base instance
+	class GLCommandBackend : public CommandBackend {
+	private:
+		MeshArena& _arena;
+		Mat4 _lightSpace = Mat4::identity();
+
+		std::unique_ptr<VertexBuffer> _instances; // made on first use
+		std::unique_ptr<StorageBuffer> _objects;
+		std::vector<float> _instanceData;
+		std::vector<MeshArena::Object> _objectData;
+
+		// during a replay
+		const CommandBuffer* _buffer = nullptr;
+		Material* _material = nullptr;
+		Shader* _shader = nullptr;
+		Mesh* _mesh = nullptr;
+		uint32_t _first = 0, _count = 0;
+		bool _instancesUploaded = false, _objectsUploaded = false;
+
+		void uploadInstances();
+		void uploadObjects();
+
+	protected:
+		void begin(const CommandBuffer& buffer) override;
+		void bindPipeline(Material* material) override;
+		void bindMesh(Mesh* mesh) override;
+		void setTransforms(uint32_t first, uint32_t count) override;
+		void draw(DrawMode mode, uint32_t instances) override;
+
+	public:
+		// object buffer shaders draw from arena
+		explicit GLCommandBackend(MeshArena& arena) : _arena(arena) {}
+
+		GLCommandBackend(const GLCommandBackend&) = delete;
+		GLCommandBackend& operator=(const GLCommandBackend&) = delete;
+
+		// light projection * light view, see Renderer::setLightSpace
+		void setLightSpace(const Mat4& lightViewProj) {
+			_lightSpace = lightViewProj;
+		}
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <cstddef>
+#include <GL/glew.h>
+
+namespace avt {
+
+	// The binds and enables of the GL context mirrored on the cpu, so a call that wouldn't change
+	// anything is never made: the program, the vertex array, the buffer of each target (and the
+	// indexed uniform / storage bindings), the 2D texture of each unit and the capabilities.
+	// Every bind in the engine goes through here; code that changes these with GL directly must
+	// call invalidate afterwards. Starts as a new context is, nothing bound. Counts the calls made
+	// and filtered out, per frame
+	class GLState {
+	public:
+		struct Counts {
+			size_t issued = 0;
+			size_t filtered = 0;
+		};
+
+		struct Stats {
+			Counts program, vertexArray, buffer, texture, capability;
+
+			size_t issued() const {
+				return program.issued + vertexArray.issued + buffer.issued + texture.issued + capability.issued;
+			}
+
+			size_t filtered() const {
+				return program.filtered + vertexArray.filtered + buffer.filtered + texture.filtered + capability.filtered;
+			}
+		};
+
+	private:
+		static constexpr GLuint UNKNOWN = 0xffffffffu;
+		static const unsigned TARGETS = 7;
+		static const unsigned BINDING_POINTS = 32;
+		static const unsigned TEXTURE_UNITS = 32;
+		static const unsigned CAPABILITIES = 8;
+
+		static GLuint _program;
+		static GLuint _vertexArray;
+		static GLuint _buffers[TARGETS];
+		static GLuint _bases[2][BINDING_POINTS]; // uniform, shader storage
+		static GLuint _activeUnit;
+		static GLuint _textures[TEXTURE_UNITS];
+		static GLenum _capabilities[CAPABILITIES];
+		static signed char _enabled[CAPABILITIES]; // -1 unknown
+
+		static Stats _stats, _lastFrame;
+
+		GLState() {}
+
+		static int target(GLenum target) {
+			switch (target) {
+			case GL_ARRAY_BUFFER:			return 0;
+			case GL_ELEMENT_ARRAY_BUFFER:	return 1;
+			case GL_UNIFORM_BUFFER:			return 2;
+			case GL_SHADER_STORAGE_BUFFER:	return 3;
+			case GL_DRAW_INDIRECT_BUFFER:	return 4;
+			case GL_COPY_READ_BUFFER:		return 5;
+			case GL_COPY_WRITE_BUFFER:		return 6;
+			default:						return -1;
+			}
+		}
+
+		static int capability(GLenum cap);
+
+		// whether the call is needed, updating the cached value and the counters
+		static bool change(GLuint& cached, GLuint value, Counts& counts) {
+			if (cached == value) {
+				counts.filtered++;
+				return false;
+			}
+			cached = value;
+			counts.issued++;
+			return true;
+		}
+
+	public:
+		// forgets everything, the next call of each kind is made
+		static void invalidate();
+
+		// starts the counters over, keeping the ones of the frame that ends for lastFrame
+		static void beginFrame() {
+			_lastFrame = _stats;
+			_stats = Stats();
+		}
+
+		static const Stats& stats() {
+			return _stats;
+		}
+
+		static const Stats& lastFrame() {
+			return _lastFrame;
+		}
+
+		static void useProgram(GLuint program) {
+			if (change(_program, program, _stats.program)) glUseProgram(program);
+		}
+
+		// the element array buffer is vertex array state, it is unknown after a change
+		static void bindVertexArray(GLuint vertexArray) {
+			if (!change(_vertexArray, vertexArray, _stats.vertexArray)) return;
+			glBindVertexArray(vertexArray);
+			_buffers[1] = UNKNOWN;
+		}
+
+		static void bindBuffer(GLenum target, GLuint buffer) {
+			int t = GLState::target(target);
+			if (t < 0) {
+				_stats.buffer.issued++;
+				glBindBuffer(target, buffer);
+			} else if (change(_buffers[t], buffer, _stats.buffer)) {
+				glBindBuffer(target, buffer);
+			}
+		}
+
+		// also binds the buffer to the target, as GL does
+		static void bindBufferBase(GLenum target, GLuint index, GLuint buffer);
+
+		static void activeTexture(GLuint unit) {
+			if (change(_activeUnit, unit, _stats.texture)) glActiveTexture(GL_TEXTURE0 + unit);
+		}
+
+		// to the active unit
+		static void bindTexture(GLenum target, GLuint texture) {
+			if (target != GL_TEXTURE_2D || _activeUnit >= TEXTURE_UNITS) {
+				_stats.texture.issued++;
+				glBindTexture(target, texture);
+			} else if (change(_textures[_activeUnit], texture, _stats.texture)) {
+				glBindTexture(target, texture);
+			}
+		}
+
+		// the unit is only made active when its texture changes
+		static void bindTexture(GLuint unit, GLenum target, GLuint texture) {
+			if (target == GL_TEXTURE_2D && unit < TEXTURE_UNITS && _textures[unit] == texture) {
+				_stats.texture.filtered++;
+				return;
+			}
+			activeTexture(unit);
+			bindTexture(target, texture);
+		}
+
+		static void enable(GLenum cap);
+
+		static void disable(GLenum cap);
+
+		// GL resets the bindings of a deleted object to 0, these mirror that
+		static void deleteBuffer(GLuint buffer);
+		static void deleteVertexArray(GLuint vertexArray);
+		static void deleteTexture(GLuint texture);
+		static void deleteProgram(GLuint program);
+	};
+
+}
\ No newline at end of file
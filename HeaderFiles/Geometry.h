@@ -0,0 +1,160 @@
+#pragma once
+
+#include <iostream>
+#include <limits>
+#include <type_traits>
+
+#include "Vector3.h"
+#include "Mat4.h"
+#include "Affine.h"
+
+
+namespace avt {
+
+	class Vector3Stream;
+
+	// n . p + d = 0, points with n . p + d > 0 are on the positive (inner) side
+	struct Plane {
+		Vector3 normal;
+		float d;
+
+		constexpr Plane(const Vector3& normal = Vector3(0, 1, 0), float d = 0)
+			: normal(normal), d(d) {}
+
+		static Plane fromPointNormal(const Vector3& point, const Vector3& normal);
+
+		// signed, in units of the normal's length
+		float distanceTo(const Vector3& point) const;
+
+		Plane& normalize();
+
+		Plane normalized() const;
+
+		friend std::ostream& operator<<(std::ostream& os, const Plane& plane);
+	};
+
+	struct Sphere {
+		Vector3 center;
+		float radius;
+
+		constexpr Sphere(const Vector3& center = Vector3(), float radius = 0)
+			: center(center), radius(radius) {}
+
+		bool contains(const Vector3& point) const;
+
+		bool intersects(const Sphere& sphere) const;
+
+		// scaled by the longest axis of the linear part
+		Sphere transformed(const Affine& aff) const;
+
+		friend std::ostream& operator<<(std::ostream& os, const Sphere& sphere);
+	};
+
+	// axis-aligned box, lower <= upper on every axis unless empty
+	struct AABB {
+		Vector3 lower;
+		Vector3 upper;
+
+		// empty: any expand() replaces it
+		constexpr AABB()
+			: lower(std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max()),
+			upper(-std::numeric_limits<float>::max(), -std::numeric_limits<float>::max(), -std::numeric_limits<float>::max()) {}
+
+		constexpr AABB(const Vector3& lower, const Vector3& upper)
+			: lower(lower), upper(upper) {}
+
+		static AABB fromCenterExtent(const Vector3& center, const Vector3& extent);
+
+		static AABB fromPoints(const Vector3Stream& points);
+
+		bool empty() const;
+
+		Vector3 center() const;
+
+		// half size
+		Vector3 extent() const;
+
+		Sphere boundingSphere() const;
+
+		AABB& expand(const Vector3& point);
+
+		AABB& expand(const AABB& box);
+
+		bool contains(const Vector3& point) const;
+
+		bool intersects(const AABB& box) const;
+
+		// Arvo's method: the box that bounds this one transformed by aff
+		AABB transformed(const Affine& aff) const;
+
+		friend std::ostream& operator<<(std::ostream& os, const AABB& box);
+	};
+
+	// the 6 planes of a view volume, normals pointing inwards
+	class Frustum {
+	public:
+		enum class Side {
+			Left, Right, Bottom, Top, Near, Far
+		};
+
+	private:
+		Plane _planes[6];
+
+	public:
+		Frustum() {}
+
+		// Gribb-Hartmann extraction from projection * view (or projection alone for view space)
+		explicit Frustum(const Mat4& viewProjection);
+
+		const Plane& plane(Side side) const {
+			return _planes[static_cast<int>(side)];
+		}
+
+		// the 6 planes as 24 floats, the layout the batch kernels read
+		const float* data() const {
+			return &_planes[0].normal.x;
+		}
+
+		bool contains(const Vector3& point) const;
+
+		// the whole box on the inner side of every plane
+		bool contains(const AABB& box) const;
+
+		// conservative: false only when the volume is fully behind one plane
+		bool intersects(const AABB& box) const;
+
+		bool intersects(const Sphere& sphere) const;
+	};
+
+	struct Ray {
+		Vector3 origin;
+		Vector3 direction;
+		float tMax;
+
+		constexpr Ray(const Vector3& origin = Vector3(), const Vector3& direction = Vector3(0, 0, -1),
+			float tMax = std::numeric_limits<float>::infinity())
+			: origin(origin), direction(direction), tMax(tMax) {}
+
+		Vector3 at(float t) const {
+			return origin + direction * t;
+		}
+
+		// the hit distance goes to t (0 when the origin is inside)
+		bool intersects(const AABB& box, float& t) const;
+
+		// either side of the triangle
+		bool intersects(const Vector3& v0, const Vector3& v1, const Vector3& v2, float& t) const;
+
+		// batch version of the above: t[i] is the hit distance of triangle (v0[i], v1[i], v2[i]) or +infinity.
+		// Returns the index of the closest hit, or -1
+		int intersects(const Vector3Stream& v0, const Vector3Stream& v1, const Vector3Stream& v2, float* t) const;
+
+		// the 7 floats the batch kernels read: origin, direction (or its inverse), tMax
+		void pack(float* out, bool inverseDirection) const;
+	};
+
+	static_assert(sizeof(Plane) == 4 * sizeof(float), "Frustum::data relies on packed planes");
+	static_assert(std::is_trivially_copyable<AABB>::value, "AABB must stay a plain value type");
+	static_assert(std::is_trivially_copyable<Sphere>::value, "Sphere must stay a plain value type");
+
+}
\ No newline at end of file
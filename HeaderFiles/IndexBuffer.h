@@ -3,6 +3,7 @@
 #include <GL/glew.h>
 #include <vector>
 #include "ErrorManager.h"
+#include "GLState.h"
 
 namespace avt {
 
@@ -14,7 +15,7 @@ namespace avt {
 	public:
 		IndexBuffer(const void* data, GLuint count) : _iboID(0), _count(data ? count : 0), _capacityCount(count) {
 			glGenBuffers(1, &_iboID);
-			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _iboID);
+			GLState::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, _iboID);
 			glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(GLuint), data, GL_STATIC_DRAW);
 
 #ifndef ERROR_CALLBACK
@@ -30,7 +31,8 @@ namespace avt {
 
 		~IndexBuffer() {
 			glDeleteBuffers(1, &_iboID);
-			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+			GLState::deleteBuffer(_iboID);
+			GLState::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 
 #ifndef ERROR_CALLBACK
 			ErrorManager::checkOpenGLError("ERROR: Could not destroy Index Buffer.");
@@ -44,7 +46,7 @@ namespace avt {
 				return;
 			}
 
-			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _iboID);
+			GLState::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, _iboID);
 			glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, count * sizeof(GLuint), data);
 			_count = count;
 
@@ -65,11 +67,11 @@ namespace avt {
 				// create aux buffer
 				GLuint auxID;
 				glGenBuffers(1, &auxID);
-				glBindBuffer(GL_COPY_WRITE_BUFFER, auxID);
+				GLState::bindBuffer(GL_COPY_WRITE_BUFFER, auxID);
 				glBufferData(GL_COPY_WRITE_BUFFER, _count * sizeof(GLuint), nullptr, GL_STATIC_DRAW);
 
 				// copy data to aux
-				glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _iboID);
+				GLState::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, _iboID);
 				glCopyBufferSubData(GL_ELEMENT_ARRAY_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, _count * sizeof(GLuint));
 
 				// re-allocate vb and copy data from aux
@@ -78,10 +80,11 @@ namespace avt {
 
 				// delete aux buffer
 				glDeleteBuffers(1, &auxID);
-				glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+				GLState::deleteBuffer(auxID);
+				GLState::bindBuffer(GL_COPY_WRITE_BUFFER, 0);
 			}
 			else {
-				glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _iboID);
+				GLState::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, _iboID);
 				glBufferData(GL_ELEMENT_ARRAY_BUFFER, capacityCount * sizeof(GLuint), nullptr, GL_STATIC_DRAW);
 				_count = 0;
 			}
@@ -97,11 +100,11 @@ namespace avt {
 		}
 
 		void bind() const {
-			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _iboID);
+			GLState::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, _iboID);
 		}
 
 		void unbind() const {
-			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+			GLState::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 		}
 
 		GLuint count() const {
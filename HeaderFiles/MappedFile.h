@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+
+namespace avt {
+
+	// Read-only view of a whole file mapped into memory, unmapped on close or destruction
+	class MappedFile {
+	private:
+		const uint8_t* _data = nullptr;
+		size_t _size = 0;
+#if defined(_WIN32)
+		void* _file = nullptr;
+		void* _mapping = nullptr;
+#else
+		int _fd = -1;
+#endif
+
+	public:
+		MappedFile() {}
+
+		explicit MappedFile(const std::string& path) {
+			open(path);
+		}
+
+		~MappedFile() {
+			close();
+		}
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		// false when the file is missing, empty or can't be mapped
+		bool open(const std::string& path);
+		void close();
+
+		bool isOpen() const {
+			return _data != nullptr;
+		}
+
+		const uint8_t* data() const {
+			return _data;
+		}
+
+		size_t size() const {
+			return _size;
+		}
+	};
+
+}
\ No newline at end of file
@@ -7,26 +7,12 @@ namespace avt {
 
 	class Mat2 : public Matrix<2> {
 	public:
-		Mat2()
+		constexpr Mat2()
 			: Matrix() {}
 
-		Mat2(std::initializer_list<float> vals)
+		constexpr Mat2(std::initializer_list<float> vals)
 			: Matrix(vals) {}
 
-		// copy constructor
-		Mat2(const Mat2& mat)
-			: Matrix(mat) {}
-
-		// move constructor
-		Mat2(Mat2&& mat) noexcept
-			: Matrix(std::move(mat)) {}
-
-		// copy assignment
-		Mat2& operator=(const Mat2& mat);
-
-		// move constructor
-		Mat2& operator=(Mat2&& mat) noexcept;
-
 		Mat2 operator+(const Mat2& mat) const;
 
 		Mat2 operator+() const;
@@ -73,8 +59,13 @@ namespace avt {
 
 		Mat2 inverted() const;
 
-		static Mat2 identity();
+		static constexpr Mat2 identity() {
+			return Mat2{ 1, 0, 0, 1 };
+		}
 
 	};
-}
 
+	static_assert(std::is_trivially_copyable<Mat2>::value, "Mat2 must stay a plain value type");
+	static_assert(alignof(Mat2) == 16, "Mat2 cells must be 16-byte aligned");
+
+}
@@ -8,29 +8,12 @@ namespace avt {
 
 	class Mat3 : public Matrix<3> {
 	public:
-		Mat3()
+		constexpr Mat3()
 			: Matrix() {}
 
-		Mat3(std::initializer_list<float> vals)
+		constexpr Mat3(std::initializer_list<float> vals)
 			: Matrix(vals) {}
 
-		// copy constructor
-		Mat3(const Mat3& mat)
-			: Matrix(mat) {}
-
-		// move constructor
-		Mat3(Mat3&& mat) noexcept
-			: Matrix(std::move(mat)) {}
-
-		// copy assignment
-		Mat3& operator=(const Mat3& mat);
-
-		// move constructor
-		Mat3& operator=(Mat3&& mat) noexcept;
-
-
-
-
 		Mat3 operator+(const Mat3& mat) const;
 
 		Mat3 operator+() const;
@@ -77,10 +60,15 @@ namespace avt {
 
 		Mat3 inverted() const;
 
-		static Mat3 identity();
+		static constexpr Mat3 identity() {
+			return Mat3{ 1, 0, 0, 0, 1, 0, 0, 0, 1 };
+		}
 
 		static Mat3 dual(Vector3 vec);
 
 	};
 
+	static_assert(std::is_trivially_copyable<Mat3>::value, "Mat3 must stay a plain value type");
+	static_assert(alignof(Mat3) == 16, "Mat3 cells must be 16-byte aligned");
+
 }
\ No newline at end of file
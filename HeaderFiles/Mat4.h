@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Matrix.h"
+#include "Mat3.h"
 #include "Vector4.h"
 #include "Vector3.h"
 
@@ -9,29 +10,12 @@ namespace avt {
 
 	class Mat4 : public Matrix<4> {
 	public:
-		Mat4()
+		constexpr Mat4()
 			: Matrix() {}
 
-		Mat4(std::initializer_list<float> vals)
+		constexpr Mat4(std::initializer_list<float> vals)
 			: Matrix(vals) {}
 
-		// copy constructor
-		Mat4(const Mat4& mat)
-			: Matrix(mat) {}
-
-		// move constructor
-		Mat4(Mat4&& mat) noexcept
-			: Matrix(std::move(mat)) {}
-
-		// copy assignment
-		Mat4& operator=(const Mat4& mat);
-
-		// move constructor
-		Mat4& operator=(Mat4&& mat) noexcept;
-
-
-
-
 		Mat4 operator+(const Mat4& mat) const;
 
 		Mat4 operator+() const;
@@ -72,11 +56,30 @@ namespace avt {
 
 		Mat4 T() const;
 
-		static Mat4 identity();
+		float det() const;
+
+		// leaves the matrix untouched when it is singular
+		Mat4& invert();
 
-		static Mat4 scale(Vector3 vec);
+		Mat4 inverted() const;
 
-		static Mat4 translation(Vector3 vec);
+		// inverse of a matrix whose bottom row is (0, 0, 0, 1), cheaper than the general inverse
+		Mat4 invertedAffine() const;
+
+		// inverse transpose of the upper 3x3, for transforming normals
+		Mat3 normalMatrix() const;
+
+		static constexpr Mat4 identity() {
+			return Mat4{ 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
+		}
+
+		static constexpr Mat4 scale(Vector3 vec) {
+			return Mat4{ vec.x, 0, 0, 0, 0, vec.y, 0, 0, 0, 0, vec.z, 0, 0, 0, 0, 1 };
+		}
+
+		static constexpr Mat4 translation(Vector3 vec) {
+			return Mat4{ 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, vec.x, vec.y, vec.z, 1 };
+		}
 
 		static Mat4 rotationX(float angle); //rads
 
@@ -85,4 +88,8 @@ namespace avt {
 		static Mat4 rotationZ(float angle); //rads
 	};
 
+	static_assert(std::is_trivially_copyable<Mat4>::value, "Mat4 must stay a plain value type");
+	static_assert(alignof(Mat4) == 16, "Mat4 cells must be 16-byte aligned");
+	static_assert(sizeof(Mat4) == 16 * sizeof(float), "Mat4 must match the column-major layout uploaded to GL");
+
 }
\ No newline at end of file
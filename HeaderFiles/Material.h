@@ -11,6 +11,7 @@ namespace avt {
 	private:
 		std::shared_ptr<Shader> _shader;
 		std::shared_ptr<Texture> _texture;
+		bool _blended = false;
 
 	public:
 		Material(const std::shared_ptr<Shader>& shader) : _shader(shader) {}
@@ -21,6 +22,15 @@ namespace avt {
 			return _shader;
 		}
 
+		// blends with what is behind it: drawn after the opaque objects, back to front, see RenderQueue
+		void setBlended(bool blended) {
+			_blended = blended;
+		}
+
+		bool blended() const {
+			return _blended;
+		}
+
 		void bind() const {
 			_shader->bind();
 		}
@@ -0,0 +1,182 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "FastMath.h"
+
+
+namespace avt {
+
+	enum class SimdLevel {
+		Scalar, SSE2, AVX2, NEON
+	};
+
+	// structure-of-arrays view of 3D vectors, element i is (x[i], y[i], z[i])
+	struct Vec3SoA {
+		float* x;
+		float* y;
+		float* z;
+
+		Vec3SoA from(size_t i) const {
+			return { x + i, y + i, z + i };
+		}
+	};
+
+	// structure-of-arrays view of quaternions, element i is (t[i], x[i], y[i], z[i])
+	struct QuatSoA {
+		float* t;
+		float* x;
+		float* y;
+		float* z;
+
+		QuatSoA from(size_t i) const {
+			return { t + i, x + i, y + i, z + i };
+		}
+	};
+
+	// Raw kernels behind the hot matrix operators. All matrices are column-major float[16].
+	// Every implementation performs the same multiplies and adds in the same order as the
+	// scalar one, so switching level never changes a single bit. That only holds while the
+	// compiler doesn't contract mul + add into FMA (MSVC /fp:precise, gcc/clang -ffp-contract=off).
+	struct KernelTable {
+		// out = a * b (out may alias a or b)
+		void (*mat4Mul)(const float* a, const float* b, float* out);
+
+		// out = m * v (v and out are 4 floats)
+		void (*mat4MulVec4)(const float* m, const float* v, float* out);
+
+		// out = transpose(m) (out may alias m)
+		void (*mat4Transpose)(const float* m, float* out);
+
+		// xyz = (m * (xyz, 1)).xyz for count points placed stride bytes apart
+		void (*mat4TransformPoints)(const float* m, float* xyz, size_t count, size_t stride);
+
+		// out = inverse(m), returns det(m); out is left untouched when the determinant is 0.
+		// Not covered by the bit-identity guarantee (last-bit differences between levels)
+		float (*mat4Inverse)(const float* m, float* out);
+
+		// batch Vector3 operations over count elements, same arithmetic as the Vector3 members.
+		// Outputs may alias inputs
+
+		// out[i] = a[i].dot(b[i])
+		void (*vec3Dot)(Vec3SoA a, Vec3SoA b, float* out, size_t count);
+
+		// out[i] = a[i].cross(b[i])
+		void (*vec3Cross)(Vec3SoA a, Vec3SoA b, Vec3SoA out, size_t count);
+
+		// out[i] = v[i].length()
+		void (*vec3Length)(Vec3SoA v, float* out, size_t count);
+
+		// v[i].normalize(), zero vectors are left as they are
+		void (*vec3Normalize)(Vec3SoA v, size_t count);
+
+		// v[i] = (m * (v[i], w)).xyz, w = 1 for points and 0 for directions
+		void (*vec3Transform)(const float* m, Vec3SoA v, size_t count, float w);
+
+		// component-wise min and max over count > 0 elements, written as 3 floats each
+		void (*vec3MinMax)(Vec3SoA v, size_t count, float* outMin, float* outMax);
+
+		// batch Quaternion operations over count elements. Outputs may alias inputs.
+		// k is read as k[i * kStride], a kStride of 0 shares one factor between all elements
+
+		// out[i] = a[i] * b[i], same arithmetic as Quaternion::operator*
+		void (*quatMul)(QuatSoA a, QuatSoA b, QuatSoA out, size_t count);
+
+		// out[i] = a[i].lerp(b[i], k), same arithmetic as Quaternion::lerp
+		void (*quatNlerp)(QuatSoA a, QuatSoA b, const float* k, size_t kStride, QuatSoA out, size_t count);
+
+		// shortest-arc slerp for k in [0, 1] with polynomial acos/sin, normalized.
+		// Identical across levels; within 1e-6 per component of Quaternion::slerp (when a . b >= 0)
+		void (*quatSlerp)(QuatSoA a, QuatSoA b, const float* k, size_t kStride, QuatSoA out, size_t count);
+
+		// 12 floats per element in the Affine layout (rotation columns, zero translation),
+		// same values as Affine::fromTRS({}, q, {1, 1, 1})
+		void (*quatToAffine)(QuatSoA q, float* out, size_t count);
+
+		// bounding volume tests. Boxes are center + half extent, planes are 6 (nx, ny, nz, d)
+		// quadruples with n . p + d >= 0 on the inner side. Rays are 7 floats:
+		// origin, direction (1 / direction for rayAABB) and the maximum distance
+
+		// out[i] = 0 when box i is fully behind one of the planes, 1 otherwise. Returns the number of 1s
+		size_t (*frustumAABB)(const float* planes, Vec3SoA center, Vec3SoA extent, uint8_t* out, size_t count);
+
+		// same for spheres
+		size_t (*frustumSphere)(const float* planes, Vec3SoA center, const float* radius, uint8_t* out, size_t count);
+
+		// slab test, out[i] = entry distance (0 when the origin is inside) or +infinity on a miss
+		void (*rayAABB)(const float* ray, Vec3SoA center, Vec3SoA extent, float* out, size_t count);
+
+		// Moller-Trumbore for triangles (v0[i], v1[i], v2[i]) seen from either side,
+		// out[i] = hit distance or +infinity on a miss
+		void (*rayTriangle)(const float* ray, Vec3SoA v0, Vec3SoA v1, Vec3SoA v2, float* out, size_t count);
+
+		// Arvo's method on center + extent: the box that bounds box i transformed by the Affine
+		// at m + i * mStride (a 0 stride shares one transform). Outputs may alias inputs
+		void (*aabbTransform)(const float* m, size_t mStride, Vec3SoA center, Vec3SoA extent, Vec3SoA outCenter, Vec3SoA outExtent, size_t count);
+
+		// transform hierarchy passes over packed arrays: Vector3 translations and scales (3 floats each),
+		// Quaternion rotations (t, x, y, z) and 12-float Affines
+
+		// out[i] = Affine::fromTRS(t[i], r[i], s[i]), same arithmetic
+		void (*affineFromTRS)(const float* t, const float* r, const float* s, float* out, size_t count);
+
+		// out[i] = parents[index[i]] * local[i], same arithmetic as Affine::operator*. out may alias local
+		void (*affineMulIndexed)(const float* parents, const uint32_t* index, const float* local, float* out, size_t count);
+	};
+
+	// Kernels compiled for each instruction set.
+	// Entries left as nullptr (or a nullptr table when the ISA isn't available for this target)
+	// fall back to the next level down, ending in the scalar implementation.
+	namespace kernels {
+		const KernelTable* scalar();
+		const KernelTable* sse2();
+		const KernelTable* avx2();
+		const KernelTable* neon();
+
+		// above this |a . b| the batch slerp falls back to nlerp. Its acos/sin are the
+		// precision::poly polynomials, evaluated in the same order by every level
+		constexpr float SLERP_NLERP_DOT = 0.9995f;
+
+		// rayTriangle treats |det| below this as a ray parallel to the triangle
+		constexpr float RAY_TRIANGLE_EPSILON = 1e-12f;
+	}
+
+	class MathKernels {
+	private:
+		static KernelTable build(SimdLevel level);
+
+		static KernelTable& table() {
+			static KernelTable t = build(detect());
+			return t;
+		}
+
+		static SimdLevel& current() {
+			static SimdLevel level = detect();
+			return level;
+		}
+
+		MathKernels() {}
+
+	public:
+
+		// best level supported by the running CPU (and OS)
+		static SimdLevel detect();
+
+		static bool supported(SimdLevel level);
+
+		static SimdLevel level() {
+			return current();
+		}
+
+		// forces a level (e.g. Scalar for comparisons); returns false if the CPU can't run it
+		static bool setLevel(SimdLevel level);
+
+		static const KernelTable& get() {
+			return table();
+		}
+
+		static const char* name(SimdLevel level);
+	};
+
+}
@@ -4,6 +4,9 @@
 #include <vector>
 #include <initializer_list>
 #include <array>
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
 
 
 namespace avt {
@@ -12,36 +15,25 @@ namespace avt {
 	class Matrix {
 	protected:
 		// values stored in column major for better performance
-		float* _cells;
+		// inline and 16-byte aligned so matrices are plain values (no heap, trivially copyable)
+		alignas(16) float _cells[N * N];
 		static const int SIZE = N;
 		static const int LEN = N * N;
 
-		Matrix()
-			: _cells(new float[LEN] {0}) {}
+		constexpr Matrix()
+			: _cells{} {}
 
-		Matrix(std::initializer_list<float> vals)
-			: _cells(new float[LEN] {0}) {
+		// plain loop instead of std::copy_n so constants can be built at compile time
+		constexpr Matrix(std::initializer_list<float> vals)
+			: _cells{} {
 			size_t n = LEN > vals.size() ? vals.size() : LEN;
-			std::copy_n(vals.begin(), n, _cells);
-		}
-
-		Matrix(const Matrix<N>& mat)
-			: _cells(new float[LEN]) {
-
-			std::copy_n(mat.data(), LEN, _cells);
-		}
-
-		Matrix(Matrix<N>&& mat) noexcept
-			: _cells(mat._cells) {
-			mat._cells = nullptr;
-		}
-
-		virtual ~Matrix() {
-			delete[] _cells;
+			for (size_t i = 0; i < n; i++) {
+				_cells[i] = vals.begin()[i];
+			}
 		}
 
 	public:
-		float operator[](int i) const {
+		constexpr float operator[](int i) const {
 			return _cells[i];
 		}
 
@@ -49,17 +41,21 @@ namespace avt {
 			return _cells[i];
 		}
 
-		float* data() const {
+		float* data() {
+			return _cells;
+		}
+
+		constexpr const float* data() const {
 			return _cells;
 		}
 
-		float* dataCopy() {
-			float* arr = new double[N * N];
+		float* dataCopy() const {
+			float* arr = new float[LEN];
 			std::copy_n(_cells, LEN, arr);
 			return arr;
 		}
 
-		float at(int row, int col) const {
+		constexpr float at(int row, int col) const {
 			return _cells[N * col + row];
 		}
 
@@ -69,10 +65,10 @@ namespace avt {
 
 		void clean() {
 			for (int i = 0; i < LEN; i++) {
-				if (fabs(_cells[i]) < 1.0e-5) _cells[i] = 0.0f;
+				if (std::fabs(_cells[i]) < 1.0e-5) _cells[i] = 0.0f;
 			}
 		}
 
 	};
 
-}
\ No newline at end of file
+}
@@ -6,6 +6,8 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <cstddef>
+#include <type_traits>
 
 #include <GL/glew.h>
 #include <memory>
@@ -25,6 +27,15 @@ namespace avt {
 		Vector3 color;
 	};
 
+	// Mesh::setup describes this struct to GL as VEC3 position, VEC2 texCoord, VEC3 normal, VEC3 color,
+	// tightly packed in that order, and uploads the vertex vector byte for byte
+	static_assert(std::is_trivially_copyable<Vertex>::value, "Vertex must stay memcpy-able");
+	static_assert(offsetof(Vertex, position) == 0, "Vertex layout must match Mesh::setup");
+	static_assert(offsetof(Vertex, tex) == 3 * sizeof(float), "Vertex layout must match Mesh::setup");
+	static_assert(offsetof(Vertex, normal) == 5 * sizeof(float), "Vertex layout must match Mesh::setup");
+	static_assert(offsetof(Vertex, color) == 8 * sizeof(float), "Vertex layout must match Mesh::setup");
+	static_assert(sizeof(Vertex) == 11 * sizeof(float), "Vertex layout must match Mesh::setup");
+
 	class Mesh {
 	private:
 
@@ -32,9 +43,12 @@ namespace avt {
 		std::shared_ptr<VertexBuffer> _vb;
 		std::shared_ptr<VertexArray> _va;
 
+		AABB _bounds;
 		bool _dirty = true;
+		bool _boundsDirty = true;
 		bool _autoUpdate = true;
 		int _vertexNum = 0;
+		unsigned _uploads = 0;
 
 	public:
 
@@ -48,18 +62,44 @@ namespace avt {
 			auto data = loadOBJ(filename, baseColor);
 			_meshData.insert(_meshData.end(), data.begin(), data.end());
 			_dirty = true;
+			_boundsDirty = true;
 		}
 
 		void addFace(const Vertex& v1, const Vertex& v2, const Vertex& v3, bool computeFaceNormal = false);
 
+		// triangle list, 3 vertices per face
+		void addVertices(const std::vector<Vertex>& vertices) {
+			_meshData.insert(_meshData.end(), vertices.begin(), vertices.end());
+			_dirty = true;
+			_boundsDirty = true;
+		}
+
 		//  must be called before the first draw
 		void setup();
 
 		// call only after setup
 		void updateBufferData();
 
+		// empty after clearLocalData
+		const std::vector<Vertex>& data() const {
+			return _meshData;
+		}
+
+		// of the vertex positions, cached until they change. Kept by clearLocalData
+		const AABB& bounds() {
+			if (_boundsDirty) {
+				_bounds = AABB();
+				for (auto& v : _meshData) {
+					_bounds.expand(v.position);
+				}
+				_boundsDirty = false;
+			}
+			return _bounds;
+		}
+
 		// saves memory if the mesh won't be modified again
 		void clearLocalData() {
+			bounds();
 			_meshData.clear();
 		}
 
@@ -79,6 +119,11 @@ namespace avt {
 			return _vertexNum;
 		}
 
+		// times the vertex buffer was filled, copies of it (see MeshArena) are stale once it changes
+		unsigned uploads() const {
+			return _uploads;
+		}
+
 		void setAutoBufferUpdate(bool autoUpdate) {
 			_autoUpdate = autoUpdate;
 		}
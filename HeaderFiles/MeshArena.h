@@ -0,0 +1,81 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "VertexArray.h"
+#include "VertexBuffer.h"
+
+
+namespace avt {
+
+	class Mesh;
+
+	// The vertices of many meshes in one vertex buffer behind one vertex array, so draws of different
+	// meshes need no rebind and can go out together in one multi-draw. Every Mesh has the Vertex
+	// layout, so one arena holds them all. A mesh is copied in from its own buffer, on the gpu, when
+	// first placed and again after it uploads new vertices; one that outgrew its range moves to the
+	// end and leaves a hole until clear. Meshes are known by address, clear after destroying placed ones.
+	// Besides the vertex attributes the vertex array feeds a per-instance int at OBJECT_INDEX counting
+	// up from the draw's base instance, the draw's index into a per-object buffer
+	class MeshArena {
+	public:
+		static const GLuint OBJECT_INDEX = 4; // after the four Vertex attributes
+
+		struct Range {
+			GLint first = 0; // vertex
+			GLsizei count = 0;
+		};
+
+		// an entry of the per-object buffer the indices point into, std430 layout
+		struct Object {
+			float model[16];
+			GLuint material;
+			GLuint pad[3];
+		};
+
+	private:
+		struct Entry {
+			Range range;
+			GLsizei capacity; // vertices the range may grow to in place
+			unsigned uploads; // of the mesh when copied
+		};
+
+		std::shared_ptr<VertexBuffer> _vertices;
+		std::shared_ptr<VertexBuffer> _objectIndices; // 0, 1, 2, ...
+		std::shared_ptr<VertexArray> _va;
+		std::unordered_map<const Mesh*, Entry> _entries;
+		GLsizei _used = 0; // vertices, holes included
+
+		void create(const VertexBuffer& meshVertices);
+		void reserve(GLsizei vertices);
+
+	public:
+		MeshArena() = default;
+
+		MeshArena(const MeshArena&) = delete;
+		MeshArena& operator=(const MeshArena&) = delete;
+
+		// where the mesh's vertices are, copying them in when new or changed.
+		// Empty for a mesh that wasn't set up
+		Range place(const Mesh& mesh);
+
+		// object indices [0, count) readable by instances
+		void reserveObjects(GLsizei count);
+
+		// forgets every mesh, the buffers keep their capacity
+		void clear();
+
+		// nullptr before the first place
+		const std::shared_ptr<VertexArray>& va() const {
+			return _va;
+		}
+
+		GLsizei size() const {
+			return _used;
+		}
+	};
+
+}
\ No newline at end of file
@@ -1,11 +1,16 @@
 #pragma once
 
 #include "avt_math.h"
+#include "FastMath.h"
 
 
 namespace avt {
 
-	class Perlin {
+	// P is the precision policy of the gradient hash. Exact by default: the hash feeds sin and cos
+	// arguments around 1e7 to 1e12, far past where Fast's range reduction holds, and with Fast most
+	// cells end up with the same few gradients
+	template<typename P = precision::Exact>
+	class PerlinNoise {
 	private:
 
 		static float interpolate(float a0, float a1, float w) {
@@ -15,8 +20,8 @@ namespace avt {
 
 		static Vector2 randomGradient(int ix, int iy) {
 			// Random float. No precomputed gradients mean this works for any number of grid coordinates
-			float random = 2920.f * sin(ix * 21942.f + iy * 171324.f + 8912.f) * cos(ix * 23157.f * iy * 217832.f + 9758.f);
-			Vector2 vec = { cos(random) , sin(random) };
+			float random = 2920.f * P::sin(ix * 21942.f + iy * 171324.f + 8912.f) * P::cos(ix * 23157.f * iy * 217832.f + 9758.f);
+			Vector2 vec = { P::cos(random) , P::sin(random) };
 			return vec;
 		}
 
@@ -67,4 +72,6 @@ namespace avt {
 
 	};
 
+	using Perlin = PerlinNoise<>;
+
 }
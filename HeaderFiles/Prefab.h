@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "Affine.h"
+#include "Geometry.h"
+
+
+namespace avt {
+
+	class Renderable;
+	class SceneNode;
+	struct PrefabOverrides;
+
+	// A model made of several renderables (trunk, leaves...) kept once and placed many times. The
+	// subtree is flattened into parts with transforms relative to the prefab's origin and never changes
+	// after construction. A placement is a SceneNode referencing it (SceneNode::setPrefab): one
+	// transform and an optional PrefabOverrides instead of a copy of the subtree, the parts are
+	// expanded where the node is drawn
+	class Prefab {
+	public:
+		struct Part {
+			Affine transform; // relative to the prefab's origin
+			std::shared_ptr<Renderable> rend;
+			AABB bounds; // of the mesh through transform, empty when the mesh has none
+		};
+
+	private:
+		std::vector<Part> _parts;
+		AABB _bounds;
+		bool _bounded = true;
+
+	public:
+		explicit Prefab(const std::vector<std::pair<Affine, std::shared_ptr<Renderable>>>& parts);
+
+		// every renderable in root's subtree, root's own transform left out (the placement gives it)
+		static std::shared_ptr<const Prefab> fromNode(const SceneNode* root);
+
+		const std::vector<Part>& parts() const {
+			return _parts;
+		}
+
+		// union of the parts'
+		const AABB& bounds() const {
+			return _bounds;
+		}
+
+		// false when a part's mesh has no bounds to go by, bounds() then leaves it out
+		bool bounded() const {
+			return _bounded;
+		}
+
+		// visit(part, rend, world) for each part the overrides (may be nullptr) don't hide,
+		// rend being the renderable this instance draws for it
+		template<typename F>
+		void expand(const Affine& world, const PrefabOverrides* overrides, F visit) const;
+	};
+
+	// what one instance draws differently, shareable by many instances. A replacement is culled with
+	// the part's bounds, so it should fit them (another material, a lower detail mesh)
+	struct PrefabOverrides {
+		// part index and the renderable drawn in its place, nullptr hides the part
+		std::vector<std::pair<uint32_t, std::shared_ptr<Renderable>>> parts;
+
+		const std::shared_ptr<Renderable>& renderable(const Prefab& prefab, uint32_t part) const {
+			for (auto& p : parts) {
+				if (p.first == part) return p.second;
+			}
+			return prefab.parts()[part].rend;
+		}
+	};
+
+	template<typename F>
+	void Prefab::expand(const Affine& world, const PrefabOverrides* overrides, F visit) const {
+		for (uint32_t i = 0; i < _parts.size(); i++) {
+			const std::shared_ptr<Renderable>& rend = overrides ? overrides->renderable(*this, i) : _parts[i].rend;
+			if (rend) visit(_parts[i], rend, world * _parts[i].transform);
+		}
+	}
+
+}
\ No newline at end of file
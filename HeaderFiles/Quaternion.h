@@ -1,6 +1,7 @@
 #pragma once
 
 #include <iostream>
+#include <type_traits>
 
 
 namespace avt {
@@ -16,14 +17,11 @@ namespace avt {
 	public:
 		float t, x, y, z;
 
-		Quaternion(float t=0, float x=0, float y=0, float z=0) 
+		constexpr Quaternion(float t=0, float x=0, float y=0, float z=0) 
 			: t(t), x(x), y(y), z(z) {}
 
 		Quaternion(Vector3 axis, float rad);
 
-		~Quaternion() {}
-
-
 		Vector3 getAxis() const;
 
 		float getAngle() const;
@@ -86,4 +84,7 @@ namespace avt {
 		}
 	};
 
+	static_assert(std::is_trivially_copyable<Quaternion>::value, "Quaternion must stay a plain value type");
+	static_assert(sizeof(Quaternion) == 4 * sizeof(float), "Quaternion must be four packed floats (t, x, y, z)");
+
 }
\ No newline at end of file
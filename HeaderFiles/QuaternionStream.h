@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstddef>
+
+#include "Quaternion.h"
+#include "MathKernels.h"
+#include "SoAStorage.h"
+
+
+namespace avt {
+
+	class Affine;
+
+	// Structure-of-arrays storage for many Quaternions (separate t, x, y and z arrays, see SoAStorage)
+	// with batch versions of the per-frame animation operations.
+	// multiply and nlerp match the Quaternion members bit for bit. slerp takes the shortest arc
+	// (Quaternion::slerp does not) and uses polynomial acos/sin: within 1e-6 per component of
+	// Quaternion::slerp when a . b >= 0, for k in [0, 1].
+	class QuaternionStream {
+	private:
+		SoAStorage<4> _data;
+
+	public:
+		QuaternionStream() {}
+
+		explicit QuaternionStream(size_t size) {
+			_data.resize(size);
+		}
+
+		size_t size() const {
+			return _data.size();
+		}
+
+		size_t capacity() const {
+			return _data.capacity();
+		}
+
+		bool empty() const {
+			return _data.size() == 0;
+		}
+
+		// keeps the current elements, new ones are zero
+		void resize(size_t size) {
+			_data.resize(size);
+		}
+
+		void reserve(size_t capacity) {
+			_data.reserve(capacity);
+		}
+
+		void clear() {
+			_data.clear();
+		}
+
+		void push_back(const Quaternion& q) {
+			set(_data.grow(), q);
+		}
+
+		Quaternion operator[](size_t i) const {
+			return Quaternion(_data[0][i], _data[1][i], _data[2][i], _data[3][i]);
+		}
+
+		void set(size_t i, const Quaternion& q) {
+			_data[0][i] = q.t;
+			_data[1][i] = q.x;
+			_data[2][i] = q.y;
+			_data[3][i] = q.z;
+		}
+
+		float* t() { return _data[0]; }
+		float* x() { return _data[1]; }
+		float* y() { return _data[2]; }
+		float* z() { return _data[3]; }
+		const float* t() const { return _data[0]; }
+		const float* x() const { return _data[1]; }
+		const float* y() const { return _data[2]; }
+		const float* z() const { return _data[3]; }
+
+		// kernels take mutable pointers, const methods only pass this to read-only inputs
+		QuatSoA view() const {
+			return { const_cast<float*>(_data[0]), const_cast<float*>(_data[1]),
+				const_cast<float*>(_data[2]), const_cast<float*>(_data[3]) };
+		}
+
+		// out[i] = a[i] * b[i]; out is resized and may be a or b
+		static void multiply(const QuaternionStream& a, const QuaternionStream& b, QuaternionStream& out);
+
+		// out[i] = a[i].lerp(b[i], k)
+		static void nlerp(const QuaternionStream& a, const QuaternionStream& b, float k, QuaternionStream& out);
+
+		// per-element factors, k holds one float per element
+		static void nlerp(const QuaternionStream& a, const QuaternionStream& b, const float* k, QuaternionStream& out);
+
+		static void slerp(const QuaternionStream& a, const QuaternionStream& b, float k, QuaternionStream& out);
+
+		static void slerp(const QuaternionStream& a, const QuaternionStream& b, const float* k, QuaternionStream& out);
+
+		// one rotation-only Affine per element, out holds size() transforms
+		void toAffine(Affine* out) const;
+	};
+
+}
\ No newline at end of file
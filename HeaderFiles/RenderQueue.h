@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Affine.h"
+#include "Renderable.h"
+#include "Vector3.h"
+
+
+namespace avt {
+
+	class Material;
+	class Mesh;
+	class Shader;
+
+	// One frame's draws as plain records, each with a 64-bit sort key, ordered by a radix sort so
+	// the draw loop only binds what differs from the previous draw. From the top bits down the key is
+	// pass (4) | shader (12) | material (16) | mesh (16) | depth (16):
+	// ids are handed out per frame in order of first use, depth grows with the distance to the eye so
+	// copies of a mesh go front to back. Blended materials go to the last pass whatever pass they are
+	// submitted in, keyed pass (4) | far-to-near depth (28) | material (16) | mesh (16) so they are
+	// drawn back to front over everything opaque. Records hold raw pointers (the scene keeps the
+	// objects alive through the frame) and the buffers keep their capacity, a warm frame allocates nothing
+	class RenderQueue {
+	public:
+		static const unsigned PASSES = 16;
+		static const unsigned BLENDED = PASSES - 1; // the pass of blended materials
+
+		struct Item {
+			Affine world;
+			Mesh* mesh;
+			Material* material;
+			Shader* shader;
+			DrawMode mode;
+		};
+
+	private:
+		struct Entry {
+			uint64_t key;
+			uint32_t item;
+		};
+
+		std::vector<Item> _items;
+		std::vector<Entry> _order, _scratch;
+
+		// per-frame ids of shaders, materials and meshes, open addressing on the pointer
+		std::vector<const void*> _idKeys;
+		std::vector<uint16_t> _idValues;
+		size_t _idCount = 0;
+		uint32_t _nextId[3] = {};
+
+		Vector3 _eye;
+		bool _updateMeshes = true;
+
+		uint32_t id(const void* object, int kind);
+		void push(const Item& item, unsigned pass);
+
+	public:
+		RenderQueue() = default;
+
+		RenderQueue(const RenderQueue&) = delete;
+		RenderQueue& operator=(const RenderQueue&) = delete;
+
+		// empties the queue for a frame seen from eye
+		void begin(const Vector3& eye);
+
+		// sets the mesh's buffers up when it updates them itself, see setMeshUpdates. False, and nothing queued, when
+		// the renderable can't be drawn (no vertex array, material or shader). Passes from BLENDED on are
+		// for blended materials, an opaque one submitted there goes to the pass before
+		bool submit(const Renderable& rend, const Affine& world, unsigned pass = 0);
+
+		// other's items from begin on, in their passes, keyed with this queue's ids
+		void append(const RenderQueue& other, size_t begin = 0);
+
+		// off for a queue filled away from the GL thread: meshes are queued as they are, one not set up
+		// yet only when it updates itself, for whoever draws it to set it up
+		void setMeshUpdates(bool update) {
+			_updateMeshes = update;
+		}
+
+		// by key, stable for equal keys
+		void sort();
+
+		size_t size() const {
+			return _order.size();
+		}
+
+		// in key order once sorted, in submission order before
+		const Item& operator[](size_t i) const {
+			return _items[_order[i].item];
+		}
+
+		uint64_t key(size_t i) const {
+			return _order[i].key;
+		}
+
+		unsigned pass(size_t i) const {
+			return static_cast<unsigned>(_order[i].key >> 60);
+		}
+
+		// the frame's id of the material, in order of first use
+		uint32_t materialId(size_t i) const {
+			return (_order[i].key >> (pass(i) == BLENDED ? 16 : 32)) & 0xffff;
+		}
+
+		// the first blended item once sorted, size() when there are none
+		size_t blendedBegin() const;
+	};
+
+}
\ No newline at end of file
@@ -1,17 +1,27 @@
 #pragma once
 
 #include <GL/glew.h>
-#include <unordered_map>
+#include <memory>
+#include <utility>
 #include <vector>
 #include "Renderable.h"
+#include "MeshArena.h"
+#include "RenderQueue.h"
+#include "CommandBuffer.h"
+#include "GLCommandBackend.h"
+#include "StorageBuffer.h"
+#include "VertexBuffer.h"
+#include "Mat4.h"
 
 namespace avt {
 
 	class Camera;
+	class Frustum;
 	class Scene;
 	class Shader;
 	class SceneNode;
-	class Mat4;
+	class Affine;
+	class TaskSystem;
 
 	static inline GLenum getGLdrawMode(DrawMode mode) {
 		switch (mode) {
@@ -26,29 +36,75 @@ namespace avt {
 		}
 	}
 
+	enum class RenderPath {
+		Queue, // collected into a RenderQueue, sorted, then drawn binding only what changes
+		Immediate, // drawn during the traversal, every bind and unbind per object
+		Recorded // culled and recorded into command buffers on the task system's threads, replayed here
+	};
+
 	class Renderer {
 	private:
 
 		bool _autoClear = true;
 		bool _clearStencil = true;
 
-		Camera* _activeCam = nullptr;
-		std::unordered_map<std::shared_ptr<Material>, std::unordered_map<std::shared_ptr<Mesh>, std::vector<Mat4>>> _subs;
-
-		void begin(Camera* camera);
-		void end();
-		void traverse(SceneNode* node, bool dirty);
-		void submit(const std::shared_ptr<Renderable>& rend, const Mat4& worldMatrix);
-		void draw();
-
-		void drawNode(SceneNode* node, bool dirty);
-		void drawRenderable(const std::shared_ptr<Renderable>& rend, const Mat4& worldMatrix);
+		RenderPath _path = RenderPath::Queue;
+		TaskSystem* _tasks = nullptr;
+		Mat4 _lightSpace = Mat4::identity();
+		RenderQueue _queue;
+
+		// model matrices of the instanced draws, made on first use
+		std::unique_ptr<VertexBuffer> _instances;
+		std::vector<float> _instanceData;
+
+		// as glMultiDrawArraysIndirect reads it
+		struct DrawCommand {
+			GLuint count;
+			GLuint instanceCount;
+			GLuint first;
+			GLuint baseInstance;
+		};
+
+		// the queue items [begin, end) of one material and draw mode, drawn by commands [command, command + commands)
+		struct IndirectBatch {
+			size_t begin, end;
+			size_t command, commands;
+		};
+
+		MeshArena _arena;
+		std::unique_ptr<StorageBuffer> _objects, _commands; // made on first use
+		std::vector<MeshArena::Object> _objectData; // of shaders with an object buffer
+		std::vector<DrawCommand> _commandData;
+		std::vector<IndirectBatch> _batches;
+
+		// one queue and command buffer per share of the recorded path's subtrees, see record
+		struct RecordSlot {
+			RenderQueue queue;
+			CommandBuffer commands;
+		};
+
+		std::vector<std::unique_ptr<RecordSlot>> _slots;
+		size_t _recorded = 0; // slots filled by the last record
+		std::vector<std::pair<SceneNode*, bool>> _roots, _nextRoots; // subtrees to share out, fully in view or not
+		GLCommandBackend _backend{ _arena };
+
+		void drawNode(SceneNode* root, const Frustum& frustum);
+		void drawStatic(const Scene& scene, const Frustum& frustum);
+		void drawRenderable(const std::shared_ptr<Renderable>& rend, const Affine& worldMatrix);
+
+		void collect(const Scene& scene, const Frustum& frustum);
+		void drawQueue();
+		void uploadInstances(const float* matrices, size_t count);
+		void buildIndirect();
+		void uploadObjects();
+
+		void record(const Scene& scene, const Frustum& frustum, const Vector3& eye);
 
 	public:
 		Renderer() {}
 		~Renderer() {}
 
-		void draw(const Scene& scene, Camera* camera);
+		void draw(Scene& scene, Camera* camera);
 
 
 		void clear() const;
@@ -60,6 +116,32 @@ namespace avt {
 		void setStencilClear(bool clear = true) {
 			_clearStencil = clear;
 		}
+
+		void setRenderPath(RenderPath path) {
+			_path = path;
+		}
+
+		RenderPath renderPath() const {
+			return _path;
+		}
+
+		// threads for the transform update at the start of draw and for recording on the recorded
+		// path, nullptr runs both on the calling thread
+		void setTaskSystem(TaskSystem* tasks) {
+			_tasks = tasks;
+		}
+
+		// vertices of the meshes drawn through an object buffer, to clear after destroying such meshes
+		MeshArena& meshArena() {
+			return _arena;
+		}
+
+		// light projection * light view: uploaded as is to shaders with useLightViewProj, times each
+		// model matrix to shaders with useLightSpaceMatrix
+		void setLightSpace(const Mat4& lightViewProj) {
+			_lightSpace = lightViewProj;
+			_backend.setLightSpace(lightViewProj);
+		}
 	};
 
 }
\ No newline at end of file
@@ -1,22 +1,39 @@
 #pragma once
 
+#include "EntityRegistry.h"
+#include "SceneBounds.h"
+#include "SceneFile.h"
 #include "SceneNode.h"
+#include "SceneNodePool.h"
+#include "StaticBatch.h"
+#include "TransformHierarchy.h"
 
 namespace avt {
 
 	class Scene {
 	private:
+		TransformHierarchy _transforms;
+		EntityRegistry _components;
+		SceneBounds _bounds;
+		SceneNodePool _pool; // after the storage above, nodes still reach it while the pool is destroyed
 		SceneNode*_root;
+		StaticBatch _static;
 	public:
-		Scene() : _root(new SceneNode()) {}
-		~Scene() {
-			delete _root;
+		Scene() : _bounds(_components), _root(_pool.create(&_transforms, &_components, nullptr, nullptr)) {
+			_root->_bounds = &_bounds;
 		}
 
+		Scene(const Scene&) = delete;
+		Scene& operator=(const Scene&) = delete;
+
 		SceneNode* createNode(const std::shared_ptr<Renderable>& rend = nullptr) {
 			return _root->createNode(rend);
 		}
 
+		SceneNode* createInstance(const std::shared_ptr<const Prefab>& prefab, const std::shared_ptr<const PrefabOverrides>& overrides = nullptr) {
+			return _root->createInstance(prefab, overrides);
+		}
+
 		SceneNode* getRoot() const {
 			return _root;
 		}
@@ -25,6 +42,79 @@ namespace avt {
 			return _root->addNode(node);
 		}
 
+		// destroys every node in one pass over the pool, without walking the tree. The root comes
+		// back empty with an identity transform, handles taken before are stale. StencilPicker
+		// targets among the nodes have to go first (StencilPicker::removeTargetsIn)
+		void clear() {
+			_static.clear();
+			_pool.clear();
+			_transforms.clear();
+			_components.clear();
+			_bounds.clear();
+			_root = _pool.create(&_transforms, &_components, nullptr, nullptr);
+			_root->_bounds = &_bounds;
+		}
+
+		NodeHandle handle(const SceneNode* node) const {
+			return _pool.handle(node);
+		}
+
+		// nullptr once the node has been deleted
+		SceneNode* get(NodeHandle handle) const {
+			return _pool.get(handle);
+		}
+
+		size_t nodeCount() const {
+			return _pool.size();
+		}
+
+		// see SceneFile
+		SceneFileStatus save(const std::string& path, const SceneAssets& assets) const {
+			return SceneFile::save(path, *this, assets);
+		}
+
+		SceneFileStatus load(const std::string& path, const SceneAssets& assets) {
+			return SceneFile::load(path, *this, assets);
+		}
+
+		// world matrices of every node whose transform (or an ancestor's) changed since the last call,
+		// spread over tasks when given, then the bounds of those nodes and of the subtrees above them
+		void updateTransforms(TaskSystem* tasks = nullptr) {
+			_transforms.update(tasks);
+			_bounds.update(_transforms);
+			_root->refreshSubtreeBounds();
+		}
+
+		// merges the renderables under nodes marked with SceneNode::setStatic, see StaticBatch.
+		// Call again after changing any of them
+		void bakeStatic(float chunkSize = StaticBatch::CHUNK_SIZE) {
+			updateTransforms();
+			_static.bake(_root, chunkSize);
+		}
+
+		// back to drawing every node on its own
+		void clearStatic() {
+			_static.clear();
+		}
+
+		const StaticBatch& staticBatch() const {
+			return _static;
+		}
+
+		// world bounds of the nodes with a renderable or prefab, for frustum, ray and overlap queries
+		const SceneBounds& bounds() const {
+			return _bounds;
+		}
+
+		TransformHierarchy& transforms() {
+			return _transforms;
+		}
+
+		// renderable, bounds and picking components of the nodes, keyed by transform id
+		const EntityRegistry& components() const {
+			return _components;
+		}
+
 	};
 
 }
\ No newline at end of file
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "DynamicBVH.h"
+#include "EntityRegistry.h"
+#include "TransformHierarchy.h"
+
+namespace avt {
+
+	class SceneNode;
+
+	// World bounds of the nodes of a Scene that have a renderable or prefab, kept in a DynamicBVH: the
+	// mesh's (and prefab's) box through the node's world matrix. Nodes register when they get one and
+	// leave when they lose it or are destroyed. update only revisits the nodes whose world matrix the last
+	// TransformHierarchy::update recomputed, so a still scene costs nothing.
+	// The boxes are also kept as the WorldBounds components of the scene's EntityRegistry
+	class SceneBounds {
+	private:
+		// per transform id
+		struct Entry {
+			SceneNode* node = nullptr;
+			DynamicBVH::Proxy proxy = DynamicBVH::NONE;
+			bool queued = false;
+		};
+
+		EntityRegistry& _components;
+		DynamicBVH _bvh;
+		std::vector<Entry> _entries;
+		std::vector<TransformHierarchy::Id> _queued; // registered since the last update
+
+		static bool worldBounds(SceneNode* node, AABB& box);
+
+	public:
+		SceneBounds(EntityRegistry& components) : _components(components) {}
+
+		SceneBounds(const SceneBounds&) = delete;
+		SceneBounds& operator=(const SceneBounds&) = delete;
+
+		// the node's renderable or prefab changed, it takes its place on the next update
+		void add(SceneNode* node);
+
+		void remove(TransformHierarchy::Id id);
+
+		void clear();
+
+		// after transforms.update: places the nodes added since, moves the ones it recomputed
+		// and refits the tree
+		void update(const TransformHierarchy& transforms);
+
+		const DynamicBVH& bvh() const {
+			return _bvh;
+		}
+
+		// as of the last update
+
+		// visit(node) for the nodes whose bounds overlap box
+		template<typename F>
+		void query(const AABB& box, F visit) const {
+			_bvh.query(box, [&](uint32_t id) { visit(_entries[id].node); });
+		}
+
+		// visit(node) for the nodes whose bounds may be inside the frustum
+		template<typename F>
+		void query(const Frustum& frustum, F visit) const {
+			_bvh.query(frustum, [&](uint32_t id) { visit(_entries[id].node); });
+		}
+
+		// the node whose bounds the ray enters first, t is where. nullptr when it misses them all
+		SceneNode* raycast(const Ray& ray, float& t) const;
+	};
+
+}
\ No newline at end of file
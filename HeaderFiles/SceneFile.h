@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+namespace avt {
+
+	class Scene;
+	class Mesh;
+	class Material;
+	class Prefab;
+
+	// Meshes, materials and prefabs a scene file refers to, by 64-bit content hash.
+	// A level has few enough of them for plain lists
+	class SceneAssets {
+	private:
+		std::vector<std::pair<uint64_t, std::shared_ptr<Mesh>>> _meshes;
+		std::vector<std::pair<uint64_t, std::shared_ptr<Material>>> _materials;
+		std::vector<std::pair<uint64_t, std::shared_ptr<const Prefab>>> _prefabs;
+
+	public:
+		// FNV-1a
+		static uint64_t hash(const void* data, size_t size);
+
+		// keyed by the hash of its vertex data, so it needs the local data (before clearLocalData)
+		uint64_t add(const std::shared_ptr<Mesh>& mesh);
+
+		// a material holds nothing of its own to hash, key names what makes it unique (shader files, textures...)
+		uint64_t add(const std::shared_ptr<Material>& material, const std::string& key);
+
+		// keyed by name like materials
+		uint64_t add(const std::shared_ptr<const Prefab>& prefab, const std::string& key);
+
+		// nullptr when unknown
+		std::shared_ptr<Mesh> mesh(uint64_t hash) const;
+		std::shared_ptr<Material> material(uint64_t hash) const;
+		std::shared_ptr<const Prefab> prefab(uint64_t hash) const;
+
+		// false when the asset was never added
+		bool hashOf(const Mesh* mesh, uint64_t& hash) const;
+		bool hashOf(const Material* material, uint64_t& hash) const;
+		bool hashOf(const Prefab* prefab, uint64_t& hash) const;
+	};
+
+	enum class SceneFileStatus {
+		Ok, CannotOpen, BadFormat, MissingAsset
+	};
+
+	// Binary scene: a header, the distinct renderables as (mesh hash, material hash), the prefab hashes,
+	// every node as a fixed-size record in breadth-first order (parents first), then the picking aliases.
+	// Little-endian, read in place from a memory-mapped file.
+	namespace SceneFile {
+
+		const uint32_t VERSION = 3;
+		const uint32_t NONE = 0xffffffffu;
+
+		// NodeEntry::flags
+		const uint32_t STATIC = 1; // SceneNode::setStatic
+
+		struct Header {
+			char magic[4]; // "LSCN"
+			uint32_t version;
+			uint32_t nodeCount;
+			uint32_t renderableCount;
+			uint32_t stringBytes;
+			uint32_t prefabCount; // uint64_t hashes after the renderables
+		};
+
+		struct RenderableEntry {
+			uint64_t mesh;
+			uint64_t material;
+		};
+
+		struct NodeEntry {
+			uint32_t parent; // index of an earlier node, NONE for the first one, the scene root
+			uint32_t childCount;
+			uint32_t renderable; // index into the renderables, NONE for none
+			uint32_t pickAlias; // offset of a null-terminated alias in the strings, NONE when not a picking target
+			uint32_t flags;
+			uint32_t prefab; // index into the prefabs, NONE for none
+			float translation[3];
+			float rotation[4]; // t, x, y, z
+			float scale[3];
+		};
+
+		static_assert(sizeof(Header) == 24 && sizeof(RenderableEntry) == 16 && sizeof(NodeEntry) == 64, "scene file records must stay packed");
+
+		// every renderable must be a RenderMesh whose mesh and material are in assets, every prefab
+		// must be in assets and placed without overrides
+		SceneFileStatus save(const std::string& path, const Scene& scene, const SceneAssets& assets);
+
+		// replaces the scene's nodes in one pass over the mapped file. Nodes come from the scene's pool,
+		// each renderable entry becomes one RenderMesh shared by its nodes, aliased nodes become
+		// StencilPicker targets, static subtrees are baked (Scene::bakeStatic). A bad header or an
+		// unknown asset leaves the scene untouched, a bad node record leaves it empty
+		SceneFileStatus load(const std::string& path, Scene& scene, const SceneAssets& assets);
+	}
+
+}
\ No newline at end of file
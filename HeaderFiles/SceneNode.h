@@ -3,27 +3,82 @@
 #include <vector>
 #include <memory>
 #include "avt_math.h"
+#include "EntityRegistry.h"
+#include "TransformHierarchy.h"
 
 namespace avt {
+	class Prefab;
 	class Renderable;
 	class Shader;
+	class Scene;
+	class SceneBounds;
+	class SceneNodePool;
+	class StaticBatch;
+
+	// pool slot and generation of a node created by a Scene, see Scene::get
+	struct NodeHandle {
+		uint32_t index = 0xffffffffu;
+		uint32_t generation = 0;
+	};
 
+	// Handle onto a node of a TransformHierarchy plus the tree links. The renderable, prefab and stencil
+	// index are components in the EntityRegistry paired with that hierarchy, keyed by the transform id.
+	// Nodes created by a Scene (or under one of its nodes) share the scene's hierarchy and live
+	// in its pool, they are destroyed through deleteNode / deleteAll, never with delete.
+	// A node constructed on its own keeps a hierarchy and registry of its own until it is added somewhere.
 	class SceneNode {
 	private:
 		SceneNode* _parent;
-		std::vector<SceneNode*> _nodes;
+		std::vector<SceneNode*> _nodes; // in no particular order, removal swaps the last child in
+		uint32_t _childIndex = 0; // position in the parent's _nodes
+
+		SceneNodePool* _pool = nullptr; // nullptr for nodes allocated with new
+		uint32_t _poolIndex = 0;
+		SceneBounds* _bounds; // of the scene the node is in, nullptr outside one
+
+		std::unique_ptr<TransformHierarchy> _ownTransforms;
+		TransformHierarchy* _transforms;
+		TransformHierarchy::Id _id;
+
+		std::unique_ptr<EntityRegistry> _ownComponents;
+		EntityRegistry* _components;
+
+		bool _static = false; // with the subtree, see StaticBatch
+		StaticBatch* _batch = nullptr; // the batch whose chunk draws the renderable
+		uint32_t _batchIndex = 0; // in that batch's nodes
+
+		// union of the world bounds in the subtree. A dirty node's ancestors are all dirty,
+		// so marking stops at the first one that already is
+		AABB _subtreeBounds;
+		bool _subtreeDirty = false;
 
-		std::shared_ptr<Renderable> _rend;
+		friend class Scene;
+		friend class SceneBounds;
+		friend class SceneNodePool;
+		friend class StaticBatch;
 
-		bool _dirty = false;
-		Mat4 _localTranform;
-		Mat4 _worldTransform = Mat4::identity();
+		void markSubtreeDirty() {
+			for (SceneNode* node = this; node && !node->_subtreeDirty; node = node->_parent) {
+				node->_subtreeDirty = true;
+			}
+		}
+
+		// recomputes the dirty nodes of the subtree, clean ones are not entered
+		void refreshSubtreeBounds();
+
+		SceneNode(TransformHierarchy* transforms, EntityRegistry* components, SceneNode* parent, const std::shared_ptr<Renderable>& rend)
+			: _parent(parent), _bounds(parent ? parent->_bounds : nullptr), _transforms(transforms),
+			_id(transforms->create(parent ? parent->_id : TransformHierarchy::NONE)), _components(components) {
+			if (rend) _components->setRenderable(_id, rend);
+		}
 
-		Vector3 _translation, _scale;
-		Quaternion _rot;
+		void detach();
 
-		//mouse picking
-		unsigned int _stencilIndex = 0; //0 = not selectable
+		// back to the pool the node came from, or delete
+		static void destroy(SceneNode* node);
+
+		// recreates this subtree in another hierarchy, keeping the local transforms
+		void moveTo(TransformHierarchy* transforms, EntityRegistry* components, TransformHierarchy::Id parent, SceneBounds* bounds);
 
 	public:
 
@@ -34,66 +89,62 @@ namespace avt {
 
 	public:
 		SceneNode(const std::shared_ptr<Renderable>& rend = nullptr)
-			: _parent(nullptr), _translation(0, 0, 0), _scale(1.f, 1.f, 1.f), _rot({ 1.f,0,0 }, 0), _rend(rend)/*, _transform(Mat4::identity())*/ {}
-
-		virtual ~SceneNode() {
-			for (auto node : _nodes) {
-				delete node;
-			}
+			: _parent(nullptr), _bounds(nullptr), _ownTransforms(new TransformHierarchy()), _ownComponents(new EntityRegistry()) {
+			_transforms = _ownTransforms.get();
+			_id = _transforms->create();
+			_components = _ownComponents.get();
+			if (rend) _components->setRenderable(_id, rend);
 		}
 
-		SceneNode* createNode(const std::shared_ptr<Renderable>& rend = nullptr) {
-			SceneNode* node = new SceneNode(rend);
-			_nodes.push_back(node);
-			node->_parent = this;
-			node->_dirty = true;
-			return node;
-		}
+		SceneNode(const SceneNode&) = delete;
+		SceneNode& operator=(const SceneNode&) = delete;
 
-		SceneNode* addNode(SceneNode* node) {
-			_nodes.push_back(node);
-			node->_parent = this;
-			node->_dirty = true;
-			return node;
-		}
+		virtual ~SceneNode();
 
-		bool deleteNode(int index) {
-			if (index < 0 || index >= _nodes.size()) return false;
+		SceneNode* createNode(const std::shared_ptr<Renderable>& rend = nullptr);
 
-			delete _nodes[index];
-			_nodes.erase(_nodes.begin() + index);
-			return true;
-		}
+		// takes ownership, node is first removed from its current parent. Nodes made by a scene
+		// only move within that scene, nullptr when node comes from another one
+		SceneNode* addNode(SceneNode* node);
 
-		bool deleteNode(const SceneNode* node) {
-			for (int i = 0; i < _nodes.size(); i++) {
-				if (_nodes[i] == node) {
-					delete _nodes[i];
-					_nodes.erase(_nodes.begin() + i);
-					return true;
-				}
-			}
+		// swaps the last child into index
+		bool deleteNode(int index);
 
-			return false;
+		bool deleteNode(const SceneNode* node) {
+			if (!node || node->_parent != this) return false;
+			return deleteNode(static_cast<int>(node->_childIndex));
 		}
 
-		void deleteAll() {
-			for (auto node : _nodes) {
-				delete node;
-			}
-			_nodes.clear();
+		void deleteAll();
+
+		void reserveChildren(size_t count) {
+			_nodes.reserve(count);
 		}
 
 		const std::vector<SceneNode*>& children() const {
 			return _nodes;
 		}
 
-		void setRenderable(const std::shared_ptr<Renderable>& rend) {
-			_rend = rend;
+		void setRenderable(const std::shared_ptr<Renderable>& rend);
+
+		// valid until the next setRenderable or node deletion in the same scene
+		const std::shared_ptr<Renderable>& getRenderable() const {
+			return _components->renderable(_id);
+		}
+
+		// places prefab at this node, drawn along with the node's own renderable. nullptr removes it
+		void setPrefab(const std::shared_ptr<const Prefab>& prefab, const std::shared_ptr<const PrefabOverrides>& overrides = nullptr);
+
+		// a child placing prefab
+		SceneNode* createInstance(const std::shared_ptr<const Prefab>& prefab, const std::shared_ptr<const PrefabOverrides>& overrides = nullptr);
+
+		// both valid until the next setPrefab or node deletion in the same scene
+		const std::shared_ptr<const Prefab>& getPrefab() const {
+			return _components->prefab(_id);
 		}
 
-		const std::shared_ptr<Renderable>& getRenderable() {
-			return _rend;
+		const std::shared_ptr<const PrefabOverrides>& getPrefabOverrides() const {
+			return _components->prefabOverrides(_id);
 		}
 
 
@@ -109,92 +160,118 @@ namespace avt {
 			_transform *= transform;
 		}*/
 
-		const Mat4& getWorldTransform() const {
-			return _worldTransform;
+		// as of the last TransformHierarchy::update (Scene::updateTransforms)
+		const Affine& getWorldTransform() const {
+			return _transforms->getWorld(_id);
 		}
 
 		void updateWorldFromParent() {
-			if (!_parent) return;
-			_worldTransform = _parent->_worldTransform * getTransform();
-			_dirty = false;
+			_transforms->updateNode(_id);
 		}
 
 		bool dirty() const {
-			return _dirty;
+			return _transforms->dirty(_id);
 		}
 
-		Mat4 getTransform() const {
-			return Mat4::translation(_translation)
-				* _rot.toMat()
-				* Mat4::scale(_scale);
+		Affine getTransform() const {
+			return _transforms->getLocal(_id);
 		}
 
 		void setTranslation(const Vector3& v) {
-			_translation = v;
-			_dirty = true;
+			_transforms->setTranslation(_id, v);
 		}
 
 		const Vector3& getTranslation() const {
-			return _translation;
+			return _transforms->getTranslation(_id);
 		}
 
 		void translate(const Vector3& v) {
-			_translation += v;
-			_dirty = true;
+			_transforms->setTranslation(_id, getTranslation() + v);
 		}
 
 		void setScale(const Vector3& v) {
-			_scale = v;
-			_dirty = true;
+			_transforms->setScale(_id, v);
 		}
 
 		const Vector3& getScale() const {
-			return _scale;
+			return _transforms->getScale(_id);
 		}
 
 		void scale(const Vector3& v) {
-			_scale *= v;
+			Vector3 s = getScale();
+			s *= v;
+			_transforms->setScale(_id, s);
 		}
 
 		void rotateX(float rad) {
-			_rot *= Quaternion({ 1.f,0,0 }, rad);
-			_dirty = true;
+			rotate(Quaternion({ 1.f,0,0 }, rad));
 		}
 
 		void rotateY(float rad) {
-			_rot *= Quaternion({ 0,1.f,0 }, rad);
-			_dirty = true;
+			rotate(Quaternion({ 0,1.f,0 }, rad));
 		}
 
 		void rotateZ(float rad) {
-			_rot *= Quaternion({ 0,0,1.f }, rad);
-			_dirty = true;
+			rotate(Quaternion({ 0,0,1.f }, rad));
 		}
 
 		void setRotation(const Quaternion& q) {
-			_rot = q;
-			_dirty = true;
+			_transforms->setRotation(_id, q);
 		}
 
 		const Quaternion& getRotation() const {
-			return _rot;
+			return _transforms->getRotation(_id);
 		}
 
 		void rotate(const Quaternion& q) {
-			_rot *= q;
-			_dirty = true;
+			_transforms->setRotation(_id, getRotation() * q);
+		}
+
+		// invalid for nodes not created by a Scene
+		NodeHandle handle() const;
+
+		TransformHierarchy* getHierarchy() const {
+			return _transforms;
+		}
+
+		TransformHierarchy::Id getTransformId() const {
+			return _id;
+		}
+
+		EntityRegistry* getComponents() const {
+			return _components;
 		}
 
 		SceneNode* getParent() {
 			return _parent;
 		}
 
-		void setStencilIndex(unsigned int index) { //mouse picking
-			_stencilIndex = index;
+		// the subtree won't move or change, Scene::bakeStatic may merge its renderables
+		void setStatic(bool isStatic = true) {
+			_static = isStatic;
+		}
+
+		bool isStatic() const {
+			return _static;
+		}
+
+		// world bounds of every renderable in the subtree, as of the last Scene::updateTransforms.
+		// Empty when there are none, unbounded when one has no mesh bounds to go by
+		const AABB& getSubtreeBounds() const {
+			return _subtreeBounds;
+		}
+
+		// drawn as part of a static batch, not on its own
+		bool isBatched() const {
+			return _batch != nullptr;
+		}
+
+		void setStencilIndex(unsigned int index) { //mouse picking, 0 = not selectable
+			_components->setPick(_id, index);
 		}
 
-		unsigned int getStencilIndex() { //mouse picking
-			return _stencilIndex;
+		unsigned int getStencilIndex() const { //mouse picking
+			return _components->pick(_id);
 		}
 
 	};
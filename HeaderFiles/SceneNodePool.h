@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "SceneNode.h"
+
+
+namespace avt {
+
+	// Storage for the nodes of a Scene, in fixed-size chunks so nodes never move. Freed slots are
+	// reused last-in first-out, and each slot's generation changes whenever its node is destroyed,
+	// which is what makes a stale NodeHandle detectable.
+	class SceneNodePool {
+	public:
+		static const size_t CHUNK_SIZE = 256;
+
+	private:
+		using Storage = typename std::aligned_storage<sizeof(SceneNode), alignof(SceneNode)>::type;
+
+		std::vector<std::unique_ptr<Storage[]>> _chunks;
+		std::vector<uint32_t> _generation; // per slot
+		std::vector<uint8_t> _alive;
+		std::vector<uint32_t> _free;
+		size_t _used = 0; // slots handed out since the last clear, the rest is untouched
+		size_t _live = 0;
+		bool _clearing = false;
+
+		SceneNode* at(uint32_t index) const {
+			return reinterpret_cast<SceneNode*>(&_chunks[index / CHUNK_SIZE][index % CHUNK_SIZE]);
+		}
+
+		uint32_t allocate();
+
+	public:
+		SceneNodePool() = default;
+
+		SceneNodePool(const SceneNodePool&) = delete;
+		SceneNodePool& operator=(const SceneNodePool&) = delete;
+
+		~SceneNodePool() {
+			clear();
+		}
+
+		SceneNode* create(TransformHierarchy* transforms, EntityRegistry* components, SceneNode* parent, const std::shared_ptr<Renderable>& rend);
+
+		// destroys the node and its subtree, the node must already be out of its parent's children
+		void destroy(SceneNode* node);
+
+		// destroys every node at once: one pass over the slots, no unlinking from parents,
+		// no per-node transform removal and no memory freed (chunks are kept for reuse).
+		// The transform hierarchy the nodes lived in has to be cleared by the owner
+		void clear();
+
+		// while clear runs, its nodes skip the bookkeeping of a single destroy
+		bool clearing() const {
+			return _clearing;
+		}
+
+		NodeHandle handle(const SceneNode* node) const;
+
+		// nullptr when the node was destroyed since the handle was taken
+		SceneNode* get(NodeHandle handle) const {
+			if (handle.index >= _used || !_alive[handle.index] || _generation[handle.index] != handle.generation) return nullptr;
+			return at(handle.index);
+		}
+
+		size_t size() const {
+			return _live;
+		}
+
+		size_t capacity() const {
+			return _chunks.size() * CHUNK_SIZE;
+		}
+	};
+
+}
\ No newline at end of file
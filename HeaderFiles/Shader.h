@@ -12,6 +12,7 @@
 #include <initializer_list>
 #include "avt_math.h"
 #include "VertexBufferLayout.h"
+#include "GLState.h"
 
 namespace avt {
 
@@ -97,12 +98,20 @@ namespace avt {
 		std::map<std::string, std::string> _macros;
 		std::set<std::string> _uniforms;
 		std::map<std::string, GLuint> _uniformBlocks;
+		std::map<std::string, GLuint> _storageBlocks;
 		std::map<std::string, GLuint> _textures;
 		std::string _vertexShader;
 		std::string _fragmentShader;
 		bool _externalSource = true;
 
 		std::string _model = "";
+		std::string _normal = "";
+		std::string _lightSpace = "";
+		std::string _lightViewProj = "";
+		std::string _instanceModel = "";
+		GLuint _instanceLocation = 0;
+		std::string _objectBlock = "";
+		GLuint _objectBinding = 0;
 
 	public:
 
@@ -146,6 +155,12 @@ namespace avt {
 			return *this;
 		}
 
+		// shader storage block, GL 4.3
+		ShaderParams& addStorageBlock(std::string sb, GLuint bindingPoint) {
+			_storageBlocks.insert({ sb, bindingPoint });
+			return *this;
+		}
+
 		ShaderParams& addTexture(std::string tex, GLuint bindingPoint) {
 			_textures.insert({ tex, bindingPoint });
 			return *this;
@@ -185,6 +200,54 @@ namespace avt {
 			return *this;
 		}
 
+		// mat3 inverse transpose of the model matrix, computed once per object on the cpu
+		ShaderParams& useNormalMatrix(const std::string& uName = "NormalMatrix") {
+			_uniforms.insert(uName);
+			_normal = uName;
+			return *this;
+		}
+
+		// light projection * light view * model, computed once per object on the cpu. Only for
+		// shaders with a model matrix uniform: instanced and object buffer ones have no per-object
+		// uniform and take useLightViewProj instead. Resources/shadowShaders/vertexDepthShader.glsl
+		// reads it, the shadow shaders there read the model and normal matrices (useModelMatrix,
+		// useNormalMatrix) and are drawn wrong without them
+		ShaderParams& useLightSpaceMatrix(const std::string& uName = "LightSpaceMatrix") {
+			_uniforms.insert(uName);
+			_lightSpace = uName;
+			return *this;
+		}
+
+		// light projection * light view, the same for every object: the shader applies the model
+		// matrix itself
+		ShaderParams& useLightViewProj(const std::string& uName = "LightViewProj") {
+			_uniforms.insert(uName);
+			_lightViewProj = uName;
+			return *this;
+		}
+
+		// model matrix as a per-instance mat4 attribute taking locations [location, location + 3]:
+		// the renderer then draws runs of the same mesh and material with one instanced call.
+		// The normal matrix is left to the shader, the light comes in through useLightViewProj
+		ShaderParams& useInstancedModelMatrix(const std::string& attrib = "InstanceModel", GLuint location = 4) {
+			_inputs.insert({ attrib, location });
+			_instanceModel = attrib;
+			_instanceLocation = location;
+			return *this;
+		}
+
+		// per-object data in a storage block, an array of { mat4 model; uint material; } (std430) indexed
+		// by the int attribute at MeshArena::OBJECT_INDEX. The renderer then draws every material's
+		// objects with one multi-draw indirect call over the shared mesh arena, GL 4.3.
+		// Takes precedence over useInstancedModelMatrix; the light comes in through useLightViewProj
+		ShaderParams& useObjectBuffer(const std::string& block = "Objects", GLuint bindingPoint = 1, const std::string& indexAttrib = "ObjectIndex") {
+			_storageBlocks.insert({ block, bindingPoint });
+			_inputs.insert({ indexAttrib, 4 }); // MeshArena::OBJECT_INDEX
+			_objectBlock = block;
+			_objectBinding = bindingPoint;
+			return *this;
+		}
+
 		ShaderParams& clearInputs() {
 			_inputs.clear();
 			return *this;
@@ -210,6 +273,7 @@ namespace avt {
 			_macros.clear();
 			_uniforms.clear();
 			_uniformBlocks.clear();
+			_storageBlocks.clear();
 			_vertexShader.clear();
 			_fragmentShader.clear();
 			return *this;
@@ -225,6 +289,13 @@ namespace avt {
 
 		mutable std::map<std::string, GLint> _uniforms;
 		std::string _modelUniform = "";
+		std::string _normalUniform = "";
+		std::string _lightSpaceUniform = "";
+		std::string _lightViewProjUniform = "";
+		bool _instanced = false;
+		GLuint _instanceLocation = 0;
+		bool _objectBuffer = false;
+		GLuint _objectBinding = 0;
 
 		GLchar* parseShader(const std::string& filename);
 		unsigned int compileShader(GLenum shader_type, const std::string& source, bool external);
@@ -247,15 +318,16 @@ namespace avt {
 
 		~Shader() {
 			glDeleteProgram(_program);
-			glUseProgram(0);
+			GLState::deleteProgram(_program);
+			GLState::useProgram(0);
 		}
 
 		void bind() {
-			glUseProgram(_program);
+			GLState::useProgram(_program);
 		}
 
 		void unbind() {
-			glUseProgram(0);
+			GLState::useProgram(0);
 		}
 
 		const ShaderInputLayout& getInputLayout() const {
@@ -263,11 +335,56 @@ namespace avt {
 			return *_layout;
 		}
 
+		bool instanced() const {
+			return _instanced;
+		}
+
+		// first of the four locations of the per-instance model matrix
+		GLuint instanceLocation() const {
+			return _instanceLocation;
+		}
+
+		bool usesObjectBuffer() const {
+			return _objectBuffer;
+		}
+
+		// binding point of the per-object storage block
+		GLuint objectBinding() const {
+			return _objectBinding;
+		}
+
 		void uploadModelMatrix(const Mat4& model) {
 			if (_modelUniform.length() == 0) return;
 			uploadUniformMat4(_modelUniform, model);
 		}
 
+		bool usesNormalMatrix() const {
+			return _normalUniform.length() != 0;
+		}
+
+		void uploadNormalMatrix(const Mat3& normal) {
+			if (_normalUniform.length() == 0) return;
+			uploadUniformMat3(_normalUniform, normal);
+		}
+
+		bool usesLightSpaceMatrix() const {
+			return _lightSpaceUniform.length() != 0;
+		}
+
+		void uploadLightSpaceMatrix(const Mat4& lightSpace) {
+			if (_lightSpaceUniform.length() == 0) return;
+			uploadUniformMat4(_lightSpaceUniform, lightSpace);
+		}
+
+		bool usesLightViewProj() const {
+			return _lightViewProjUniform.length() != 0;
+		}
+
+		void uploadLightViewProj(const Mat4& lightViewProj) {
+			if (_lightViewProjUniform.length() == 0) return;
+			uploadUniformMat4(_lightViewProjUniform, lightViewProj);
+		}
+
 		void uploadUniformFloat(const std::string& uniform, float value, bool bind = false) {
 			if (bind) this->bind();
 			glUniform1f(getUniformLocation(uniform), value);
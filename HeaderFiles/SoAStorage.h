@@ -0,0 +1,122 @@
+#pragma once
+
+#include <memory>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace avt {
+
+	// Backing store of the SoA streams: N float arrays of equal length in one allocation.
+	// Every array starts 32-byte aligned and is padded to a multiple of LANES floats,
+	// padding and newly grown elements are zero.
+	template<int N>
+	class SoAStorage {
+	public:
+		static const size_t LANES = 8;
+
+	private:
+		std::unique_ptr<float[]> _mem;
+		float* _arrays[N] = {};
+		size_t _size = 0;
+		size_t _capacity = 0;
+
+	public:
+		SoAStorage() {}
+
+		SoAStorage(const SoAStorage& other) {
+			*this = other;
+		}
+
+		SoAStorage(SoAStorage&& other) noexcept {
+			*this = std::move(other);
+		}
+
+		~SoAStorage() {}
+
+		SoAStorage& operator=(const SoAStorage& other) {
+			if (this == &other) return *this;
+
+			_size = 0;
+			reserve(other._size);
+			for (int c = 0; c < N; c++) {
+				std::copy_n(other._arrays[c], other._size, _arrays[c]);
+			}
+			_size = other._size;
+			return *this;
+		}
+
+		SoAStorage& operator=(SoAStorage&& other) noexcept {
+			_mem = std::move(other._mem);
+			for (int c = 0; c < N; c++) {
+				_arrays[c] = other._arrays[c];
+				other._arrays[c] = nullptr;
+			}
+			_size = other._size;
+			_capacity = other._capacity;
+
+			other._size = other._capacity = 0;
+			return *this;
+		}
+
+		size_t size() const {
+			return _size;
+		}
+
+		size_t capacity() const {
+			return _capacity;
+		}
+
+		float* operator[](int c) {
+			return _arrays[c];
+		}
+
+		const float* operator[](int c) const {
+			return _arrays[c];
+		}
+
+		void reserve(size_t capacity) {
+			if (capacity <= _capacity) return;
+
+			capacity = (capacity + LANES - 1) / LANES * LANES;
+
+			// over-allocated by a register so the first array can start 32-byte aligned
+			std::unique_ptr<float[]> mem(new float[N * capacity + LANES]());
+			uintptr_t addr = reinterpret_cast<uintptr_t>(mem.get());
+			float* base = reinterpret_cast<float*>((addr + 31) & ~static_cast<uintptr_t>(31));
+
+			for (int c = 0; c < N; c++) {
+				float* arr = base + c * capacity;
+				if (_size > 0) std::copy_n(_arrays[c], _size, arr);
+				_arrays[c] = arr;
+			}
+
+			_mem = std::move(mem);
+			_capacity = capacity;
+		}
+
+		// keeps the current elements, new ones are zero
+		void resize(size_t size) {
+			if (size > _capacity) reserve(size > 2 * _capacity ? size : 2 * _capacity);
+
+			if (size > _size) {
+				for (int c = 0; c < N; c++) {
+					std::fill(_arrays[c] + _size, _arrays[c] + size, 0.0f);
+				}
+			}
+			_size = size;
+		}
+
+		// room for one more element, returns its index
+		size_t grow() {
+			if (_size == _capacity) reserve(_capacity ? 2 * _capacity : LANES);
+			return _size++;
+		}
+
+		void clear() {
+			_size = 0;
+		}
+	};
+
+}
\ No newline at end of file
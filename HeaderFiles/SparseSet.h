@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+
+namespace avt {
+
+	// Values of type T for some of the entities of an EntityRegistry, packed: the values sit in one
+	// dense array in no particular order, next to the entity each belongs to, and a sparse array
+	// indexed by entity gives the position. Removal swaps the last value in, so a pass over
+	// values() never meets a hole
+	template<typename T>
+	class SparseSet {
+	public:
+		using Entity = uint32_t;
+		static constexpr uint32_t NONE = 0xffffffffu;
+
+	private:
+		std::vector<uint32_t> _sparse; // per entity, position in the dense arrays or NONE
+		std::vector<Entity> _entities;
+		std::vector<T> _values;
+
+	public:
+		bool has(Entity e) const {
+			return e < _sparse.size() && _sparse[e] != NONE;
+		}
+
+		// replaces the value when the entity has one already
+		T& set(Entity e, const T& value) {
+			if (has(e)) return _values[_sparse[e]] = value;
+
+			if (e >= _sparse.size()) _sparse.resize(e + 1, NONE);
+			_sparse[e] = static_cast<uint32_t>(_entities.size());
+			_entities.push_back(e);
+			_values.push_back(value);
+			return _values.back();
+		}
+
+		void remove(Entity e) {
+			if (!has(e)) return;
+
+			uint32_t i = _sparse[e];
+			Entity last = _entities.back();
+			_entities[i] = last;
+			_values[i] = std::move(_values.back());
+			_sparse[last] = i;
+			_entities.pop_back();
+			_values.pop_back();
+			_sparse[e] = NONE;
+		}
+
+		void clear() {
+			_sparse.clear();
+			_entities.clear();
+			_values.clear();
+		}
+
+		// the entity must have one
+		T& get(Entity e) {
+			return _values[_sparse[e]];
+		}
+
+		const T& get(Entity e) const {
+			return _values[_sparse[e]];
+		}
+
+		// nullptr when the entity has none
+		const T* find(Entity e) const {
+			return has(e) ? &_values[_sparse[e]] : nullptr;
+		}
+
+		size_t size() const {
+			return _values.size();
+		}
+
+		// the two arrays line up, entities()[i] owns values()[i]
+		const std::vector<Entity>& entities() const {
+			return _entities;
+		}
+
+		std::vector<T>& values() {
+			return _values;
+		}
+
+		const std::vector<T>& values() const {
+			return _values;
+		}
+
+		// f(entity, value) in dense order
+		template<typename F>
+		void each(F f) {
+			for (size_t i = 0; i < _values.size(); i++) f(_entities[i], _values[i]);
+		}
+
+		template<typename F>
+		void each(F f) const {
+			for (size_t i = 0; i < _values.size(); i++) f(_entities[i], _values[i]);
+		}
+	};
+
+	template<typename T>
+	constexpr uint32_t SparseSet<T>::NONE;
+
+}
\ No newline at end of file
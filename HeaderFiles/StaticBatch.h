@@ -0,0 +1,62 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "Geometry.h"
+
+namespace avt {
+
+	class Renderable;
+	class SceneNode;
+
+	// Renderables of static subtrees (SceneNode::setStatic) merged into one pre-transformed mesh per
+	// material and spatial chunk, so a field of props costs one draw per chunk and chunks can still be
+	// culled. The original nodes stay in the scene, for picking and bounds queries, only marked as
+	// batched so the renderer skips their renderables. Nodes are not followed after baking: moving,
+	// deleting or changing them needs another bake. A deleted node does leave the batch's list on
+	// its own, its geometry stays in the chunk until then
+	class StaticBatch {
+	public:
+		// world units per chunk side
+		static constexpr float CHUNK_SIZE = 32.0f;
+
+		struct Chunk {
+			std::shared_ptr<Renderable> rend; // the merged mesh with the shared material
+			AABB bounds; // world
+			size_t nodes = 0;
+		};
+
+	private:
+		std::vector<Chunk> _chunks;
+		std::vector<SceneNode*> _batched; // nodes take themselves out when destroyed
+
+		friend class SceneNode;
+
+		void remove(SceneNode* node);
+
+	public:
+		StaticBatch() = default;
+		~StaticBatch(); // the nodes that outlive it draw on their own again
+
+		StaticBatch(const StaticBatch&) = delete;
+		StaticBatch& operator=(const StaticBatch&) = delete;
+
+		// world matrices must be up to date. Only triangle meshes that still have their local data
+		// are merged, picking targets are left to draw on their own (their stencil index is per node)
+		// and so are prefab instances
+		void bake(SceneNode* root, float chunkSize = CHUNK_SIZE);
+
+		// the batched nodes draw on their own again
+		void clear();
+
+		const std::vector<Chunk>& chunks() const {
+			return _chunks;
+		}
+
+		size_t batchedNodes() const {
+			return _batched.size();
+		}
+	};
+
+}
\ No newline at end of file
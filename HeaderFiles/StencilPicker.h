@@ -4,9 +4,11 @@
 #include <string>
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
+#include "GLState.h"
 
 namespace avt {
 	class SceneNode;
+	class TransformHierarchy;
 
 	class StencilPicker {
 	private:
@@ -24,7 +26,7 @@ namespace avt {
 		~StencilPicker() {}
 
 		static void enable() {
-			glEnable(GL_STENCIL_TEST);
+			GLState::enable(GL_STENCIL_TEST);
 			glStencilOp(GL_KEEP, GL_KEEP, GL_REPLACE);
 		}
 
@@ -37,7 +39,7 @@ namespace avt {
 		}
 
 		static void disable() {
-			glDisable(GL_STENCIL_TEST);
+			GLState::disable(GL_STENCIL_TEST);
 		}
 		
 		static void prepareStencil(unsigned int index) {
@@ -52,8 +54,14 @@ namespace avt {
 
 		static void removeAllTargets(const std::string& alias);
 
+		// the targets among nodes of hierarchy, a scene's before it is cleared
+		static void removeTargetsIn(const TransformHierarchy* hierarchy);
+
 		static void clear();
 
+		// nullptr when target isn't a picking target
+		static const std::string* getAlias(const SceneNode* target);
+
 		static std::pair<SceneNode*, std::string> getTargetOn(int x, int y);
 		
 		static std::pair<SceneNode*, std::string> getTargetOnCursor(GLFWwindow* win);
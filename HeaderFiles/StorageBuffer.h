@@ -0,0 +1,103 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <vector>
+#include "ErrorManager.h"
+#include "GLState.h"
+
+namespace avt{
+
+	// GL buffer rewritten every frame with data read by shaders or draw calls: a shader storage
+	// buffer bound to a binding point, or a draw indirect buffer (the binding point is unused then).
+	// Grows to fit an upload, orphaning the old storage so the write doesn't wait on earlier draws
+	class StorageBuffer {
+	private:
+		GLuint _bufferID;
+		GLenum _target;
+		GLuint _bindingPoint;
+		GLsizeiptr _capacity;
+		GLsizeiptr _size = 0;
+
+		bool indexed() const {
+			return _target == GL_SHADER_STORAGE_BUFFER;
+		}
+
+	public:
+		StorageBuffer(GLenum target, GLuint bindingPoint = 0, GLsizeiptr capacity = 0)
+			: _bufferID(0), _target(target), _bindingPoint(bindingPoint), _capacity(capacity) {
+			glGenBuffers(1, &_bufferID);
+			GLState::bindBuffer(_target, _bufferID);
+			glBufferData(_target, _capacity, nullptr, GL_STREAM_DRAW);
+			if (indexed()) GLState::bindBufferBase(_target, _bindingPoint, _bufferID);
+
+#ifndef ERROR_CALLBACK
+			ErrorManager::checkOpenGLError("ERROR: Could not create Storage Buffer.");
+#endif
+		}
+
+		StorageBuffer(const StorageBuffer&) = delete;
+		StorageBuffer& operator=(const StorageBuffer&) = delete;
+
+		~StorageBuffer() {
+			glDeleteBuffers(1, &_bufferID);
+			GLState::deleteBuffer(_bufferID);
+			GLState::bindBuffer(_target, 0);
+
+#ifndef ERROR_CALLBACK
+			ErrorManager::checkOpenGLError("ERROR: Could not destroy Storage Buffer.");
+#endif
+		}
+
+		void upload(const void* data, GLsizeiptr size) {
+			if (!data || size <= 0) return;
+
+			GLState::bindBuffer(_target, _bufferID);
+			if (size > _capacity) _capacity = size + size / 2;
+			glBufferData(_target, _capacity, nullptr, GL_STREAM_DRAW);
+			glBufferSubData(_target, 0, size, data);
+			_size = size;
+
+#ifndef ERROR_CALLBACK
+			ErrorManager::checkOpenGLError("ERROR: Could not upload data to Storage Buffer.");
+#endif
+		}
+
+		template<typename T>
+		void upload(const std::vector<T>& data) {
+			upload(data.data(), data.size() * sizeof(T));
+		}
+
+		// to the target, and to the binding point for a shader storage buffer
+		void bind() const {
+			GLState::bindBuffer(_target, _bufferID);
+			if (indexed()) GLState::bindBufferBase(_target, _bindingPoint, _bufferID);
+		}
+
+		void unbind() const {
+			GLState::bindBuffer(_target, 0);
+		}
+
+		void setBindingPoint(GLuint bindingPoint) {
+			_bindingPoint = bindingPoint;
+			if (!indexed()) return;
+			GLState::bindBufferBase(_target, _bindingPoint, _bufferID);
+
+#ifndef ERROR_CALLBACK
+			ErrorManager::checkOpenGLError("ERROR: Could not set Storage Buffer binding point.");
+#endif
+		}
+
+		GLuint bindingPoint() const {
+			return _bindingPoint;
+		}
+
+		GLsizeiptr size() const {
+			return _size;
+		}
+
+		GLsizeiptr capacity() const {
+			return _capacity;
+		}
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace avt {
+
+	// Fixed set of worker threads running parallel loops. The calling thread takes chunks too,
+	// so a system without workers (or a loop smaller than its grain) just runs inline.
+	// One loop at a time: a loop body must not start another one.
+	class TaskSystem {
+	private:
+		using Body = void (*)(const void* context, size_t begin, size_t end);
+
+		std::vector<std::thread> _workers;
+		std::mutex _mutex;
+		std::condition_variable _wake, _done;
+
+		// the loop in progress
+		Body _body = nullptr;
+		const void* _context = nullptr;
+		size_t _count = 0;
+		size_t _chunk = 0;
+		std::atomic<size_t> _next{ 0 };
+		uint64_t _loop = 0; // bumped per loop, workers wait for it to change
+		unsigned _busy = 0; // workers not done with the current loop
+		bool _stop = false;
+
+		void work();
+		void runChunks();
+		void run(size_t count, size_t grain, Body body, const void* context);
+
+	public:
+		// workers on top of the calling thread, one per remaining hardware thread
+		static unsigned defaultWorkers();
+
+		explicit TaskSystem(unsigned workers = defaultWorkers());
+		~TaskSystem();
+
+		TaskSystem(const TaskSystem&) = delete;
+		TaskSystem& operator=(const TaskSystem&) = delete;
+
+		// threads a loop runs on, the caller included
+		unsigned threads() const {
+			return static_cast<unsigned>(_workers.size()) + 1;
+		}
+
+		// body(begin, end) over [0, count) in chunks of at least grain, returns when every chunk is done
+		template<typename F>
+		void parallelFor(size_t count, size_t grain, const F& body) {
+			run(count, grain, [](const void* context, size_t begin, size_t end) {
+				(*static_cast<const F*>(context))(begin, end);
+			}, &body);
+		}
+	};
+
+}
\ No newline at end of file
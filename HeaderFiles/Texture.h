@@ -1,9 +1,10 @@
 #pragma once
-#include <GL\glew.h>
+#include <GL/glew.h>
 #include "VertexArray.h"
 #include "avt_math.h"
 #include "Shader.h"
 #include "ErrorManager.h"
+#include "GLState.h"
 
 #include "../Dependencies/stb_image.h"
 #include <string>
@@ -78,8 +79,9 @@ namespace avt {
 		Texture(int width, int height, const TextureParams& params = TextureParams());
 
 		~Texture() {
-			glBindTexture(GL_TEXTURE_2D, 0);
+			GLState::bindTexture(GL_TEXTURE_2D, 0);
 			glDeleteTextures(1, &_texID);
+			GLState::deleteTexture(_texID);
 		}
 
 
@@ -90,13 +92,11 @@ namespace avt {
 		void replaceImage(const std::string& filename);
 
 		virtual void bind(unsigned int slot = 0) const {
-			glActiveTexture(GL_TEXTURE0 + slot);
-			glBindTexture(GL_TEXTURE_2D, _texID);
+			GLState::bindTexture(slot, GL_TEXTURE_2D, _texID);
 		}
 
 		virtual void unbind(unsigned int slot = 0) const {
-			glActiveTexture(GL_TEXTURE0 + slot);
-			glBindTexture(GL_TEXTURE_2D, 0);
+			GLState::bindTexture(slot, GL_TEXTURE_2D, 0);
 		}
 
 		static const std::shared_ptr<Texture>& getDefault() {
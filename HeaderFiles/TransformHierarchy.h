@@ -0,0 +1,205 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "Vector3.h"
+#include "Quaternion.h"
+#include "Affine.h"
+
+
+namespace avt {
+
+	class TaskSystem;
+
+	// Transform data of a node tree kept in flat arrays (local TRS, cached local and world matrices,
+	// parent, change flags). The arrays are in breadth-first order: every parent comes before its
+	// children, a node's children are contiguous, so a subtree is one contiguous range per depth.
+	// Nodes created since the last sort sit in a tail after that order and are resorted in bulk.
+	// Nodes are addressed by ids that stay valid while the arrays are reordered.
+	class TransformHierarchy {
+	public:
+		using Id = uint32_t;
+		static constexpr uint32_t NONE = 0xffffffffu;
+
+		// work done by the last update
+		struct Stats {
+			size_t changedRoots = 0; // changed nodes with no changed ancestor (all changed nodes on a full pass)
+			size_t localUpdates = 0; // local matrices rebuilt from TRS
+			size_t worldUpdates = 0; // world matrices recomputed
+			bool sorted = false;
+		};
+
+	private:
+		enum Flags : uint8_t {
+			QUEUED = 1, // in _changed, world needs an update
+			LOCAL = 2, // TRS changed since the local matrix was cached
+			ROOT = 4, // already in the roots of this update
+			DIRTY = 8 // set during a full pass
+		};
+
+		// per slot
+		std::vector<Vector3> _translation;
+		std::vector<Quaternion> _rotation;
+		std::vector<Vector3> _scale;
+		std::vector<Affine> _local;
+		std::vector<Affine> _world;
+		std::vector<uint32_t> _parent; // slot of the parent, NONE for roots
+		std::vector<uint32_t> _childBegin; // children are [childBegin, childBegin + childCount), sorted part only
+		std::vector<uint32_t> _childCount;
+		std::vector<uint8_t> _flags;
+		std::vector<Id> _idOf; // NONE for removed slots until the next sort
+
+		// per id
+		std::vector<uint32_t> _slotOf;
+		std::vector<Id> _freeIds;
+		std::vector<Id> _queuedFreeIds; // removed while in _changed, reused once it is cleared
+
+		std::vector<Id> _changed; // nodes whose TRS or parent changed since the last update
+		std::vector<uint32_t> _roots; // scratch of update
+		std::vector<std::pair<uint32_t, uint32_t>> _ranges, _nextRanges;
+		std::vector<size_t> _rangeStart;
+		std::vector<std::pair<uint32_t, uint32_t>> _updated; // slots the last update recomputed
+
+		std::vector<uint32_t> _levelStart; // first slot of each depth in the sorted part
+		size_t _sortedCount = 0; // slots in breadth-first order, the rest is the tail
+		size_t _removedCount = 0;
+		bool _orderBroken = false; // a reparent moved a node out of its sibling range
+
+		Stats _stats;
+
+		uint32_t slot(Id id) const {
+			return _slotOf[id];
+		}
+
+		void touch(uint32_t s, uint8_t flags) {
+			if (!(_flags[s] & QUEUED)) _changed.push_back(_idOf[s]);
+			_flags[s] |= QUEUED | flags;
+		}
+
+		void markUpdated(uint32_t begin, uint32_t end) {
+			if (!_updated.empty() && _updated.back().second == begin) _updated.back().second = end;
+			else _updated.push_back({ begin, end });
+		}
+
+		bool inOrder();
+		void updateRoots(TaskSystem* tasks);
+		void updateAll(TaskSystem* tasks);
+		void clearChanged();
+
+	public:
+		TransformHierarchy() : _levelStart(1, 0) {}
+
+		TransformHierarchy(const TransformHierarchy&) = delete;
+		TransformHierarchy& operator=(const TransformHierarchy&) = delete;
+
+		// slots in use, removed slots included until the next sort
+		size_t size() const {
+			return _idOf.size();
+		}
+
+		void reserve(size_t capacity);
+
+		// drops every node at once, ids start over from 0
+		void clear();
+
+		// new node with identity TRS under parent (NONE for a root), starts changed
+		Id create(Id parent = NONE);
+
+		// the node's children must have been removed or moved to another parent first
+		void remove(Id id);
+
+		// moves the node and its subtree, parent must not be inside that subtree
+		void setParent(Id id, Id parent);
+
+		Id getParent(Id id) const {
+			uint32_t p = _parent[slot(id)];
+			return p == NONE ? NONE : _idOf[p];
+		}
+
+		const Vector3& getTranslation(Id id) const {
+			return _translation[slot(id)];
+		}
+
+		const Quaternion& getRotation(Id id) const {
+			return _rotation[slot(id)];
+		}
+
+		const Vector3& getScale(Id id) const {
+			return _scale[slot(id)];
+		}
+
+		void setTranslation(Id id, const Vector3& v) {
+			uint32_t s = slot(id);
+			_translation[s] = v;
+			touch(s, LOCAL);
+		}
+
+		void setRotation(Id id, const Quaternion& q) {
+			uint32_t s = slot(id);
+			_rotation[s] = q;
+			touch(s, LOCAL);
+		}
+
+		void setScale(Id id, const Vector3& v) {
+			uint32_t s = slot(id);
+			_scale[s] = v;
+			touch(s, LOCAL);
+		}
+
+		Affine getLocal(Id id) const {
+			uint32_t s = slot(id);
+			if (_flags[s] & LOCAL) return Affine::fromTRS(_translation[s], _rotation[s], _scale[s]);
+			return _local[s];
+		}
+
+		// as of the last update
+		const Affine& getWorld(Id id) const {
+			return _world[slot(id)];
+		}
+
+		// changed since the last update
+		bool dirty(Id id) const {
+			return (_flags[slot(id)] & QUEUED) != 0;
+		}
+
+		// recomputes one node from its parent's current world matrix, the node stays queued
+		// so update still refreshes its descendants
+		void updateNode(Id id);
+
+		// restores breadth-first order over every node and drops removed slots, done by update when needed
+		void sort();
+
+		// world matrices of the changed nodes and their descendants. Touches nothing when
+		// no node changed, only the changed subtrees when a few did.
+		// With tasks, each depth is split across its threads; the result is the same bit for bit
+		void update(TaskSystem* tasks = nullptr);
+
+		const Stats& stats() const {
+			return _stats;
+		}
+
+		// slots whose world matrix the last update recomputed, as disjoint [begin, end) ranges.
+		// Removed slots can be among them, idAt gives NONE for those
+		const std::vector<std::pair<uint32_t, uint32_t>>& updatedSlots() const {
+			return _updated;
+		}
+
+		Id idAt(uint32_t slot) const {
+			return _idOf[slot];
+		}
+
+		// number of depths in the sorted part, slots [levelBegin(d), levelBegin(d + 1)) hold depth d.
+		// Tail slots (from levelBegin(levels())) follow in creation order
+		size_t levels() const {
+			return _levelStart.size() - 1;
+		}
+
+		uint32_t levelBegin(size_t depth) const {
+			return _levelStart[depth];
+		}
+	};
+
+}
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include <initializer_list>
 #include "Mat4.h"
 #include "ErrorManager.h"
+#include "GLState.h"
 
 namespace avt{
 
@@ -15,9 +16,9 @@ namespace avt{
 	public:
 		UniformBuffer(GLsizeiptr size, GLuint bindingPoint) : _uboID(0), _size((GLsizei)size) {
 			glGenBuffers(1, &_uboID);
-			glBindBuffer(GL_UNIFORM_BUFFER, _uboID);
+			GLState::bindBuffer(GL_UNIFORM_BUFFER, _uboID);
 			glBufferData(GL_UNIFORM_BUFFER, size, nullptr, GL_STREAM_DRAW);
-			glBindBufferBase(GL_UNIFORM_BUFFER, bindingPoint, _uboID);
+			GLState::bindBufferBase(GL_UNIFORM_BUFFER, bindingPoint, _uboID);
 		
 			_bindingPoint = bindingPoint;
 
@@ -28,7 +29,8 @@ namespace avt{
 
 		~UniformBuffer() {
 			glDeleteBuffers(1, &_uboID);
-			glBindBuffer(GL_UNIFORM_BUFFER, 0);
+			GLState::deleteBuffer(_uboID);
+			GLState::bindBuffer(GL_UNIFORM_BUFFER, 0);
 
 #ifndef ERROR_CALLBACK
 			ErrorManager::checkOpenGLError("ERROR: Could not destroy Uniform Buffer.");
@@ -42,7 +44,7 @@ namespace avt{
 				return;
 			}
 
-			glBindBuffer(GL_UNIFORM_BUFFER, _uboID);
+			GLState::bindBuffer(GL_UNIFORM_BUFFER, _uboID);
 			glBufferSubData(GL_UNIFORM_BUFFER, 0, size, data);
 
 #ifndef ERROR_CALLBACK
@@ -58,7 +60,7 @@ namespace avt{
 		void upload(std::initializer_list<Mat4> mList) {
 			if (mList.size() * 16 * sizeof(GLfloat) > _size) return;
 
-			glBindBuffer(GL_UNIFORM_BUFFER, _uboID);
+			GLState::bindBuffer(GL_UNIFORM_BUFFER, _uboID);
 			GLintptr pos = 0;
 			for (auto& m : mList) {
 				glBufferSubData(GL_UNIFORM_BUFFER, pos, 16 * sizeof(GLfloat), m.data());
@@ -71,16 +73,16 @@ namespace avt{
 		}
 
 		void bind() const {
-			glBindBuffer(GL_UNIFORM_BUFFER, _uboID);
+			GLState::bindBuffer(GL_UNIFORM_BUFFER, _uboID);
 		}
 
 		void unbind() const {
-			glBindBuffer(GL_UNIFORM_BUFFER, 0);
+			GLState::bindBuffer(GL_UNIFORM_BUFFER, 0);
 		}
 
 		void setBindingPoint(GLuint bindingPoint) {
-			glBindBuffer(GL_UNIFORM_BUFFER, _uboID);
-			glBindBufferBase(GL_UNIFORM_BUFFER, bindingPoint, _uboID);
+			GLState::bindBuffer(GL_UNIFORM_BUFFER, _uboID);
+			GLState::bindBufferBase(GL_UNIFORM_BUFFER, bindingPoint, _uboID);
 			_bindingPoint = bindingPoint;
 
 #ifndef ERROR_CALLBACK
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <iostream>
+#include <type_traits>
 #include <math.h>
 
 
@@ -13,16 +14,9 @@ namespace avt {
 	public:
 		float x, y;
 
-		Vector2(float x = 0, float y = 0)
+		constexpr Vector2(float x = 0, float y = 0)
 			: x(x), y(y) {}
 
-		Vector2(const Vector2& vec)
-			: x(vec.x), y(vec.y) {}
-
-		~Vector2() {}
-
-		Vector2& operator=(const Vector2& vec);
-
 		Vector3 to3D(float z = 0) const;
 
 		Vector4 to4D(float z = 0, float w = 1.f) const;
@@ -93,4 +87,7 @@ namespace avt {
 		}
 	};
 
+	static_assert(std::is_trivially_copyable<Vector2>::value, "Vector2 must stay a plain value type");
+	static_assert(sizeof(Vector2) == 2 * sizeof(float), "Vector2 must be 2 packed floats, the size of a ShaderDataType::VEC2");
+
 }
\ No newline at end of file
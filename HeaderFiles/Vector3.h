@@ -1,8 +1,11 @@
 #pragma once
 
 #include <iostream>
+#include <type_traits>
 #include <math.h>
 
+#include "FastMath.h"
+
 
 namespace avt {
 
@@ -13,18 +16,11 @@ namespace avt {
 	struct Vector3 {
 		float x, y, z;
 
-		Vector3(float x = 0, float y = 0, float z = 0)
+		constexpr Vector3(float x = 0, float y = 0, float z = 0)
 			: x(x), y(y), z(z) {}
 
-		Vector3(const Vector3& vec)
-			: x(vec.x), y(vec.y), z(vec.z) {}
-
 		Vector3(const Vector2& vec, float z = 0);
 
-		~Vector3() {}
-
-		Vector3& operator=(const Vector3& vec);
-
 		Vector2 to2D() const;
 
 		Vector4 to4D(float w = 1.f) const;
@@ -38,15 +34,30 @@ namespace avt {
 		// length squared
 		float quadrance() const;
 
-		Vector3 normalized() const;
+		// zero vectors are returned as they are
+		template<typename P = precision::Default>
+		Vector3 normalized() const {
+			Vector3 vec(*this);
+			return vec.normalize<P>();
+		}
 
-		Vector3& normalize();
+		template<typename P = precision::Default>
+		Vector3& normalize() {
+			float q = quadrance();
+			if (q == 0) return *this;
+			if (P::EXACT) return *this /= std::sqrt(q);
+			return *this *= P::rsqrt(q);
+		}
 
 		Vector3 pow(float exp) const;
 
 		float distanceTo(const Vector3& vec) const;
 
-		float angleTo(const Vector3& vec) const;
+		template<typename P = precision::Default>
+		float angleTo(const Vector3& vec) const {
+			if (P::EXACT) return std::acos(dot(vec) / (length() * vec.length()));
+			return P::acos(dot(vec) * P::rsqrt(quadrance() * vec.quadrance()));
+		}
 
 		Vector3 rotateOnAxis(const Vector3& axis, float rad) const;
 		
@@ -103,4 +114,7 @@ namespace avt {
 		static float quadProd(const Vector3& a, const Vector3& b, const Vector3& c, const Vector3& d);
 	};
 
+	static_assert(std::is_trivially_copyable<Vector3>::value, "Vector3 must stay a plain value type");
+	static_assert(sizeof(Vector3) == 3 * sizeof(float), "Vector3 must be 3 packed floats, the size of a ShaderDataType::VEC3");
+
 }
\ No newline at end of file
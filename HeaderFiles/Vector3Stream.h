@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstddef>
+
+#include "Vector3.h"
+#include "MathKernels.h"
+#include "SoAStorage.h"
+
+
+namespace avt {
+
+	class Mat4;
+
+	// Structure-of-arrays storage for many Vector3s: separate x, y and z arrays (see SoAStorage)
+	// so the batch kernels run on whole SIMD registers.
+	// Batch operations give the same results as calling the Vector3 members one element at a time.
+	class Vector3Stream {
+	private:
+		SoAStorage<3> _data;
+
+	public:
+		Vector3Stream() {}
+
+		explicit Vector3Stream(size_t size) {
+			_data.resize(size);
+		}
+
+		size_t size() const {
+			return _data.size();
+		}
+
+		size_t capacity() const {
+			return _data.capacity();
+		}
+
+		bool empty() const {
+			return _data.size() == 0;
+		}
+
+		// keeps the current elements, new ones are zero
+		void resize(size_t size) {
+			_data.resize(size);
+		}
+
+		void reserve(size_t capacity) {
+			_data.reserve(capacity);
+		}
+
+		void clear() {
+			_data.clear();
+		}
+
+		void push_back(const Vector3& vec) {
+			set(_data.grow(), vec);
+		}
+
+		Vector3 operator[](size_t i) const {
+			return Vector3(_data[0][i], _data[1][i], _data[2][i]);
+		}
+
+		void set(size_t i, const Vector3& vec) {
+			_data[0][i] = vec.x;
+			_data[1][i] = vec.y;
+			_data[2][i] = vec.z;
+		}
+
+		float* x() { return _data[0]; }
+		float* y() { return _data[1]; }
+		float* z() { return _data[2]; }
+		const float* x() const { return _data[0]; }
+		const float* y() const { return _data[1]; }
+		const float* z() const { return _data[2]; }
+
+		// kernels take mutable pointers, const methods only pass this to read-only inputs
+		Vec3SoA view() const {
+			return { const_cast<float*>(_data[0]), const_cast<float*>(_data[1]), const_cast<float*>(_data[2]) };
+		}
+
+		// AoS <-> SoA: count vectors whose xyz start at xyz and sit stride bytes apart,
+		// e.g. gather(&vertices[0].normal.x, vertices.size(), sizeof(Vertex))
+		void gather(const float* xyz, size_t count, size_t stride);
+
+		void scatter(float* xyz, size_t stride) const;
+
+		Vector3Stream& operator+=(const Vector3Stream& stream);
+
+		Vector3Stream& operator-=(const Vector3Stream& stream);
+
+		// out[i] = this[i].dot(stream[i]), out holds size() floats
+		void dot(const Vector3Stream& stream, float* out) const;
+
+		// out[i] = this[i].cross(stream[i]), out is resized (and may be *this)
+		void cross(const Vector3Stream& stream, Vector3Stream& out) const;
+
+		// out holds size() floats
+		void length(float* out) const;
+
+		Vector3Stream& normalize();
+
+		// every element as a point (w = 1)
+		Vector3Stream& transform(const Mat4& mat);
+
+		// every element as a direction (w = 0)
+		Vector3Stream& transformVectors(const Mat4& mat);
+
+		// component-wise min and max reduction, both zero when empty
+		void bounds(Vector3& outMin, Vector3& outMax) const;
+	};
+
+}
\ No newline at end of file
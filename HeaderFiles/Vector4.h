@@ -1,6 +1,7 @@
 #pragma once
 
 #include <iostream>
+#include <type_traits>
 #include <math.h>
 #include <GL/glew.h>
 
@@ -14,20 +15,13 @@ namespace avt {
 	public:
 		float x, y, z, w;
 
-		Vector4(float x = 0, float y = 0, float z = 0, float w = 0)
+		constexpr Vector4(float x = 0, float y = 0, float z = 0, float w = 0)
 			: x(x), y(y), z(z), w(w) {}
 
-		Vector4(const Vector4& vec)
-			: x(vec.x), y(vec.y), z(vec.z), w(vec.w) {}
-
 		Vector4(const Vector2& vec, float z = 0, float w = 0);
 
 		Vector4(const Vector3& vec, float w = 0);
 
-		~Vector4() {}
-
-		Vector4& operator=(const Vector4& vec);
-
 		Vector2 to2D() const;
 
 		Vector3 to3D() const;
@@ -98,6 +92,9 @@ namespace avt {
 		}
 	};
 
+	static_assert(std::is_trivially_copyable<Vector4>::value, "Vector4 must stay a plain value type");
+	static_assert(sizeof(Vector4) == 4 * sizeof(float), "Vector4 must be 4 packed floats, the size of a ShaderDataType::VEC4");
+
 }
 
 
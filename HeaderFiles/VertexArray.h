@@ -7,6 +7,7 @@
 #include "../HeaderFiles/VertexBuffer.h"
 #include "../HeaderFiles/IndexBuffer.h"
 #include "../HeaderFiles/VertexBufferLayout.h"
+#include "../HeaderFiles/GLState.h"
 
 namespace avt {
 
@@ -17,11 +18,16 @@ namespace avt {
 		std::vector<std::shared_ptr<VertexBuffer>> _vbs;
 		std::shared_ptr<IndexBuffer> _ib;
 
+		// where the per-instance model matrix points, see setInstanceMatrices
+		const VertexBuffer* _instanceVB = nullptr;
+		GLuint _instanceLocation = 0;
+		GLsizei _instanceFirst = 0;
+
 	public:
 		VertexArray() : _vaoID(0), _attribNum(0) {
 			glGenVertexArrays(1, &_vaoID);
-			glBindVertexArray(_vaoID);
-			glBindVertexArray(0);
+			GLState::bindVertexArray(_vaoID);
+			GLState::bindVertexArray(0);
 
 #ifndef ERROR_CALLBACK
 			ErrorManager::checkOpenGLError("ERROR: Could not create Vertex Array.");
@@ -34,6 +40,10 @@ namespace avt {
 		
 		void setIndexBuffer(const std::shared_ptr<IndexBuffer>& ib);
 
+		// points a per-instance mat4 at locations [location, location + 3] to vb's matrices from
+		// first on. The vertex array must be bound; nothing is called when it already points there
+		void setInstanceMatrices(const VertexBuffer& vb, GLuint location, GLsizei first = 0);
+
 		bool indexed() const {
 			return _ib.get() != nullptr;
 		}
@@ -47,11 +57,11 @@ namespace avt {
 		}
 
 		void bind() const {
-			glBindVertexArray(_vaoID);
+			GLState::bindVertexArray(_vaoID);
 		}
 
 		void unbind() const {
-			glBindVertexArray(0);
+			GLState::bindVertexArray(0);
 		}
 	};
 
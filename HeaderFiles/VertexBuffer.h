@@ -2,7 +2,9 @@
 
 #include <GL/glew.h>
 #include <vector>
+#include <type_traits>
 #include "ErrorManager.h"
+#include "GLState.h"
 #include "VertexBufferLayout.h"
 
 namespace avt{
@@ -19,7 +21,7 @@ namespace avt{
 		VertexBuffer(const void* data, GLsizeiptr size)
 			: _vboID(0), _size(data ? (GLsizei)size : 0), _capacity((GLsizei)size) {
 			glGenBuffers(1, &_vboID);
-			glBindBuffer(GL_ARRAY_BUFFER, _vboID);
+			GLState::bindBuffer(GL_ARRAY_BUFFER, _vboID);
 			glBufferData(GL_ARRAY_BUFFER, size, data, GL_STATIC_DRAW);
 
 #ifndef ERROR_CALLBACK
@@ -35,11 +37,15 @@ namespace avt{
 		// vector constructors
 		template<typename T>
 		VertexBuffer(const std::vector<T>& vertices)
-			: VertexBuffer(vertices.data(), vertices.size() * sizeof(T)) {}
+			: VertexBuffer(vertices.data(), vertices.size() * sizeof(T)) {
+			static_assert(std::is_trivially_copyable<T>::value, "vertex data is uploaded byte for byte");
+		}
 
 		template<typename T>
 		VertexBuffer(const std::vector<T>& vertices, const VertexBufferLayout& layout)
-			: VertexBuffer(vertices.data(), vertices.size() * sizeof(T), layout) {}
+			: VertexBuffer(vertices.data(), vertices.size() * sizeof(T), layout) {
+			static_assert(std::is_trivially_copyable<T>::value, "vertex data is uploaded byte for byte");
+		}
 
 		// empty content constructors
 		VertexBuffer(GLsizeiptr capacity)
@@ -52,7 +58,8 @@ namespace avt{
 
 		~VertexBuffer() {
 			glDeleteBuffers(1, &_vboID);
-			glBindBuffer(GL_ARRAY_BUFFER, 0);
+			GLState::deleteBuffer(_vboID);
+			GLState::bindBuffer(GL_ARRAY_BUFFER, 0);
 
 #ifndef ERROR_CALLBACK
 			ErrorManager::checkOpenGLError("ERROR: Could not destroy Vertex Buffer.");
@@ -60,11 +67,11 @@ namespace avt{
 		}
 
 		void bind() const {
-			glBindBuffer(GL_ARRAY_BUFFER, _vboID);
+			GLState::bindBuffer(GL_ARRAY_BUFFER, _vboID);
 		}
 
 		void unbind() const {
-			glBindBuffer(GL_ARRAY_BUFFER, 0);
+			GLState::bindBuffer(GL_ARRAY_BUFFER, 0);
 		}
 
 		void upload(const void* data, GLsizeiptr size) {
@@ -74,7 +81,7 @@ namespace avt{
 				return;
 			}
 
-			glBindBuffer(GL_ARRAY_BUFFER, _vboID);
+			GLState::bindBuffer(GL_ARRAY_BUFFER, _vboID);
 			glBufferSubData(GL_ARRAY_BUFFER, 0, size, data);
 			_size = (GLsizei)size;
 
@@ -85,6 +92,7 @@ namespace avt{
 
 		template<typename T>
 		void upload(const std::vector<T>& vertices) {
+			static_assert(std::is_trivially_copyable<T>::value, "vertex data is uploaded byte for byte");
 			upload(vertices.data(), vertices.size() * sizeof(T));
 		}
 
@@ -96,11 +104,11 @@ namespace avt{
 				// create aux buffer
 				GLuint auxID;
 				glGenBuffers(1, &auxID);
-				glBindBuffer(GL_COPY_WRITE_BUFFER, auxID);
+				GLState::bindBuffer(GL_COPY_WRITE_BUFFER, auxID);
 				glBufferData(GL_COPY_WRITE_BUFFER, _size, nullptr, GL_STATIC_DRAW);
 
 				// copy data to aux
-				glBindBuffer(GL_ARRAY_BUFFER, _vboID);
+				GLState::bindBuffer(GL_ARRAY_BUFFER, _vboID);
 				glCopyBufferSubData(GL_ARRAY_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, _size);
 
 				// re-allocate vb and copy data from aux
@@ -109,9 +117,10 @@ namespace avt{
 
 				// delete aux buffer
 				glDeleteBuffers(1, &auxID);
-				glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+				GLState::deleteBuffer(auxID);
+				GLState::bindBuffer(GL_COPY_WRITE_BUFFER, 0);
 			} else {
-				glBindBuffer(GL_ARRAY_BUFFER, _vboID);
+				GLState::bindBuffer(GL_ARRAY_BUFFER, _vboID);
 				glBufferData(GL_ARRAY_BUFFER, capacity, nullptr, GL_STATIC_DRAW);
 				_size = 0;
 			}
@@ -122,6 +131,26 @@ namespace avt{
 #endif
 		}
 
+		// size bytes of src from srcOffset on into this buffer at dstOffset, without a trip through the cpu
+		void copy(const VertexBuffer& src, GLintptr srcOffset, GLintptr dstOffset, GLsizeiptr size) {
+			if (size <= 0) return;
+			if (dstOffset + size > _capacity) {
+				std::cerr << "Vertex Buffer copy FAIL: data size larger than buffer size." << std::endl;
+				return;
+			}
+
+			GLState::bindBuffer(GL_COPY_READ_BUFFER, src._vboID);
+			GLState::bindBuffer(GL_COPY_WRITE_BUFFER, _vboID);
+			glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, srcOffset, dstOffset, size);
+			GLState::bindBuffer(GL_COPY_READ_BUFFER, 0);
+			GLState::bindBuffer(GL_COPY_WRITE_BUFFER, 0);
+			if (dstOffset + size > _size) _size = (GLsizei)(dstOffset + size);
+
+#ifndef ERROR_CALLBACK
+			ErrorManager::checkOpenGLError("ERROR: Could not copy data to Vertex Buffer.");
+#endif
+		}
+
 		void clear() {
 			_size = 0;
 		}
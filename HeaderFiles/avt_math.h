@@ -11,6 +11,10 @@
 
 #include "Quaternion.h"
 
+#include "Affine.h"
+
+#include "Geometry.h"
+
 #define max(a, b) (a > b ? a : b)
 #define min(a, b) (a > b ? b : a)
 #define clamp(v, b1, b2) min(max(v, b1), b2)
@@ -63,4 +67,14 @@ namespace avt {
 	// Quaternions
 	struct Quaternion;
 
+	// Transforms
+	class Affine;
+
+	// Bounding volumes
+	struct Plane;
+	struct Sphere;
+	struct AABB;
+	class Frustum;
+	struct Ray;
+
 }
\ No newline at end of file
@@ -6,10 +6,9 @@ in vec2 inTexcoord;
 in vec3 inNormal;
 in vec3 inColor;
 
-uniform mat4 lightSpaceMatrix;
-uniform mat4 ModelMatrix;
+uniform mat4 LightSpaceMatrix; // ShaderParams::useLightSpaceMatrix, light projection * view * model premultiplied per object
 
 void main(void)
 {
-    gl_Position = lightSpaceMatrix * ModelMatrix * vec4(inPosition, 1.0);
+    gl_Position = LightSpaceMatrix * vec4(inPosition, 1.0);
 } 
\ No newline at end of file
@@ -21,7 +21,8 @@ out vec4 FragPosLightSpace5;
 out vec4 FragPosLightSpace6;
 
 //UNIFORMS
-uniform mat4 ModelMatrix;
+uniform mat4 ModelMatrix; // ShaderParams::useModelMatrix
+uniform mat3 NormalMatrix; // ShaderParams::useNormalMatrix, inverse transpose of the model matrix
 uniform mat4 campfireLSM1;
 uniform mat4 campfireLSM2;
 uniform mat4 campfireLSM3;
@@ -41,7 +42,7 @@ void main(void)
 {
 	exPosition = inPosition;
 	exTexcoord = inTexcoord;
-	exNormal = transpose(inverse(mat3(ModelMatrix))) * inNormal;
+	exNormal = NormalMatrix * inNormal;
 	exColor = inColor;
 
 	vec4 MCPosition = vec4(inPosition, 1.0);
@@ -0,0 +1,210 @@
+#include "../HeaderFiles/Affine.h"
+
+
+namespace avt {
+
+	Affine Affine::operator*(const Affine& aff) const {
+		const float* a = _cells;
+		const float* b = aff._cells;
+		Affine newA;
+		float* r = newA._cells;
+
+		// linear part: 27 multiplies
+		for (int col = 0; col < 3; col++) {
+			const float* bc = b + 3 * col;
+			r[3 * col + 0] = a[0] * bc[0] + a[3] * bc[1] + a[6] * bc[2];
+			r[3 * col + 1] = a[1] * bc[0] + a[4] * bc[1] + a[7] * bc[2];
+			r[3 * col + 2] = a[2] * bc[0] + a[5] * bc[1] + a[8] * bc[2];
+		}
+
+		// translation: 9 multiplies
+		r[9] = a[0] * b[9] + a[3] * b[10] + a[6] * b[11] + a[9];
+		r[10] = a[1] * b[9] + a[4] * b[10] + a[7] * b[11] + a[10];
+		r[11] = a[2] * b[9] + a[5] * b[10] + a[8] * b[11] + a[11];
+
+		return newA;
+	}
+
+	Affine& Affine::operator*=(const Affine& aff) {
+		return *this = *this * aff;
+	}
+
+	Vector3 Affine::operator*(const Vector3& vec) const {
+		return Vector3(
+			_cells[0] * vec.x + _cells[3] * vec.y + _cells[6] * vec.z + _cells[9],
+			_cells[1] * vec.x + _cells[4] * vec.y + _cells[7] * vec.z + _cells[10],
+			_cells[2] * vec.x + _cells[5] * vec.y + _cells[8] * vec.z + _cells[11]);
+	}
+
+	Vector3 Affine::transformVector(const Vector3& vec) const {
+		return Vector3(
+			_cells[0] * vec.x + _cells[3] * vec.y + _cells[6] * vec.z,
+			_cells[1] * vec.x + _cells[4] * vec.y + _cells[7] * vec.z,
+			_cells[2] * vec.x + _cells[5] * vec.y + _cells[8] * vec.z);
+	}
+
+	bool Affine::operator==(const Affine& aff) const {
+		for (int i = 0; i < 12; i++) {
+			if (_cells[i] != aff._cells[i])
+				return false;
+		}
+
+		return true;
+	}
+
+	bool Affine::operator!=(const Affine& aff) const {
+		return !(*this == aff);
+	}
+
+	std::ostream& operator<<(std::ostream& os, const Affine& aff) {
+		os << "[[" << aff[0] << ", " << aff[3] << ", " << aff[6] << ", " << aff[9] << "]" << std::endl
+			<< " [" << aff[1] << ", " << aff[4] << ", " << aff[7] << ", " << aff[10] << "]" << std::endl
+			<< " [" << aff[2] << ", " << aff[5] << ", " << aff[8] << ", " << aff[11] << "]]";
+
+		return os;
+	}
+
+	float Affine::det() const {
+		return _cells[0] * (_cells[4] * _cells[8] - _cells[7] * _cells[5])
+			- _cells[3] * (_cells[1] * _cells[8] - _cells[7] * _cells[2])
+			+ _cells[6] * (_cells[1] * _cells[5] - _cells[4] * _cells[2]);
+	}
+
+	Affine& Affine::invert() {
+		return *this = inverted();
+	}
+
+	// inverse of the 3x3 block by cofactors, then t' = -(L^-1 * t)
+	Affine Affine::inverted() const {
+		float dt = det();
+		if (dt == 0) return *this;
+
+		float multiplier = 1 / dt;
+		const float* c = _cells;
+
+		Affine newA;
+		float* r = newA._cells;
+		r[0] = (c[4] * c[8] - c[7] * c[5]) * multiplier;
+		r[1] = -(c[1] * c[8] - c[7] * c[2]) * multiplier;
+		r[2] = (c[1] * c[5] - c[4] * c[2]) * multiplier;
+		r[3] = -(c[3] * c[8] - c[6] * c[5]) * multiplier;
+		r[4] = (c[0] * c[8] - c[6] * c[2]) * multiplier;
+		r[5] = -(c[0] * c[5] - c[3] * c[2]) * multiplier;
+		r[6] = (c[3] * c[7] - c[6] * c[4]) * multiplier;
+		r[7] = -(c[0] * c[7] - c[6] * c[1]) * multiplier;
+		r[8] = (c[0] * c[4] - c[3] * c[1]) * multiplier;
+
+		r[9] = -(r[0] * c[9] + r[3] * c[10] + r[6] * c[11]);
+		r[10] = -(r[1] * c[9] + r[4] * c[10] + r[7] * c[11]);
+		r[11] = -(r[2] * c[9] + r[5] * c[10] + r[8] * c[11]);
+
+		return newA;
+	}
+
+	// the cofactor matrix over the determinant: columns are c1 x c2, c2 x c0, c0 x c1
+	Mat3 Affine::normalMatrix() const {
+		const float* c = _cells;
+		float dt = det();
+		if (dt == 0) return Mat3{ c[0], c[1], c[2], c[3], c[4], c[5], c[6], c[7], c[8] };
+
+		float multiplier = 1 / dt;
+		return Mat3{
+			(c[4] * c[8] - c[5] * c[7]) * multiplier,
+			(c[5] * c[6] - c[3] * c[8]) * multiplier,
+			(c[3] * c[7] - c[4] * c[6]) * multiplier,
+			(c[7] * c[2] - c[8] * c[1]) * multiplier,
+			(c[8] * c[0] - c[6] * c[2]) * multiplier,
+			(c[6] * c[1] - c[7] * c[0]) * multiplier,
+			(c[1] * c[5] - c[2] * c[4]) * multiplier,
+			(c[2] * c[3] - c[0] * c[5]) * multiplier,
+			(c[0] * c[4] - c[1] * c[3]) * multiplier
+		};
+	}
+
+	Mat4 Affine::toMat4() const {
+		Mat4 mat;
+		toMat4(mat.data());
+		return mat;
+	}
+
+	void Affine::toMat4(float* out) const {
+		out[0] = _cells[0];
+		out[1] = _cells[1];
+		out[2] = _cells[2];
+		out[3] = 0.0f;
+
+		out[4] = _cells[3];
+		out[5] = _cells[4];
+		out[6] = _cells[5];
+		out[7] = 0.0f;
+
+		out[8] = _cells[6];
+		out[9] = _cells[7];
+		out[10] = _cells[8];
+		out[11] = 0.0f;
+
+		out[12] = _cells[9];
+		out[13] = _cells[10];
+		out[14] = _cells[11];
+		out[15] = 1.0f;
+	}
+
+	Affine Affine::fromTRS(const Vector3& t, const Quaternion& r, const Vector3& s) {
+		Quaternion qn = r.normalized();
+
+		float xx = qn.x * qn.x;
+		float xy = qn.x * qn.y;
+		float xz = qn.x * qn.z;
+		float xt = qn.x * qn.t;
+		float yy = qn.y * qn.y;
+		float yz = qn.y * qn.z;
+		float yt = qn.y * qn.t;
+		float zz = qn.z * qn.z;
+		float zt = qn.z * qn.t;
+
+		Affine aff;
+		float* c = aff._cells;
+
+		c[0] = (1.0f - 2.0f * (yy + zz)) * s.x;
+		c[1] = 2.0f * (xy + zt) * s.x;
+		c[2] = 2.0f * (xz - yt) * s.x;
+
+		c[3] = 2.0f * (xy - zt) * s.y;
+		c[4] = (1.0f - 2.0f * (xx + zz)) * s.y;
+		c[5] = 2.0f * (yz + xt) * s.y;
+
+		c[6] = 2.0f * (xz + yt) * s.z;
+		c[7] = 2.0f * (yz - xt) * s.z;
+		c[8] = (1.0f - 2.0f * (xx + yy)) * s.z;
+
+		c[9] = t.x;
+		c[10] = t.y;
+		c[11] = t.z;
+
+		return aff;
+	}
+
+	Affine Affine::fromMat4(const Mat4& mat) {
+		Affine aff;
+		float* c = aff._cells;
+
+		c[0] = mat[0];
+		c[1] = mat[1];
+		c[2] = mat[2];
+
+		c[3] = mat[4];
+		c[4] = mat[5];
+		c[5] = mat[6];
+
+		c[6] = mat[8];
+		c[7] = mat[9];
+		c[8] = mat[10];
+
+		c[9] = mat[12];
+		c[10] = mat[13];
+		c[11] = mat[14];
+
+		return aff;
+	}
+
+}
@@ -0,0 +1,39 @@
+#include "../HeaderFiles/BoundsStream.h"
+
+
+namespace avt {
+
+	size_t AABBStream::cull(const Frustum& frustum, uint8_t* visible) const {
+		if (empty()) return 0;
+		return MathKernels::get().frustumAABB(frustum.data(), centers(), extents(), visible, size());
+	}
+
+	void AABBStream::raycast(const Ray& ray, float* t) const {
+		if (empty()) return;
+
+		float packed[7];
+		ray.pack(packed, true);
+		MathKernels::get().rayAABB(packed, centers(), extents(), t, size());
+	}
+
+	AABBStream& AABBStream::transform(const Affine& aff) {
+		if (empty()) return *this;
+		MathKernels::get().aabbTransform(aff.data(), 0, centers(), extents(), centers(), extents(), size());
+		return *this;
+	}
+
+	void AABBStream::transform(const Affine* affs, AABBStream& out) const {
+		if (&out != this) {
+			out.clear();
+			out.resize(size());
+		}
+		if (empty()) return;
+		MathKernels::get().aabbTransform(affs[0].data(), 12, centers(), extents(), out.centers(), out.extents(), size());
+	}
+
+	size_t SphereStream::cull(const Frustum& frustum, uint8_t* visible) const {
+		if (empty()) return 0;
+		return MathKernels::get().frustumSphere(frustum.data(), centers(), radii(), visible, size());
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,65 @@
+#include "../HeaderFiles/CommandBackend.h"
+
+#include "../HeaderFiles/Mesh.h"
+
+
+namespace avt {
+
+	void CommandBackend::execute(const CommandBuffer& buffer) {
+		begin(buffer);
+		for (const CommandBuffer::Command& c : buffer.commands()) {
+			switch (c.op) {
+			case CommandBuffer::Op::BindPipeline:	bindPipeline(c.material); break;
+			case CommandBuffer::Op::BindMesh:		bindMesh(c.mesh); break;
+			case CommandBuffer::Op::SetTransforms:	setTransforms(c.first, c.count); break;
+			case CommandBuffer::Op::Draw:			draw(c.mode, c.count); break;
+			}
+		}
+		end();
+	}
+
+
+	void HeadlessBackend::begin(const CommandBuffer& buffer) {
+		_buffer = &buffer;
+		_material = nullptr;
+		_mesh = nullptr;
+		_first = _count = 0;
+		_stats.buffers++;
+		_stats.commands += buffer.size();
+	}
+
+	void HeadlessBackend::bindPipeline(Material* material) {
+		_material = material;
+		_stats.pipelineBinds++;
+	}
+
+	void HeadlessBackend::bindMesh(Mesh* mesh) {
+		_mesh = mesh;
+		_stats.meshBinds++;
+	}
+
+	void HeadlessBackend::setTransforms(uint32_t first, uint32_t count) {
+		_first = first;
+		_count = count;
+	}
+
+	// the model matrix is made as the GL backend makes it before upload
+	void HeadlessBackend::draw(DrawMode, uint32_t instances) {
+		if (!_material || !_mesh || instances > _count || _first + _count > _buffer->transforms().size()) {
+			_stats.invalid++;
+			return;
+		}
+
+		const Affine* worlds = _buffer->transforms().data() + _first;
+		float model[16];
+		for (uint32_t i = 0; i < instances; i++) {
+			worlds[i].toMat4(model);
+			_checksum += model[12] + model[13] + model[14];
+		}
+
+		_stats.draws++;
+		_stats.instances += instances;
+		_stats.vertices += static_cast<size_t>(_mesh->vertexCount()) * instances;
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,51 @@
+#include "../HeaderFiles/CommandBuffer.h"
+
+#include "../HeaderFiles/RenderQueue.h"
+#include "../HeaderFiles/Shader.h"
+
+
+namespace avt {
+
+	void CommandBuffer::setTransforms(const Affine* worlds, size_t count) {
+		uint32_t first = static_cast<uint32_t>(_transforms.size());
+		_transforms.insert(_transforms.end(), worlds, worlds + count);
+		_commands.push_back({ Op::SetTransforms, DrawMode::Triangles, 0, first, static_cast<uint32_t>(count), nullptr, nullptr });
+	}
+
+	void CommandBuffer::record(const RenderQueue& queue) {
+		record(queue, 0, queue.size());
+	}
+
+	void CommandBuffer::record(const RenderQueue& queue, size_t begin, size_t end) {
+		Material* material = nullptr;
+		Mesh* mesh = nullptr;
+
+		for (size_t i = begin; i < end;) {
+			const RenderQueue::Item& item = queue[i];
+			if (item.material != material) {
+				material = item.material;
+				bindPipeline(material, static_cast<uint16_t>(queue.materialId(i)));
+			}
+			if (item.mesh != mesh) {
+				mesh = item.mesh;
+				bindMesh(mesh);
+			}
+
+			size_t runEnd = i + 1;
+			if (item.shader->instanced() || item.shader->usesObjectBuffer()) {
+				while (runEnd < end && queue[runEnd].material == material && queue[runEnd].mesh == mesh && queue[runEnd].mode == item.mode) runEnd++;
+			}
+
+			uint32_t first = static_cast<uint32_t>(_transforms.size());
+			for (size_t k = i; k < runEnd; k++) {
+				_transforms.push_back(queue[k].world);
+			}
+			uint32_t count = static_cast<uint32_t>(runEnd - i);
+			_commands.push_back({ Op::SetTransforms, DrawMode::Triangles, 0, first, count, nullptr, nullptr });
+			draw(item.mode, count);
+
+			i = runEnd;
+		}
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,402 @@
+#include "../HeaderFiles/DynamicBVH.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+
+namespace avt {
+
+	constexpr uint32_t DynamicBVH::NONE;
+
+	// top-down binned SAH over a copy of the leaves, touches nothing of the tree it will replace
+	struct DynamicBVH::Rebuild {
+		struct Item {
+			AABB box;
+			Vector3 centroid;
+			Proxy proxy;
+		};
+
+		static const int BINS = 16;
+
+		std::vector<Item> items;
+		std::vector<Node> nodes;
+		std::vector<uint32_t> leafOf; // per proxy
+		uint32_t root = NONE;
+
+		std::thread thread;
+		std::atomic<bool> done{ false };
+
+		void run() {
+			nodes.reserve(items.empty() ? 0 : 2 * items.size() - 1);
+			if (!items.empty()) root = build(0, items.size(), NONE);
+			done = true;
+		}
+
+		uint32_t build(size_t begin, size_t end, uint32_t parent) {
+			uint32_t n = static_cast<uint32_t>(nodes.size());
+			nodes.push_back({ AABB(), parent, { NONE, NONE }, NONE, 0 });
+
+			if (end - begin == 1) {
+				nodes[n].box = items[begin].box;
+				nodes[n].proxy = items[begin].proxy;
+				leafOf[items[begin].proxy] = n;
+				return n;
+			}
+
+			AABB box, centroids;
+			for (size_t i = begin; i < end; i++) {
+				box.expand(items[i].box);
+				centroids.expand(items[i].centroid);
+			}
+			nodes[n].box = box;
+
+			Vector3 size = centroids.upper - centroids.lower;
+			int axis = size.x >= size.y && size.x >= size.z ? 0 : (size.y >= size.z ? 1 : 2);
+			float lower = (&centroids.lower.x)[axis], extent = (&size.x)[axis];
+
+			size_t mid = begin;
+			if (extent > 0) {
+				float scale = BINS / extent;
+				auto binOf = [&](const Item& item) {
+					int b = static_cast<int>(((&item.centroid.x)[axis] - lower) * scale);
+					return b < BINS - 1 ? b : BINS - 1;
+				};
+
+				AABB bins[BINS];
+				size_t counts[BINS] = {};
+				for (size_t i = begin; i < end; i++) {
+					int b = binOf(items[i]);
+					bins[b].expand(items[i].box);
+					counts[b]++;
+				}
+
+				// area of bins [s, BINS) for every split s, then sweep from the left
+				float rightArea[BINS];
+				AABB right;
+				for (int s = BINS - 1; s > 0; s--) {
+					right.expand(bins[s]);
+					rightArea[s] = area(right);
+				}
+
+				AABB left;
+				size_t leftCount = 0;
+				float bestCost = 0;
+				int best = 0;
+				for (int s = 1; s < BINS; s++) {
+					left.expand(bins[s - 1]);
+					leftCount += counts[s - 1];
+					float cost = leftCount * area(left) + (end - begin - leftCount) * rightArea[s];
+					if (leftCount && leftCount < end - begin && (!best || cost < bestCost)) {
+						bestCost = cost;
+						best = s;
+					}
+				}
+
+				if (best) {
+					mid = std::partition(items.begin() + begin, items.begin() + end,
+						[&](const Item& item) { return binOf(item) < best; }) - items.begin();
+				}
+			}
+
+			// every centroid in one bin: halves by count
+			if (mid == begin || mid == end) {
+				mid = begin + (end - begin) / 2;
+				std::nth_element(items.begin() + begin, items.begin() + mid, items.begin() + end,
+					[axis](const Item& a, const Item& b) { return (&a.centroid.x)[axis] < (&b.centroid.x)[axis]; });
+			}
+
+			uint32_t c0 = build(begin, mid, n);
+			uint32_t c1 = build(mid, end, n);
+			nodes[n].child[0] = c0;
+			nodes[n].child[1] = c1;
+			return n;
+		}
+	};
+
+	DynamicBVH::DynamicBVH() {}
+
+	DynamicBVH::~DynamicBVH() {
+		if (_rebuild) _rebuild->thread.join();
+	}
+
+	void DynamicBVH::clear() {
+		if (_rebuild) {
+			_rebuild->thread.join();
+			_rebuild.reset();
+		}
+		_nodes.clear();
+		_freeNodes.clear();
+		_root = NONE;
+		_box.clear();
+		_value.clear();
+		_leaf.clear();
+		_freeProxies.clear();
+		_changed.clear();
+		_area = 0;
+		_leaves = 0;
+		_built = false;
+		_stats = Stats();
+	}
+
+	uint32_t DynamicBVH::allocate() {
+		uint32_t n;
+		if (!_freeNodes.empty()) {
+			n = _freeNodes.back();
+			_freeNodes.pop_back();
+		} else {
+			n = static_cast<uint32_t>(_nodes.size());
+			_nodes.emplace_back();
+		}
+		_nodes[n] = { AABB(), NONE, { NONE, NONE }, NONE, 0 };
+		return n;
+	}
+
+	void DynamicBVH::setBox(uint32_t n, const AABB& box) {
+		if (!isLeaf(n)) _area += area(box) - area(_nodes[n].box);
+		_nodes[n].box = box;
+	}
+
+	// every ancestor of a marked node is marked, so the walk stops at the first one
+	void DynamicBVH::markPath(uint32_t n) {
+		for (; n != NONE && !_nodes[n].dirty; n = _nodes[n].parent) {
+			_nodes[n].dirty = 1;
+		}
+	}
+
+	// the sibling search of Box2D's dynamic tree: stop where pairing with the node itself costs less
+	// than the cheaper child plus the area every ancestor on the way has to grow by
+	void DynamicBVH::insertLeaf(uint32_t leaf) {
+		const AABB box = _nodes[leaf].box;
+		if (_root == NONE) {
+			_root = leaf;
+			_nodes[leaf].parent = NONE;
+			return;
+		}
+
+		uint32_t s = _root;
+		while (!isLeaf(s)) {
+			const Node& node = _nodes[s];
+			float combined = area(merge(node.box, box));
+			float cost = 2.0f * combined;
+			float inherited = 2.0f * (combined - area(node.box));
+
+			float childCost[2];
+			for (int i = 0; i < 2; i++) {
+				const AABB& childBox = _nodes[node.child[i]].box;
+				float grown = area(merge(childBox, box));
+				childCost[i] = (isLeaf(node.child[i]) ? grown : grown - area(childBox)) + inherited;
+			}
+			if (cost < childCost[0] && cost < childCost[1]) break;
+			s = childCost[0] <= childCost[1] ? node.child[0] : node.child[1];
+		}
+
+		uint32_t above = _nodes[s].parent;
+		uint32_t p = allocate();
+		_nodes[p].parent = above;
+		_nodes[p].child[0] = s;
+		_nodes[p].child[1] = leaf;
+		_nodes[p].dirty = _nodes[s].dirty;
+		setBox(p, merge(_nodes[s].box, box));
+		_nodes[s].parent = p;
+		_nodes[leaf].parent = p;
+
+		if (above == NONE) _root = p;
+		else _nodes[above].child[_nodes[above].child[0] == s ? 0 : 1] = p;
+
+		for (uint32_t a = above; a != NONE; a = _nodes[a].parent) {
+			setBox(a, merge(_nodes[_nodes[a].child[0]].box, _nodes[_nodes[a].child[1]].box));
+		}
+	}
+
+	void DynamicBVH::removeLeaf(uint32_t leaf) {
+		_freeNodes.push_back(leaf);
+		if (leaf == _root) {
+			_root = NONE;
+			return;
+		}
+
+		uint32_t p = _nodes[leaf].parent;
+		uint32_t above = _nodes[p].parent;
+		uint32_t sibling = _nodes[p].child[_nodes[p].child[0] == leaf ? 1 : 0];
+
+		_nodes[sibling].parent = above;
+		if (above == NONE) _root = sibling;
+		else _nodes[above].child[_nodes[above].child[0] == p ? 0 : 1] = sibling;
+
+		_area -= area(_nodes[p].box);
+		_freeNodes.push_back(p);
+
+		for (uint32_t a = above; a != NONE; a = _nodes[a].parent) {
+			setBox(a, merge(_nodes[_nodes[a].child[0]].box, _nodes[_nodes[a].child[1]].box));
+		}
+	}
+
+	DynamicBVH::Proxy DynamicBVH::insert(const AABB& box, uint32_t value) {
+		Proxy proxy;
+		if (!_freeProxies.empty()) {
+			proxy = _freeProxies.back();
+			_freeProxies.pop_back();
+		} else {
+			proxy = static_cast<Proxy>(_leaf.size());
+			_box.emplace_back();
+			_value.push_back(0);
+			_leaf.push_back(NONE);
+		}
+		_box[proxy] = box;
+		_value[proxy] = value;
+
+		uint32_t leaf = allocate();
+		_nodes[leaf].box = box;
+		_nodes[leaf].proxy = proxy;
+		_leaf[proxy] = leaf;
+		insertLeaf(leaf);
+		_leaves++;
+
+		if (_rebuild) _changed.push_back(proxy);
+		return proxy;
+	}
+
+	void DynamicBVH::remove(Proxy proxy) {
+		removeLeaf(_leaf[proxy]);
+		_leaf[proxy] = NONE;
+		_freeProxies.push_back(proxy);
+		_leaves--;
+
+		if (_rebuild) _changed.push_back(proxy);
+	}
+
+	void DynamicBVH::update(Proxy proxy, const AABB& box) {
+		uint32_t leaf = _leaf[proxy];
+		_box[proxy] = box;
+		_nodes[leaf].box = box;
+		markPath(_nodes[leaf].parent);
+
+		if (_rebuild) _changed.push_back(proxy);
+	}
+
+	// the marked nodes in depth-first order, then recomputed in reverse so children come first
+	void DynamicBVH::refitMarked() {
+		_stats.refitted = 0;
+		if (_root == NONE || !_nodes[_root].dirty) return;
+
+		_order.clear();
+		Stack<uint32_t> stack;
+		stack.push(_root);
+		while (!stack.empty()) {
+			uint32_t n = stack.pop();
+			_order.push_back(n);
+			for (uint32_t c : _nodes[n].child) {
+				if (_nodes[c].dirty) stack.push(c);
+			}
+		}
+
+		for (size_t i = _order.size(); i-- > 0;) {
+			Node& node = _nodes[_order[i]];
+			setBox(_order[i], merge(_nodes[node.child[0]].box, _nodes[node.child[1]].box));
+			node.dirty = 0;
+		}
+		_stats.refitted = _order.size();
+	}
+
+	double DynamicBVH::innerArea() const {
+		double sum = 0;
+		if (_root == NONE) return sum;
+
+		Stack<uint32_t> stack;
+		stack.push(_root);
+		while (!stack.empty()) {
+			const Node& node = _nodes[stack.pop()];
+			if (node.child[0] == NONE) continue;
+			sum += area(node.box);
+			stack.push(node.child[0]);
+			stack.push(node.child[1]);
+		}
+		return sum;
+	}
+
+	std::unique_ptr<DynamicBVH::Rebuild> DynamicBVH::snapshot() const {
+		std::unique_ptr<Rebuild> rebuild(new Rebuild());
+		rebuild->items.reserve(_leaves);
+		for (Proxy p = 0; p < _leaf.size(); p++) {
+			if (_leaf[p] != NONE) rebuild->items.push_back({ _box[p], _box[p].center(), p });
+		}
+		rebuild->leafOf.assign(_leaf.size(), NONE);
+		return rebuild;
+	}
+
+	// swaps the built tree in, then brings it to the current leaves: proxies touched since the
+	// snapshot are removed, moved or inserted as they are now
+	void DynamicBVH::adopt(Rebuild& rebuild) {
+		std::vector<uint32_t> live;
+		live.swap(_leaf);
+		_leaf.swap(rebuild.leafOf);
+		_leaf.resize(live.size(), NONE);
+
+		_nodes.swap(rebuild.nodes);
+		_freeNodes.clear();
+		_root = rebuild.root;
+		_area = innerArea();
+
+		// what the build reached, before the replay undoes some of it
+		float rootArea = _root == NONE ? 0 : area(_nodes[_root].box);
+		_stats.builtCost = rootArea > 0 ? static_cast<float>(_area / rootArea) : 0;
+		_built = true;
+
+		for (Proxy p : _changed) {
+			uint32_t leaf = _leaf[p];
+			if (live[p] == NONE) {
+				if (leaf == NONE) continue;
+				removeLeaf(leaf);
+				_leaf[p] = NONE;
+			} else if (leaf != NONE) {
+				_nodes[leaf].box = _box[p];
+				markPath(_nodes[leaf].parent);
+			} else {
+				leaf = allocate();
+				_nodes[leaf].box = _box[p];
+				_nodes[leaf].proxy = p;
+				_leaf[p] = leaf;
+				insertLeaf(leaf);
+			}
+		}
+		_changed.clear();
+		_stats.rebuilds++;
+	}
+
+	void DynamicBVH::refit() {
+		if (_rebuild && _rebuild->done) {
+			_rebuild->thread.join();
+			std::unique_ptr<Rebuild> rebuild = std::move(_rebuild);
+			adopt(*rebuild);
+		}
+
+		refitMarked();
+
+		float rootArea = _root == NONE ? 0 : area(_nodes[_root].box);
+		_stats.leaves = _leaves;
+		_stats.cost = rootArea > 0 ? static_cast<float>(_area / rootArea) : 0;
+
+		if (_rebuild || _rebuildRatio <= 0 || _leaves < MIN_REBUILD) return;
+		if (_built && _stats.cost <= _rebuildRatio * _stats.builtCost) return;
+
+		_rebuild = snapshot();
+		Rebuild* rebuild = _rebuild.get();
+		rebuild->thread = std::thread([rebuild] { rebuild->run(); });
+	}
+
+	void DynamicBVH::build() {
+		if (_rebuild) {
+			_rebuild->thread.join();
+			_rebuild.reset();
+			_changed.clear();
+		}
+
+		std::unique_ptr<Rebuild> rebuild = snapshot();
+		rebuild->run();
+		adopt(*rebuild);
+		_stats.leaves = _leaves;
+		_stats.cost = _stats.builtCost;
+	}
+
+}
\ No newline at end of file
@@ -109,19 +109,19 @@ namespace avt {
 		checkOpenGLInfo();
 #endif
 		glClearColor(0.5f, 0.5f, 0.5f, 1.0f);
-		glEnable(GL_DEPTH_TEST);
+		GLState::enable(GL_DEPTH_TEST);
 		glDepthFunc(GL_LEQUAL);
 		glDepthMask(GL_TRUE);
 		glDepthRange(0.0, 1.0);
 		glClearDepth(1.0);
 
-		glEnable(GL_BLEND);
+		GLState::enable(GL_BLEND);
 		glBlendEquation(GL_FUNC_ADD);
 		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-		glEnable(GL_MULTISAMPLE);
+		GLState::enable(GL_MULTISAMPLE);
 
-		glEnable(GL_CULL_FACE);
+		GLState::enable(GL_CULL_FACE);
 		glCullFace(GL_BACK);
 		glFrontFace(GL_CCW);
 		glViewport(0, 0, _winX, _winY);
@@ -153,6 +153,7 @@ namespace avt {
 			double time = glfwGetTime();
 			double elapsed_time = time - last_time;
 			last_time = time;
+			GLState::beginFrame();
 
 			glfwPollEvents();
 			glfwGetCursorPos(_win, &xcursor, &ycursor);
@@ -0,0 +1,124 @@
+#include "../HeaderFiles/EntityRegistry.h"
+
+#include <algorithm>
+
+#include "../HeaderFiles/Prefab.h"
+
+
+namespace avt {
+
+	//////// SHARED TABLE
+
+	namespace {
+		template<typename T>
+		bool byPointer(const std::pair<const T*, uint32_t>& a, const std::pair<const T*, uint32_t>& b) {
+			return a.first < b.first;
+		}
+	}
+
+	template<typename T>
+	uint32_t SharedTable<T>::acquire(const std::shared_ptr<T>& value) {
+		if (!value) return NONE;
+
+		std::pair<const T*, uint32_t> key(value.get(), 0);
+		auto it = std::lower_bound(_lookup.begin(), _lookup.end(), key, byPointer<T>);
+		if (it != _lookup.end() && it->first == value.get()) {
+			_uses[it->second]++;
+			return it->second;
+		}
+
+		if (!_free.empty()) {
+			key.second = _free.back();
+			_free.pop_back();
+			_values[key.second] = value;
+			_uses[key.second] = 1;
+		} else {
+			key.second = static_cast<uint32_t>(_values.size());
+			_values.push_back(value);
+			_uses.push_back(1);
+		}
+		_lookup.insert(it, key);
+		return key.second;
+	}
+
+	template<typename T>
+	void SharedTable<T>::release(uint32_t index) {
+		if (index == NONE || --_uses[index] > 0) return;
+
+		std::pair<const T*, uint32_t> key(_values[index].get(), index);
+		_lookup.erase(std::lower_bound(_lookup.begin(), _lookup.end(), key, byPointer<T>));
+		_values[index].reset();
+		_free.push_back(index);
+	}
+
+	template<typename T>
+	void SharedTable<T>::clear() {
+		_values.clear();
+		_uses.clear();
+		_free.clear();
+		_lookup.clear();
+	}
+
+	template class SharedTable<Renderable>;
+	template class SharedTable<const Prefab>;
+	template class SharedTable<const PrefabOverrides>;
+
+
+	//////// ENTITY REGISTRY
+
+	void EntityRegistry::setRenderable(Entity e, std::shared_ptr<Renderable> rend) {
+		// the new one first, so setting the same renderable again never frees its slot
+		uint32_t index = _renderables.acquire(rend);
+		if (_renderableIds.has(e)) _renderables.release(_renderableIds.get(e).index);
+
+		if (rend) _renderableIds.set(e, { index });
+		else _renderableIds.remove(e);
+	}
+
+	const std::shared_ptr<Renderable>& EntityRegistry::renderable(Entity e) const {
+		static const std::shared_ptr<Renderable> none;
+		const RenderableId* id = _renderableIds.find(e);
+		return id ? _renderables.at(id->index) : none;
+	}
+
+	void EntityRegistry::setPrefab(Entity e, std::shared_ptr<const Prefab> prefab, std::shared_ptr<const PrefabOverrides> overrides) {
+		PrefabInstance instance = { _prefabs.acquire(prefab), prefab ? _overrides.acquire(overrides) : SharedTable<const PrefabOverrides>::NONE };
+		if (const PrefabInstance* previous = _prefabInstances.find(e)) {
+			_prefabs.release(previous->prefab);
+			_overrides.release(previous->overrides);
+		}
+
+		if (prefab) _prefabInstances.set(e, instance);
+		else _prefabInstances.remove(e);
+	}
+
+	const std::shared_ptr<const Prefab>& EntityRegistry::prefab(Entity e) const {
+		static const std::shared_ptr<const Prefab> none;
+		const PrefabInstance* instance = _prefabInstances.find(e);
+		return instance ? _prefabs.at(instance->prefab) : none;
+	}
+
+	const std::shared_ptr<const PrefabOverrides>& EntityRegistry::prefabOverrides(Entity e) const {
+		static const std::shared_ptr<const PrefabOverrides> none;
+		const PrefabInstance* instance = _prefabInstances.find(e);
+		return instance && instance->overrides != SharedTable<const PrefabOverrides>::NONE ? _overrides.at(instance->overrides) : none;
+	}
+
+	void EntityRegistry::remove(Entity e) {
+		setRenderable(e, nullptr);
+		setPrefab(e, nullptr, nullptr);
+		_bounds.remove(e);
+		_picks.remove(e);
+	}
+
+	void EntityRegistry::clear() {
+		_renderableIds.clear();
+		_prefabInstances.clear();
+		_bounds.clear();
+		_picks.clear();
+		_renderables.clear();
+		_prefabs.clear();
+		_overrides.clear();
+	}
+
+}
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "../HeaderFiles/ErrorManager.h"
+#include "../HeaderFiles/GLState.h"
 
 
 namespace avt {
@@ -53,9 +54,9 @@ namespace avt {
 	void ErrorManager::setupErrorCallback() {
 		if (!_updated)
 			return;
-		glEnable(GL_DEBUG_OUTPUT);
+		GLState::enable(GL_DEBUG_OUTPUT);
 		glDebugMessageCallback(error, 0);
-		glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+		GLState::enable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
 		glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DONT_CARE, 0, 0, GL_TRUE);
 		glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DEBUG_SEVERITY_NOTIFICATION, 0, 0, GL_FALSE);
 		// params: source, type, severity, count, ids, enabled
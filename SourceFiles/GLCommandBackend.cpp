@@ -0,0 +1,124 @@
+#include "../HeaderFiles/GLCommandBackend.h"
+
+#include "../HeaderFiles/Renderer.h"
+#include "../HeaderFiles/Mesh.h"
+#include "../HeaderFiles/Material.h"
+#include "../HeaderFiles/Shader.h"
+#include "../HeaderFiles/VertexArray.h"
+
+
+namespace avt {
+
+	void GLCommandBackend::begin(const CommandBuffer& buffer) {
+		_buffer = &buffer;
+		_material = nullptr;
+		_shader = nullptr;
+		_mesh = nullptr;
+		_first = _count = 0;
+		_instancesUploaded = _objectsUploaded = false;
+	}
+
+	void GLCommandBackend::bindPipeline(Material* material) {
+		_material = material;
+		_shader = material->shader().get();
+		material->bind(); // binds shader
+	}
+
+	// the vertex array is bound by the draw: the mesh's own or the arena's, depending on the shader
+	void GLCommandBackend::bindMesh(Mesh* mesh) {
+		if (mesh->autoBufferUpdate()) mesh->updateBufferData();
+		_mesh = mesh;
+	}
+
+	void GLCommandBackend::setTransforms(uint32_t first, uint32_t count) {
+		_first = first;
+		_count = count;
+	}
+
+	void GLCommandBackend::draw(DrawMode mode, uint32_t instances) {
+		if (!_shader || !_mesh || !_mesh->va() || instances > _count) return;
+		GLenum glMode = getGLdrawMode(mode);
+
+		if (_shader->usesObjectBuffer()) {
+			uploadObjects();
+			MeshArena::Range range = _arena.place(*_mesh);
+			_objects->setBindingPoint(_shader->objectBinding()); // the state cache drops it when already there
+
+			_arena.va()->bind();
+			if (_shader->usesLightViewProj()) _shader->uploadLightViewProj(_lightSpace);
+			glDrawArraysInstancedBaseInstance(glMode, range.first, range.count, (GLsizei)instances, _first);
+			return;
+		}
+
+		auto& va = _mesh->va();
+		va->bind();
+		if (_shader->instanced()) {
+			uploadInstances();
+			va->setInstanceMatrices(*_instances, _shader->instanceLocation(), (GLsizei)_first);
+			if (_shader->usesLightViewProj()) _shader->uploadLightViewProj(_lightSpace);
+			glDrawArraysInstanced(glMode, 0, _mesh->vertexCount(), (GLsizei)instances);
+			return;
+		}
+
+		const Affine* worlds = _buffer->transforms().data() + _first;
+		for (uint32_t i = 0; i < instances; i++) {
+			Mat4 model = worlds[i].toMat4();
+			_shader->uploadModelMatrix(model);
+			if (_shader->usesNormalMatrix()) _shader->uploadNormalMatrix(worlds[i].normalMatrix());
+			if (_shader->usesLightSpaceMatrix()) _shader->uploadLightSpaceMatrix(_lightSpace * model);
+			if (_shader->usesLightViewProj()) _shader->uploadLightViewProj(_lightSpace);
+
+			glDrawArrays(glMode, 0, _mesh->vertexCount());
+		}
+	}
+
+	// every transform of the buffer on its first instanced draw, the storage orphaned before each upload
+	void GLCommandBackend::uploadInstances() {
+		if (_instancesUploaded) return;
+		_instancesUploaded = true;
+
+		const std::vector<Affine>& transforms = _buffer->transforms();
+		_instanceData.resize(transforms.size() * 16);
+		for (size_t i = 0; i < transforms.size(); i++) {
+			transforms[i].toMat4(&_instanceData[i * 16]);
+		}
+
+		GLsizeiptr size = (GLsizeiptr)(_instanceData.size() * sizeof(float));
+		if (!_instances) {
+			_instances.reset(new VertexBuffer(size, { { ShaderDataType::MAT4, "InstanceModel" } }));
+		} else {
+			GLsizeiptr capacity = _instances->capacity();
+			_instances->resize(capacity < size ? size + size / 2 : capacity, false);
+		}
+		_instances->upload(_instanceData.data(), size);
+	}
+
+	// the same for object buffer draws, an object per transform with the id of the material bound
+	// when it was set
+	void GLCommandBackend::uploadObjects() {
+		if (_objectsUploaded) return;
+		_objectsUploaded = true;
+
+		const std::vector<Affine>& transforms = _buffer->transforms();
+		_objectData.resize(transforms.size());
+		for (size_t i = 0; i < transforms.size(); i++) {
+			transforms[i].toMat4(_objectData[i].model);
+		}
+
+		// every transform was set by a SetTransforms
+		GLuint material = 0;
+		for (const CommandBuffer::Command& c : _buffer->commands()) {
+			if (c.op == CommandBuffer::Op::BindPipeline) material = c.materialId;
+			if (c.op != CommandBuffer::Op::SetTransforms) continue;
+			for (uint32_t i = c.first; i < c.first + c.count; i++) {
+				_objectData[i].material = material;
+			}
+		}
+
+		if (!_objects) _objects.reset(new StorageBuffer(GL_SHADER_STORAGE_BUFFER, 1));
+		_objects->upload(_objectData);
+		_objects->unbind();
+		_arena.reserveObjects((GLsizei)_objectData.size());
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,109 @@
+#include "../HeaderFiles/GLState.h"
+
+namespace avt {
+
+	constexpr GLuint GLState::UNKNOWN;
+
+	// as in a new context: nothing bound, unit 0 active, only multisampling enabled. Debug output
+	// starts enabled in a debug context and disabled otherwise, unknown until first set
+	GLuint GLState::_program = 0;
+	GLuint GLState::_vertexArray = 0;
+	GLuint GLState::_buffers[TARGETS] = {};
+	GLuint GLState::_bases[2][BINDING_POINTS] = {};
+	GLuint GLState::_activeUnit = 0;
+	GLuint GLState::_textures[TEXTURE_UNITS] = {};
+	GLenum GLState::_capabilities[CAPABILITIES] = {
+		GL_DEPTH_TEST, GL_STENCIL_TEST, GL_BLEND, GL_CULL_FACE, GL_MULTISAMPLE,
+		GL_SCISSOR_TEST, GL_DEBUG_OUTPUT, GL_DEBUG_OUTPUT_SYNCHRONOUS
+	};
+	signed char GLState::_enabled[CAPABILITIES] = { 0, 0, 0, 0, 1, 0, -1, -1 };
+
+	GLState::Stats GLState::_stats;
+	GLState::Stats GLState::_lastFrame;
+
+
+	int GLState::capability(GLenum cap) {
+		for (unsigned i = 0; i < CAPABILITIES; i++) {
+			if (_capabilities[i] == cap) return (int)i;
+		}
+		return -1;
+	}
+
+	void GLState::invalidate() {
+		_program = UNKNOWN;
+		_vertexArray = UNKNOWN;
+		for (auto& buffer : _buffers) buffer = UNKNOWN;
+		for (auto& bases : _bases) {
+			for (auto& base : bases) base = UNKNOWN;
+		}
+		_activeUnit = UNKNOWN;
+		for (auto& texture : _textures) texture = UNKNOWN;
+		for (auto& enabled : _enabled) enabled = -1;
+	}
+
+	void GLState::bindBufferBase(GLenum target, GLuint index, GLuint buffer) {
+		int t = target == GL_UNIFORM_BUFFER ? 0 : target == GL_SHADER_STORAGE_BUFFER ? 1 : -1;
+		if (t < 0 || index >= BINDING_POINTS) {
+			_stats.buffer.issued++;
+			glBindBufferBase(target, index, buffer);
+		} else if (change(_bases[t][index], buffer, _stats.buffer)) {
+			glBindBufferBase(target, index, buffer);
+		} else {
+			return;
+		}
+
+		int generic = GLState::target(target);
+		if (generic >= 0) _buffers[generic] = buffer;
+	}
+
+	void GLState::enable(GLenum cap) {
+		int c = capability(cap);
+		if (c >= 0 && _enabled[c] == 1) {
+			_stats.capability.filtered++;
+			return;
+		}
+		if (c >= 0) _enabled[c] = 1;
+		_stats.capability.issued++;
+		glEnable(cap);
+	}
+
+	void GLState::disable(GLenum cap) {
+		int c = capability(cap);
+		if (c >= 0 && _enabled[c] == 0) {
+			_stats.capability.filtered++;
+			return;
+		}
+		if (c >= 0) _enabled[c] = 0;
+		_stats.capability.issued++;
+		glDisable(cap);
+	}
+
+	void GLState::deleteBuffer(GLuint buffer) {
+		for (auto& bound : _buffers) {
+			if (bound == buffer) bound = 0;
+		}
+		for (auto& bases : _bases) {
+			for (auto& base : bases) {
+				if (base == buffer) base = 0;
+			}
+		}
+	}
+
+	void GLState::deleteVertexArray(GLuint vertexArray) {
+		if (_vertexArray != vertexArray) return;
+		_vertexArray = 0;
+		_buffers[1] = UNKNOWN;
+	}
+
+	void GLState::deleteTexture(GLuint texture) {
+		for (auto& bound : _textures) {
+			if (bound == texture) bound = 0;
+		}
+	}
+
+	// a program in use is only flagged for deletion, it stays current
+	void GLState::deleteProgram(GLuint program) {
+		if (_program == program) _program = UNKNOWN;
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,259 @@
+#include "../HeaderFiles/Geometry.h"
+
+#include <cmath>
+
+#include "../HeaderFiles/MathKernels.h"
+#include "../HeaderFiles/Vector3Stream.h"
+
+
+namespace avt {
+
+	// the single-element tests go through the batch kernels, so both always agree
+
+	namespace {
+		Vec3SoA soa(Vector3& vec) {
+			return { &vec.x, &vec.y, &vec.z };
+		}
+	}
+
+
+	////////////////////////////////////////////////////////////////////////////////// PLANE
+
+	Plane Plane::fromPointNormal(const Vector3& point, const Vector3& normal) {
+		return Plane(normal, -normal.dot(point));
+	}
+
+	float Plane::distanceTo(const Vector3& point) const {
+		return normal.x * point.x + normal.y * point.y + normal.z * point.z + d;
+	}
+
+	Plane& Plane::normalize() {
+		float len = normal.length();
+		if (len == 0) return *this;
+
+		normal /= len;
+		d /= len;
+		return *this;
+	}
+
+	Plane Plane::normalized() const {
+		Plane plane(*this);
+		return plane.normalize();
+	}
+
+	std::ostream& operator<<(std::ostream& os, const Plane& plane) {
+		os << "Plane(" << plane.normal << ", " << plane.d << ")";
+		return os;
+	}
+
+
+	////////////////////////////////////////////////////////////////////////////////// SPHERE
+
+	bool Sphere::contains(const Vector3& point) const {
+		return (point - center).quadrance() <= radius * radius;
+	}
+
+	bool Sphere::intersects(const Sphere& sphere) const {
+		float r = radius + sphere.radius;
+		return (sphere.center - center).quadrance() <= r * r;
+	}
+
+	Sphere Sphere::transformed(const Affine& aff) const {
+		float sx = aff[0] * aff[0] + aff[1] * aff[1] + aff[2] * aff[2];
+		float sy = aff[3] * aff[3] + aff[4] * aff[4] + aff[5] * aff[5];
+		float sz = aff[6] * aff[6] + aff[7] * aff[7] + aff[8] * aff[8];
+		float s = sx > sy ? sx : sy;
+		s = s > sz ? s : sz;
+
+		return Sphere(aff * center, radius * std::sqrt(s));
+	}
+
+	std::ostream& operator<<(std::ostream& os, const Sphere& sphere) {
+		os << "Sphere(" << sphere.center << ", " << sphere.radius << ")";
+		return os;
+	}
+
+
+	////////////////////////////////////////////////////////////////////////////////// AABB
+
+	AABB AABB::fromCenterExtent(const Vector3& center, const Vector3& extent) {
+		return AABB(center - extent, center + extent);
+	}
+
+	AABB AABB::fromPoints(const Vector3Stream& points) {
+		AABB box;
+		if (!points.empty()) points.bounds(box.lower, box.upper);
+		return box;
+	}
+
+	bool AABB::empty() const {
+		return lower.x > upper.x || lower.y > upper.y || lower.z > upper.z;
+	}
+
+	Vector3 AABB::center() const {
+		return (lower + upper) * 0.5f;
+	}
+
+	Vector3 AABB::extent() const {
+		return (upper - lower) * 0.5f;
+	}
+
+	Sphere AABB::boundingSphere() const {
+		return Sphere(center(), extent().length());
+	}
+
+	AABB& AABB::expand(const Vector3& point) {
+		lower.x = point.x < lower.x ? point.x : lower.x;
+		lower.y = point.y < lower.y ? point.y : lower.y;
+		lower.z = point.z < lower.z ? point.z : lower.z;
+		upper.x = point.x > upper.x ? point.x : upper.x;
+		upper.y = point.y > upper.y ? point.y : upper.y;
+		upper.z = point.z > upper.z ? point.z : upper.z;
+		return *this;
+	}
+
+	AABB& AABB::expand(const AABB& box) {
+		if (box.empty()) return *this;
+		expand(box.lower);
+		return expand(box.upper);
+	}
+
+	bool AABB::contains(const Vector3& point) const {
+		return point.x >= lower.x && point.x <= upper.x
+			&& point.y >= lower.y && point.y <= upper.y
+			&& point.z >= lower.z && point.z <= upper.z;
+	}
+
+	bool AABB::intersects(const AABB& box) const {
+		return lower.x <= box.upper.x && upper.x >= box.lower.x
+			&& lower.y <= box.upper.y && upper.y >= box.lower.y
+			&& lower.z <= box.upper.z && upper.z >= box.lower.z;
+	}
+
+	AABB AABB::transformed(const Affine& aff) const {
+		if (empty()) return *this;
+
+		Vector3 c = center();
+		Vector3 e = extent();
+		MathKernels::get().aabbTransform(aff.data(), 0, soa(c), soa(e), soa(c), soa(e), 1);
+		return fromCenterExtent(c, e);
+	}
+
+	std::ostream& operator<<(std::ostream& os, const AABB& box) {
+		os << "AABB(" << box.lower << ", " << box.upper << ")";
+		return os;
+	}
+
+
+	////////////////////////////////////////////////////////////////////////////////// FRUSTUM
+
+	Frustum::Frustum(const Mat4& viewProjection) {
+		const float* m = viewProjection.data();
+
+		// clip space x, y and z are rows 0-2, -w <= x <= w gives w + x >= 0 and w - x >= 0
+		for (int axis = 0; axis < 3; axis++) {
+			Plane& lowerSide = _planes[2 * axis];
+			Plane& upperSide = _planes[2 * axis + 1];
+
+			lowerSide.normal = Vector3(m[3] + m[axis], m[7] + m[4 + axis], m[11] + m[8 + axis]);
+			lowerSide.d = m[15] + m[12 + axis];
+			upperSide.normal = Vector3(m[3] - m[axis], m[7] - m[4 + axis], m[11] - m[8 + axis]);
+			upperSide.d = m[15] - m[12 + axis];
+
+			lowerSide.normalize();
+			upperSide.normalize();
+		}
+	}
+
+	bool Frustum::contains(const Vector3& point) const {
+		for (const Plane& plane : _planes) {
+			if (plane.distanceTo(point) < 0) return false;
+		}
+		return true;
+	}
+
+	bool Frustum::contains(const AABB& box) const {
+		Vector3 c = box.center();
+		Vector3 e = box.extent();
+		for (const Plane& p : _planes) {
+			float r = e.x * fabsf(p.normal.x) + e.y * fabsf(p.normal.y) + e.z * fabsf(p.normal.z);
+			if (p.distanceTo(c) - r < 0) return false;
+		}
+		return true;
+	}
+
+	bool Frustum::intersects(const AABB& box) const {
+		Vector3 c = box.center();
+		Vector3 e = box.extent();
+		uint8_t visible;
+		return MathKernels::get().frustumAABB(data(), soa(c), soa(e), &visible, 1) != 0;
+	}
+
+	bool Frustum::intersects(const Sphere& sphere) const {
+		Vector3 c = sphere.center;
+		uint8_t visible;
+		return MathKernels::get().frustumSphere(data(), soa(c), &sphere.radius, &visible, 1) != 0;
+	}
+
+
+	////////////////////////////////////////////////////////////////////////////////// RAY
+
+	void Ray::pack(float* out, bool inverseDirection) const {
+		out[0] = origin.x;
+		out[1] = origin.y;
+		out[2] = origin.z;
+		out[3] = inverseDirection ? 1.0f / direction.x : direction.x;
+		out[4] = inverseDirection ? 1.0f / direction.y : direction.y;
+		out[5] = inverseDirection ? 1.0f / direction.z : direction.z;
+		out[6] = tMax;
+	}
+
+	bool Ray::intersects(const AABB& box, float& t) const {
+		float ray[7];
+		pack(ray, true);
+
+		Vector3 c = box.center();
+		Vector3 e = box.extent();
+		float hit;
+		MathKernels::get().rayAABB(ray, soa(c), soa(e), &hit, 1);
+		if (hit == std::numeric_limits<float>::infinity()) return false;
+
+		t = hit;
+		return true;
+	}
+
+	bool Ray::intersects(const Vector3& v0, const Vector3& v1, const Vector3& v2, float& t) const {
+		float ray[7];
+		pack(ray, false);
+
+		Vector3 a = v0, b = v1, c = v2;
+		float hit;
+		MathKernels::get().rayTriangle(ray, soa(a), soa(b), soa(c), &hit, 1);
+		if (hit == std::numeric_limits<float>::infinity()) return false;
+
+		t = hit;
+		return true;
+	}
+
+	int Ray::intersects(const Vector3Stream& v0, const Vector3Stream& v1, const Vector3Stream& v2, float* t) const {
+		size_t n = v0.size();
+		n = v1.size() < n ? v1.size() : n;
+		n = v2.size() < n ? v2.size() : n;
+		if (n == 0) return -1;
+
+		float ray[7];
+		pack(ray, false);
+		MathKernels::get().rayTriangle(ray, v0.view(), v1.view(), v2.view(), t, n);
+
+		int closest = -1;
+		float best = std::numeric_limits<float>::infinity();
+		for (size_t i = 0; i < n; i++) {
+			if (t[i] < best) {
+				best = t[i];
+				closest = static_cast<int>(i);
+			}
+		}
+		return closest;
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,94 @@
+#include "../HeaderFiles/MappedFile.h"
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+namespace avt {
+
+#if defined(_WIN32)
+
+	bool MappedFile::open(const std::string& path) {
+		close();
+
+		HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (file == INVALID_HANDLE_VALUE) return false;
+
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+			CloseHandle(file);
+			return false;
+		}
+
+		HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		const void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+		if (!view) {
+			if (mapping) CloseHandle(mapping);
+			CloseHandle(file);
+			return false;
+		}
+
+		_file = file;
+		_mapping = mapping;
+		_data = static_cast<const uint8_t*>(view);
+		_size = static_cast<size_t>(size.QuadPart);
+		return true;
+	}
+
+	void MappedFile::close() {
+		if (_data) UnmapViewOfFile(_data);
+		if (_mapping) CloseHandle(_mapping);
+		if (_file) CloseHandle(_file);
+		_data = nullptr;
+		_mapping = nullptr;
+		_file = nullptr;
+		_size = 0;
+	}
+
+#else
+
+	bool MappedFile::open(const std::string& path) {
+		close();
+
+		int fd = ::open(path.c_str(), O_RDONLY);
+		if (fd < 0) return false;
+
+		struct stat st;
+		if (fstat(fd, &st) != 0 || st.st_size == 0) {
+			::close(fd);
+			return false;
+		}
+
+		void* view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+		if (view == MAP_FAILED) {
+			::close(fd);
+			return false;
+		}
+		// read front to back once
+		madvise(view, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+
+		_fd = fd;
+		_data = static_cast<const uint8_t*>(view);
+		_size = static_cast<size_t>(st.st_size);
+		return true;
+	}
+
+	void MappedFile::close() {
+		if (_data) munmap(const_cast<uint8_t*>(_data), _size);
+		if (_fd >= 0) ::close(_fd);
+		_data = nullptr;
+		_fd = -1;
+		_size = 0;
+	}
+
+#endif
+
+}
\ No newline at end of file
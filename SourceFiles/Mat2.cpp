@@ -3,21 +3,6 @@
 
 namespace avt {
 
-	// copy assignment
-	Mat2& Mat2::operator=(const Mat2& mat) {
-		std::copy_n(mat.data(), LEN, _cells);
-		return *this;
-	}
-
-	// move constructor
-	Mat2& Mat2::operator=(Mat2&& mat) noexcept {
-		delete[] _cells;
-		_cells = mat.data();
-		mat._cells = nullptr;
-		return *this;
-	}
-
-
 	Mat2 Mat2::operator+(const Mat2& mat) const {
 		Mat2 newM;
 		newM[0] = _cells[0] + mat[0];
@@ -186,8 +171,4 @@ namespace avt {
 		return newM * multiplier;
 	}
 
-	Mat2 Mat2::identity() {
-		return Mat2{ 1, 0, 0, 1 };
-	}
-
 }
\ No newline at end of file
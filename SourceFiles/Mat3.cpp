@@ -5,21 +5,6 @@
 
 namespace avt {
 
-	// copy assignment
-	Mat3& Mat3::operator=(const Mat3& mat) {
-		std::copy_n(mat.data(), LEN, _cells);
-		return *this;
-	}
-
-	// move constructor
-	Mat3& Mat3::operator=(Mat3&& mat) noexcept {
-		delete[] _cells;
-		_cells = mat.data();
-		mat._cells = nullptr;
-		return *this;
-	}
-
-
 	Mat3 Mat3::operator+(const Mat3& mat) const {
 		Mat3 newM;
 
@@ -239,10 +224,6 @@ namespace avt {
 
 	}
 
-	Mat3 Mat3::identity() {
-		return Mat3{ 1, 0, 0, 0, 1, 0, 0, 0, 1 };
-	}
-
 	Mat3 Mat3::dual(Vector3 vec) {
 		return Mat3{ 0, vec.z, -vec.y, -vec.z, 0, vec.x, vec.y, -vec.x, 0 };
 	}
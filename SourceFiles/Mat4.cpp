@@ -1,22 +1,10 @@
 #include "../HeaderFiles/Mat4.h"
 
+#include "../HeaderFiles/MathKernels.h"
+#include "../HeaderFiles/Affine.h"
 
-namespace avt {
-
-	// copy assignment
-	Mat4& Mat4::operator=(const Mat4& mat) {
-		std::copy_n(mat.data(), LEN, _cells);
-		return *this;
-	}
-
-	// move constructor
-	Mat4& Mat4::operator=(Mat4&& mat) noexcept {
-		delete[] _cells;
-		_cells = mat.data();
-		mat._cells = nullptr;
-		return *this;
-	}
 
+namespace avt {
 
 	Mat4 Mat4::operator+(const Mat4& mat) const {
 		Mat4 newM;
@@ -69,27 +57,14 @@ namespace avt {
 
 	Mat4 Mat4::operator*(const Mat4& mat) const {
 		Mat4 newM;
-
-		for (int row = 0; row < SIZE; row++) {
-			for (int col = 0; col < SIZE; col++) {
-				float val = 0;
-				for (int k = 0; k < SIZE; k++) {
-					val += at(row, k) * mat.at(k, col);
-				}
-				newM.at(row, col) = val;
-			}
-		}
-
+		MathKernels::get().mat4Mul(_cells, mat._cells, newM._cells);
 		return newM;
 	}
 
 	Vector4 Mat4::operator*(const Vector4& vec) const {
-		float x = _cells[0] * vec.x + _cells[4] * vec.y + _cells[8] * vec.z + _cells[12] * vec.w;
-		float y = _cells[1] * vec.x + _cells[5] * vec.y + _cells[9] * vec.z + _cells[13] * vec.w;
-		float z = _cells[2] * vec.x + _cells[6] * vec.y + _cells[10] * vec.z + _cells[14] * vec.w;
-		float w = _cells[3] * vec.x + _cells[7] * vec.y + _cells[11] * vec.z + _cells[15] * vec.w;
-
-		return Vector4(x, y, z, w);
+		Vector4 newV;
+		MathKernels::get().mat4MulVec4(_cells, &vec.x, &newV.x);
+		return newV;
 	}
 
 	bool Mat4::operator==(const Mat4& mat) const {
@@ -127,19 +102,8 @@ namespace avt {
 	}
 
 	Mat4& Mat4::operator*=(const Mat4& mat) {
-		Mat4 newM;
-
-		for (int row = 0; row < SIZE; row++) {
-			for (int col = 0; col < SIZE; col++) {
-				float val = 0;
-				for (int k = 0; k < SIZE; k++) {
-					val += at(row, k) * mat.at(k, col);
-				}
-				newM.at(row, col) = val;
-			}
-		}
-
-		return *this = newM;
+		MathKernels::get().mat4Mul(_cells, mat._cells, _cells);
+		return *this;
 	}
 
 	Mat4& Mat4::operator*=(const float num) {
@@ -168,32 +132,60 @@ namespace avt {
 	}
 
 	Mat4& Mat4::transpose() {
-		std::swap(_cells[1], _cells[4]);
-		std::swap(_cells[2], _cells[8]);
-		std::swap(_cells[3], _cells[12]);
-		std::swap(_cells[6], _cells[9]);
-		std::swap(_cells[7], _cells[13]);
-		std::swap(_cells[11], _cells[14]);
+		MathKernels::get().mat4Transpose(_cells, _cells);
 		return *this;
 	}
 
 	Mat4 Mat4::T() const {
-		return Mat4{ _cells[0], _cells[4], _cells[8], _cells[12],
-			_cells[1], _cells[5], _cells[9], _cells[13],
-			_cells[2], _cells[6], _cells[10], _cells[14],
-			_cells[3], _cells[7], _cells[11], _cells[15] };
+		Mat4 newM;
+		MathKernels::get().mat4Transpose(_cells, newM._cells);
+		return newM;
+	}
+
+	float Mat4::det() const {
+		const float* c = _cells;
+		float c5 = c[10] * c[15] - c[11] * c[14];
+		float c4 = c[6] * c[15] - c[7] * c[14];
+		float c3 = c[6] * c[11] - c[7] * c[10];
+		float c2 = c[2] * c[15] - c[3] * c[14];
+		float c1 = c[2] * c[11] - c[3] * c[10];
+		float c0 = c[2] * c[7] - c[3] * c[6];
+
+		return c[0] * (c[5] * c5 - c[9] * c4 + c[13] * c3)
+			- c[4] * (c[1] * c5 - c[9] * c2 + c[13] * c1)
+			+ c[8] * (c[1] * c4 - c[5] * c2 + c[13] * c0)
+			- c[12] * (c[1] * c3 - c[5] * c1 + c[9] * c0);
 	}
 
-	Mat4 Mat4::identity() {
-		return Mat4{ 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
+	Mat4& Mat4::invert() {
+		MathKernels::get().mat4Inverse(_cells, _cells);
+		return *this;
 	}
 
-	Mat4 Mat4::scale(Vector3 vec) {
-		return Mat4{ vec.x, 0, 0, 0, 0, vec.y, 0, 0, 0, 0, vec.z, 0, 0, 0, 0, 1 };
+	Mat4 Mat4::inverted() const {
+		Mat4 newM(*this);
+		MathKernels::get().mat4Inverse(_cells, newM._cells);
+		return newM;
 	}
 
-	Mat4 Mat4::translation(Vector3 vec) {
-		return Mat4{ 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, vec.x, vec.y, vec.z, 1 };
+	Mat4 Mat4::invertedAffine() const {
+		return Affine::fromMat4(*this).inverted().toMat4();
+	}
+
+	// columns of the cofactor matrix are the pairwise cross products of the columns
+	Mat3 Mat4::normalMatrix() const {
+		Vector3 a(_cells[0], _cells[1], _cells[2]);
+		Vector3 b(_cells[4], _cells[5], _cells[6]);
+		Vector3 c(_cells[8], _cells[9], _cells[10]);
+
+		Vector3 bc = b.cross(c);
+		float dt = a.dot(bc);
+		if (dt == 0) return Mat3{ a.x, a.y, a.z, b.x, b.y, b.z, c.x, c.y, c.z };
+
+		Vector3 ca = c.cross(a);
+		Vector3 ab = a.cross(b);
+		float multiplier = 1 / dt;
+		return Mat3{ bc.x, bc.y, bc.z, ca.x, ca.y, ca.z, ab.x, ab.y, ab.z } * multiplier;
 	}
 
 	Mat4 Mat4::rotationX(float angle) {
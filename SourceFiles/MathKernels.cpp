@@ -0,0 +1,568 @@
+#include "../HeaderFiles/MathKernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define AVT_X86 1
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+
+namespace avt {
+
+	////////////////////////////////////////////////////////////////////////////////// SCALAR
+
+	namespace {
+
+		void mat4MulScalar(const float* a, const float* b, float* out) {
+			float res[16];
+			for (int col = 0; col < 4; col++) {
+				const float* bc = b + 4 * col;
+				for (int row = 0; row < 4; row++) {
+					float val = a[row] * bc[0];
+					val += a[4 + row] * bc[1];
+					val += a[8 + row] * bc[2];
+					val += a[12 + row] * bc[3];
+					res[4 * col + row] = val;
+				}
+			}
+			std::copy_n(res, 16, out);
+		}
+
+		void mat4MulVec4Scalar(const float* m, const float* v, float* out) {
+			float res[4];
+			for (int row = 0; row < 4; row++) {
+				res[row] = m[row] * v[0] + m[4 + row] * v[1] + m[8 + row] * v[2] + m[12 + row] * v[3];
+			}
+			std::copy_n(res, 4, out);
+		}
+
+		void mat4TransposeScalar(const float* m, float* out) {
+			float res[16];
+			for (int col = 0; col < 4; col++) {
+				for (int row = 0; row < 4; row++) {
+					res[4 * row + col] = m[4 * col + row];
+				}
+			}
+			std::copy_n(res, 16, out);
+		}
+
+		void mat4TransformPointsScalar(const float* m, float* xyz, size_t count, size_t stride) {
+			char* base = reinterpret_cast<char*>(xyz);
+			for (size_t i = 0; i < count; i++) {
+				float* p = reinterpret_cast<float*>(base + i * stride);
+				float x = p[0], y = p[1], z = p[2];
+				p[0] = m[0] * x + m[4] * y + m[8] * z + m[12];
+				p[1] = m[1] * x + m[5] * y + m[9] * z + m[13];
+				p[2] = m[2] * x + m[6] * y + m[10] * z + m[14];
+			}
+		}
+
+		// cofactor expansion through the 2x2 sub-determinants of the top and bottom row pairs
+		float mat4InverseScalar(const float* m, float* out) {
+			float a00 = m[0], a01 = m[4], a02 = m[8], a03 = m[12];
+			float a10 = m[1], a11 = m[5], a12 = m[9], a13 = m[13];
+			float a20 = m[2], a21 = m[6], a22 = m[10], a23 = m[14];
+			float a30 = m[3], a31 = m[7], a32 = m[11], a33 = m[15];
+
+			float s0 = a00 * a11 - a10 * a01;
+			float s1 = a00 * a12 - a10 * a02;
+			float s2 = a00 * a13 - a10 * a03;
+			float s3 = a01 * a12 - a11 * a02;
+			float s4 = a01 * a13 - a11 * a03;
+			float s5 = a02 * a13 - a12 * a03;
+
+			float c5 = a22 * a33 - a32 * a23;
+			float c4 = a21 * a33 - a31 * a23;
+			float c3 = a21 * a32 - a31 * a22;
+			float c2 = a20 * a33 - a30 * a23;
+			float c1 = a20 * a32 - a30 * a22;
+			float c0 = a20 * a31 - a30 * a21;
+
+			float det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+			if (det == 0) return det;
+
+			float invDet = 1 / det;
+
+			float res[16];
+			res[0] = (a11 * c5 - a12 * c4 + a13 * c3) * invDet;
+			res[4] = (-a01 * c5 + a02 * c4 - a03 * c3) * invDet;
+			res[8] = (a31 * s5 - a32 * s4 + a33 * s3) * invDet;
+			res[12] = (-a21 * s5 + a22 * s4 - a23 * s3) * invDet;
+
+			res[1] = (-a10 * c5 + a12 * c2 - a13 * c1) * invDet;
+			res[5] = (a00 * c5 - a02 * c2 + a03 * c1) * invDet;
+			res[9] = (-a30 * s5 + a32 * s2 - a33 * s1) * invDet;
+			res[13] = (a20 * s5 - a22 * s2 + a23 * s1) * invDet;
+
+			res[2] = (a10 * c4 - a11 * c2 + a13 * c0) * invDet;
+			res[6] = (-a00 * c4 + a01 * c2 - a03 * c0) * invDet;
+			res[10] = (a30 * s4 - a31 * s2 + a33 * s0) * invDet;
+			res[14] = (-a20 * s4 + a21 * s2 - a23 * s0) * invDet;
+
+			res[3] = (-a10 * c3 + a11 * c1 - a12 * c0) * invDet;
+			res[7] = (a00 * c3 - a01 * c1 + a02 * c0) * invDet;
+			res[11] = (-a30 * s3 + a31 * s1 - a32 * s0) * invDet;
+			res[15] = (a20 * s3 - a21 * s1 + a22 * s0) * invDet;
+
+			std::copy_n(res, 16, out);
+			return det;
+		}
+
+		void vec3DotScalar(Vec3SoA a, Vec3SoA b, float* out, size_t count) {
+			for (size_t i = 0; i < count; i++) {
+				out[i] = a.x[i] * b.x[i] + a.y[i] * b.y[i] + a.z[i] * b.z[i];
+			}
+		}
+
+		void vec3CrossScalar(Vec3SoA a, Vec3SoA b, Vec3SoA out, size_t count) {
+			for (size_t i = 0; i < count; i++) {
+				float x = a.y[i] * b.z[i] - a.z[i] * b.y[i];
+				float y = a.z[i] * b.x[i] - a.x[i] * b.z[i];
+				float z = a.x[i] * b.y[i] - a.y[i] * b.x[i];
+				out.x[i] = x;
+				out.y[i] = y;
+				out.z[i] = z;
+			}
+		}
+
+		void vec3LengthScalar(Vec3SoA v, float* out, size_t count) {
+			for (size_t i = 0; i < count; i++) {
+				out[i] = std::sqrt(v.x[i] * v.x[i] + v.y[i] * v.y[i] + v.z[i] * v.z[i]);
+			}
+		}
+
+		void vec3NormalizeScalar(Vec3SoA v, size_t count) {
+			for (size_t i = 0; i < count; i++) {
+				float len = std::sqrt(v.x[i] * v.x[i] + v.y[i] * v.y[i] + v.z[i] * v.z[i]);
+				if (len == 0) continue;
+				v.x[i] /= len;
+				v.y[i] /= len;
+				v.z[i] /= len;
+			}
+		}
+
+		void vec3TransformScalar(const float* m, Vec3SoA v, size_t count, float w) {
+			float tx = m[12] * w, ty = m[13] * w, tz = m[14] * w;
+			for (size_t i = 0; i < count; i++) {
+				float x = v.x[i], y = v.y[i], z = v.z[i];
+				v.x[i] = m[0] * x + m[4] * y + m[8] * z + tx;
+				v.y[i] = m[1] * x + m[5] * y + m[9] * z + ty;
+				v.z[i] = m[2] * x + m[6] * y + m[10] * z + tz;
+			}
+		}
+
+		void vec3MinMaxScalar(Vec3SoA v, size_t count, float* outMin, float* outMax) {
+			float mn[3] = { v.x[0], v.y[0], v.z[0] };
+			float mx[3] = { v.x[0], v.y[0], v.z[0] };
+			for (size_t i = 1; i < count; i++) {
+				const float c[3] = { v.x[i], v.y[i], v.z[i] };
+				for (int k = 0; k < 3; k++) {
+					mn[k] = c[k] < mn[k] ? c[k] : mn[k];
+					mx[k] = c[k] > mx[k] ? c[k] : mx[k];
+				}
+			}
+			std::copy_n(mn, 3, outMin);
+			std::copy_n(mx, 3, outMax);
+		}
+
+		void quatMulScalar(QuatSoA a, QuatSoA b, QuatSoA out, size_t count) {
+			for (size_t i = 0; i < count; i++) {
+				float at = a.t[i], ax = a.x[i], ay = a.y[i], az = a.z[i];
+				float bt = b.t[i], bx = b.x[i], by = b.y[i], bz = b.z[i];
+				out.t[i] = at * bt - ax * bx - ay * by - az * bz;
+				out.x[i] = at * bx + ax * bt + ay * bz - az * by;
+				out.y[i] = at * by + ay * bt + az * bx - ax * bz;
+				out.z[i] = at * bz + az * bt + ax * by - ay * bx;
+			}
+		}
+
+		// (a * k0 + b * k1).normalized()
+		inline void quatBlendScalar(QuatSoA a, QuatSoA b, size_t i, float k0, float k1, QuatSoA out) {
+			float t = a.t[i] * k0 + b.t[i] * k1;
+			float x = a.x[i] * k0 + b.x[i] * k1;
+			float y = a.y[i] * k0 + b.y[i] * k1;
+			float z = a.z[i] * k0 + b.z[i] * k1;
+			float len = std::sqrt(t * t + x * x + y * y + z * z);
+			out.t[i] = t / len;
+			out.x[i] = x / len;
+			out.y[i] = y / len;
+			out.z[i] = z / len;
+		}
+
+		void quatNlerpScalar(QuatSoA a, QuatSoA b, const float* k, size_t kStride, QuatSoA out, size_t count) {
+			for (size_t i = 0; i < count; i++) {
+				float cosangle = a.x[i] * b.x[i] + a.y[i] * b.y[i] + a.z[i] * b.z[i] + a.t[i] * b.t[i];
+				float ki = k[i * kStride];
+				float k0 = 1.0f - ki;
+				float k1 = (cosangle > 0) ? ki : -ki;
+				quatBlendScalar(a, b, i, k0, k1, out);
+			}
+		}
+
+		// sin(a) for a in [0, pi], folded onto [0, pi/2]
+		inline float slerpSin(float a) {
+			return precision::poly::sinHalfPi(a > precision::poly::HALF_PI ? precision::poly::PI - a : a);
+		}
+
+		void quatSlerpScalar(QuatSoA a, QuatSoA b, const float* k, size_t kStride, QuatSoA out, size_t count) {
+			for (size_t i = 0; i < count; i++) {
+				float d = a.x[i] * b.x[i] + a.y[i] * b.y[i] + a.z[i] * b.z[i] + a.t[i] * b.t[i];
+				bool flip = std::signbit(d); // take the shortest arc
+				d = std::fabs(d);
+
+				float ki = k[i * kStride];
+				float k0 = 1.0f - ki;
+				float k1 = ki;
+				if (!(d > kernels::SLERP_NLERP_DOT)) { // nearly parallel: sin(angle) -> 0, plain nlerp instead
+					float angle = precision::poly::acos01(d);
+					float invSin = 1.0f / std::sqrt(1.0f - d * d);
+					k1 = slerpSin(k1 * angle) * invSin;
+					k0 = slerpSin(k0 * angle) * invSin;
+				}
+				if (flip) k1 = -k1;
+
+				quatBlendScalar(a, b, i, k0, k1, out);
+			}
+		}
+
+		void quatToAffineScalar(QuatSoA q, float* out, size_t count) {
+			for (size_t i = 0; i < count; i++, out += 12) {
+				float qt = q.t[i], qx = q.x[i], qy = q.y[i], qz = q.z[i];
+				float len = std::sqrt(qt * qt + qx * qx + qy * qy + qz * qz);
+				qt /= len;
+				qx /= len;
+				qy /= len;
+				qz /= len;
+
+				float xx = qx * qx, xy = qx * qy, xz = qx * qz, xt = qx * qt;
+				float yy = qy * qy, yz = qy * qz, yt = qy * qt;
+				float zz = qz * qz, zt = qz * qt;
+
+				out[0] = 1.0f - 2.0f * (yy + zz);
+				out[1] = 2.0f * (xy + zt);
+				out[2] = 2.0f * (xz - yt);
+				out[3] = 2.0f * (xy - zt);
+				out[4] = 1.0f - 2.0f * (xx + zz);
+				out[5] = 2.0f * (yz + xt);
+				out[6] = 2.0f * (xz + yt);
+				out[7] = 2.0f * (yz - xt);
+				out[8] = 1.0f - 2.0f * (xx + yy);
+				out[9] = 0.0f;
+				out[10] = 0.0f;
+				out[11] = 0.0f;
+			}
+		}
+
+		// the selects of _mm_min_ps / _mm_max_ps, so NaNs resolve the same way at every level
+		inline float lowerOf(float a, float b) {
+			return a < b ? a : b;
+		}
+
+		inline float upperOf(float a, float b) {
+			return a > b ? a : b;
+		}
+
+		size_t frustumAABBScalar(const float* planes, Vec3SoA center, Vec3SoA extent, uint8_t* out, size_t count) {
+			size_t visible = 0;
+			for (size_t i = 0; i < count; i++) {
+				bool inside = true;
+				for (int p = 0; p < 6; p++) {
+					const float* n = planes + 4 * p;
+					float d = n[0] * center.x[i] + n[1] * center.y[i] + n[2] * center.z[i] + n[3];
+					float r = std::fabs(n[0]) * extent.x[i] + std::fabs(n[1]) * extent.y[i] + std::fabs(n[2]) * extent.z[i];
+					if (d + r < 0) inside = false;
+				}
+				out[i] = inside ? 1 : 0;
+				visible += out[i];
+			}
+			return visible;
+		}
+
+		size_t frustumSphereScalar(const float* planes, Vec3SoA center, const float* radius, uint8_t* out, size_t count) {
+			size_t visible = 0;
+			for (size_t i = 0; i < count; i++) {
+				bool inside = true;
+				for (int p = 0; p < 6; p++) {
+					const float* n = planes + 4 * p;
+					float d = n[0] * center.x[i] + n[1] * center.y[i] + n[2] * center.z[i] + n[3];
+					if (d + radius[i] < 0) inside = false;
+				}
+				out[i] = inside ? 1 : 0;
+				visible += out[i];
+			}
+			return visible;
+		}
+
+		void rayAABBScalar(const float* ray, Vec3SoA center, Vec3SoA extent, float* out, size_t count) {
+			const float inf = std::numeric_limits<float>::infinity();
+			for (size_t i = 0; i < count; i++) {
+				const float c[3] = { center.x[i], center.y[i], center.z[i] };
+				const float e[3] = { extent.x[i], extent.y[i], extent.z[i] };
+
+				float tNear = 0.0f;
+				float tFar = ray[6];
+				for (int k = 0; k < 3; k++) {
+					float t1 = (c[k] - e[k] - ray[k]) * ray[3 + k];
+					float t2 = (c[k] + e[k] - ray[k]) * ray[3 + k];
+					tNear = upperOf(tNear, lowerOf(t1, t2));
+					tFar = lowerOf(tFar, upperOf(t1, t2));
+				}
+				out[i] = tNear <= tFar ? tNear : inf;
+			}
+		}
+
+		void rayTriangleScalar(const float* ray, Vec3SoA v0, Vec3SoA v1, Vec3SoA v2, float* out, size_t count) {
+			const float inf = std::numeric_limits<float>::infinity();
+			const float dx = ray[3], dy = ray[4], dz = ray[5];
+			for (size_t i = 0; i < count; i++) {
+				float e1x = v1.x[i] - v0.x[i], e1y = v1.y[i] - v0.y[i], e1z = v1.z[i] - v0.z[i];
+				float e2x = v2.x[i] - v0.x[i], e2y = v2.y[i] - v0.y[i], e2z = v2.z[i] - v0.z[i];
+
+				// p = d x e2
+				float px = dy * e2z - dz * e2y;
+				float py = dz * e2x - dx * e2z;
+				float pz = dx * e2y - dy * e2x;
+				float det = e1x * px + e1y * py + e1z * pz;
+				float invDet = 1.0f / det;
+
+				float sx = ray[0] - v0.x[i], sy = ray[1] - v0.y[i], sz = ray[2] - v0.z[i];
+				float u = (sx * px + sy * py + sz * pz) * invDet;
+
+				// q = s x e1
+				float qx = sy * e1z - sz * e1y;
+				float qy = sz * e1x - sx * e1z;
+				float qz = sx * e1y - sy * e1x;
+				float v = (dx * qx + dy * qy + dz * qz) * invDet;
+				float t = (e2x * qx + e2y * qy + e2z * qz) * invDet;
+
+				bool hit = std::fabs(det) > kernels::RAY_TRIANGLE_EPSILON
+					&& u >= 0 && v >= 0 && u + v <= 1 && t >= 0 && t <= ray[6];
+				out[i] = hit ? t : inf;
+			}
+		}
+
+		void aabbTransformScalar(const float* m, size_t mStride, Vec3SoA center, Vec3SoA extent, Vec3SoA outCenter, Vec3SoA outExtent, size_t count) {
+			for (size_t i = 0; i < count; i++, m += mStride) {
+				float cx = center.x[i], cy = center.y[i], cz = center.z[i];
+				float ex = extent.x[i], ey = extent.y[i], ez = extent.z[i];
+
+				outCenter.x[i] = m[0] * cx + m[3] * cy + m[6] * cz + m[9];
+				outCenter.y[i] = m[1] * cx + m[4] * cy + m[7] * cz + m[10];
+				outCenter.z[i] = m[2] * cx + m[5] * cy + m[8] * cz + m[11];
+
+				// each output half extent is the row of |linear part| dotted with the input one
+				outExtent.x[i] = std::fabs(m[0]) * ex + std::fabs(m[3]) * ey + std::fabs(m[6]) * ez;
+				outExtent.y[i] = std::fabs(m[1]) * ex + std::fabs(m[4]) * ey + std::fabs(m[7]) * ez;
+				outExtent.z[i] = std::fabs(m[2]) * ex + std::fabs(m[5]) * ey + std::fabs(m[8]) * ez;
+			}
+		}
+
+		void affineFromTRSScalar(const float* t, const float* r, const float* s, float* out, size_t count) {
+			for (size_t i = 0; i < count; i++, t += 3, r += 4, s += 3, out += 12) {
+				float len = std::sqrt(r[0] * r[0] + r[1] * r[1] + r[2] * r[2] + r[3] * r[3]);
+				float qt = r[0] / len, qx = r[1] / len, qy = r[2] / len, qz = r[3] / len;
+
+				float xx = qx * qx, xy = qx * qy, xz = qx * qz, xt = qx * qt;
+				float yy = qy * qy, yz = qy * qz, yt = qy * qt;
+				float zz = qz * qz, zt = qz * qt;
+
+				out[0] = (1.0f - 2.0f * (yy + zz)) * s[0];
+				out[1] = 2.0f * (xy + zt) * s[0];
+				out[2] = 2.0f * (xz - yt) * s[0];
+				out[3] = 2.0f * (xy - zt) * s[1];
+				out[4] = (1.0f - 2.0f * (xx + zz)) * s[1];
+				out[5] = 2.0f * (yz + xt) * s[1];
+				out[6] = 2.0f * (xz + yt) * s[2];
+				out[7] = 2.0f * (yz - xt) * s[2];
+				out[8] = (1.0f - 2.0f * (xx + yy)) * s[2];
+				out[9] = t[0];
+				out[10] = t[1];
+				out[11] = t[2];
+			}
+		}
+
+		void affineMulIndexedScalar(const float* parents, const uint32_t* index, const float* local, float* out, size_t count) {
+			for (size_t i = 0; i < count; i++, local += 12, out += 12) {
+				const float* a = parents + 12 * size_t(index[i]);
+				float b[12];
+				for (int j = 0; j < 12; j++) b[j] = local[j];
+
+				for (int col = 0; col < 3; col++) {
+					const float* bc = b + 3 * col;
+					out[3 * col + 0] = a[0] * bc[0] + a[3] * bc[1] + a[6] * bc[2];
+					out[3 * col + 1] = a[1] * bc[0] + a[4] * bc[1] + a[7] * bc[2];
+					out[3 * col + 2] = a[2] * bc[0] + a[5] * bc[1] + a[8] * bc[2];
+				}
+				out[9] = a[0] * b[9] + a[3] * b[10] + a[6] * b[11] + a[9];
+				out[10] = a[1] * b[9] + a[4] * b[10] + a[7] * b[11] + a[10];
+				out[11] = a[2] * b[9] + a[5] * b[10] + a[8] * b[11] + a[11];
+			}
+		}
+
+		const KernelTable SCALAR_TABLE = {
+			mat4MulScalar,
+			mat4MulVec4Scalar,
+			mat4TransposeScalar,
+			mat4TransformPointsScalar,
+			mat4InverseScalar,
+			vec3DotScalar,
+			vec3CrossScalar,
+			vec3LengthScalar,
+			vec3NormalizeScalar,
+			vec3TransformScalar,
+			vec3MinMaxScalar,
+			quatMulScalar,
+			quatNlerpScalar,
+			quatSlerpScalar,
+			quatToAffineScalar,
+			frustumAABBScalar,
+			frustumSphereScalar,
+			rayAABBScalar,
+			rayTriangleScalar,
+			aabbTransformScalar,
+			affineFromTRSScalar,
+			affineMulIndexedScalar
+		};
+
+
+		////////////////////////////////////////////////////////////////////////////// CPU DETECTION
+
+#ifdef AVT_X86
+		bool cpuHasSSE2() {
+#if defined(_M_X64) || defined(__x86_64__)
+			return true; // part of the x86-64 baseline
+#elif defined(_MSC_VER)
+			int info[4];
+			__cpuid(info, 1);
+			return (info[3] & (1 << 26)) != 0;
+#else
+			return __builtin_cpu_supports("sse2");
+#endif
+		}
+
+		bool cpuHasAVX2() {
+#if defined(_MSC_VER)
+			int info[4];
+			__cpuid(info, 0);
+			if (info[0] < 7) return false;
+
+			__cpuid(info, 1);
+			bool osxsave = (info[2] & (1 << 27)) != 0;
+			bool avx = (info[2] & (1 << 28)) != 0;
+			if (!osxsave || !avx) return false;
+			if ((_xgetbv(0) & 0x6) != 0x6) return false; // OS must save XMM and YMM state
+
+			__cpuidex(info, 7, 0);
+			return (info[1] & (1 << 5)) != 0;
+#else
+			__builtin_cpu_init();
+			return __builtin_cpu_supports("avx2");
+#endif
+		}
+#endif
+
+		// overwrite every entry the faster table provides
+		void overlay(KernelTable& dst, const KernelTable* src) {
+			if (!src) return;
+			if (src->mat4Mul) dst.mat4Mul = src->mat4Mul;
+			if (src->mat4MulVec4) dst.mat4MulVec4 = src->mat4MulVec4;
+			if (src->mat4Transpose) dst.mat4Transpose = src->mat4Transpose;
+			if (src->mat4TransformPoints) dst.mat4TransformPoints = src->mat4TransformPoints;
+			if (src->mat4Inverse) dst.mat4Inverse = src->mat4Inverse;
+			if (src->vec3Dot) dst.vec3Dot = src->vec3Dot;
+			if (src->vec3Cross) dst.vec3Cross = src->vec3Cross;
+			if (src->vec3Length) dst.vec3Length = src->vec3Length;
+			if (src->vec3Normalize) dst.vec3Normalize = src->vec3Normalize;
+			if (src->vec3Transform) dst.vec3Transform = src->vec3Transform;
+			if (src->vec3MinMax) dst.vec3MinMax = src->vec3MinMax;
+			if (src->quatMul) dst.quatMul = src->quatMul;
+			if (src->quatNlerp) dst.quatNlerp = src->quatNlerp;
+			if (src->quatSlerp) dst.quatSlerp = src->quatSlerp;
+			if (src->quatToAffine) dst.quatToAffine = src->quatToAffine;
+			if (src->frustumAABB) dst.frustumAABB = src->frustumAABB;
+			if (src->frustumSphere) dst.frustumSphere = src->frustumSphere;
+			if (src->rayAABB) dst.rayAABB = src->rayAABB;
+			if (src->rayTriangle) dst.rayTriangle = src->rayTriangle;
+			if (src->aabbTransform) dst.aabbTransform = src->aabbTransform;
+			if (src->affineFromTRS) dst.affineFromTRS = src->affineFromTRS;
+			if (src->affineMulIndexed) dst.affineMulIndexed = src->affineMulIndexed;
+		}
+
+	}
+
+	const KernelTable* kernels::scalar() {
+		return &SCALAR_TABLE;
+	}
+
+
+	////////////////////////////////////////////////////////////////////////////////// DISPATCH
+
+	SimdLevel MathKernels::detect() {
+#if defined(AVT_X86)
+		if (cpuHasAVX2() && kernels::avx2()) return SimdLevel::AVX2;
+		if (cpuHasSSE2() && kernels::sse2()) return SimdLevel::SSE2;
+		return SimdLevel::Scalar;
+#else
+		if (kernels::neon()) return SimdLevel::NEON;
+		return SimdLevel::Scalar;
+#endif
+	}
+
+	bool MathKernels::supported(SimdLevel level) {
+		switch (level) {
+#if defined(AVT_X86)
+		case SimdLevel::SSE2:	return cpuHasSSE2() && kernels::sse2();
+		case SimdLevel::AVX2:	return cpuHasAVX2() && kernels::avx2();
+#else
+		case SimdLevel::NEON:	return kernels::neon() != nullptr;
+#endif
+		case SimdLevel::Scalar:	return true;
+		default:				return false;
+		}
+	}
+
+	KernelTable MathKernels::build(SimdLevel level) {
+		KernelTable t = SCALAR_TABLE;
+
+		switch (level) {
+		case SimdLevel::AVX2:
+			overlay(t, kernels::sse2());
+			overlay(t, kernels::avx2());
+			break;
+		case SimdLevel::SSE2:
+			overlay(t, kernels::sse2());
+			break;
+		case SimdLevel::NEON:
+			overlay(t, kernels::neon());
+			break;
+		default:
+			break;
+		}
+
+		return t;
+	}
+
+	bool MathKernels::setLevel(SimdLevel level) {
+		if (!supported(level)) return false;
+
+		table() = build(level);
+		current() = level;
+		return true;
+	}
+
+	const char* MathKernels::name(SimdLevel level) {
+		switch (level) {
+		case SimdLevel::Scalar:	return "scalar";
+		case SimdLevel::SSE2:	return "sse2";
+		case SimdLevel::AVX2:	return "avx2";
+		case SimdLevel::NEON:	return "neon";
+		default:				return "unknown";
+		}
+	}
+
+}
@@ -0,0 +1,510 @@
+#include "../HeaderFiles/MathKernels.h"
+
+#if defined(_M_X64) || defined(__x86_64__)
+
+#include <immintrin.h>
+#include <cmath>
+#include <limits>
+
+// MSVC emits AVX intrinsics without /arch, gcc/clang need the target enabled per function
+#if defined(__GNUC__) || defined(__clang__)
+#define AVT_AVX2 __attribute__((target("avx2")))
+#else
+#define AVT_AVX2
+#endif
+
+namespace avt {
+
+	namespace {
+
+		// the next level down, it takes what a vector loop leaves over
+		const KernelTable* lower() {
+			return kernels::sse2();
+		}
+
+		// two result columns per iteration: every 128-bit half of a register holds one column
+		AVT_AVX2 void mat4MulAVX2(const float* a, const float* b, float* out) {
+			__m256 a0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a));
+			__m256 a1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a + 4));
+			__m256 a2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a + 8));
+			__m256 a3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a + 12));
+
+			__m256 b01 = _mm256_loadu_ps(b);
+			__m256 b23 = _mm256_loadu_ps(b + 8);
+
+			__m256 r01 = _mm256_mul_ps(a0, _mm256_shuffle_ps(b01, b01, 0x00));
+			r01 = _mm256_add_ps(r01, _mm256_mul_ps(a1, _mm256_shuffle_ps(b01, b01, 0x55)));
+			r01 = _mm256_add_ps(r01, _mm256_mul_ps(a2, _mm256_shuffle_ps(b01, b01, 0xAA)));
+			r01 = _mm256_add_ps(r01, _mm256_mul_ps(a3, _mm256_shuffle_ps(b01, b01, 0xFF)));
+
+			__m256 r23 = _mm256_mul_ps(a0, _mm256_shuffle_ps(b23, b23, 0x00));
+			r23 = _mm256_add_ps(r23, _mm256_mul_ps(a1, _mm256_shuffle_ps(b23, b23, 0x55)));
+			r23 = _mm256_add_ps(r23, _mm256_mul_ps(a2, _mm256_shuffle_ps(b23, b23, 0xAA)));
+			r23 = _mm256_add_ps(r23, _mm256_mul_ps(a3, _mm256_shuffle_ps(b23, b23, 0xFF)));
+
+			_mm256_storeu_ps(out, r01);
+			_mm256_storeu_ps(out + 8, r23);
+		}
+
+		// two points per iteration, the tail goes through the next level down
+		AVT_AVX2 void mat4TransformPointsAVX2(const float* m, float* xyz, size_t count, size_t stride) {
+			__m256 c0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m));
+			__m256 c1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m + 4));
+			__m256 c2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m + 8));
+			__m256 c3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m + 12));
+
+			char* base = reinterpret_cast<char*>(xyz);
+			size_t i = 0;
+			for (; i + 1 < count; i += 2) {
+				float* p = reinterpret_cast<float*>(base + i * stride);
+				float* q = reinterpret_cast<float*>(base + (i + 1) * stride);
+
+				__m256 x = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_set1_ps(p[0])), _mm_set1_ps(q[0]), 1);
+				__m256 y = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_set1_ps(p[1])), _mm_set1_ps(q[1]), 1);
+				__m256 z = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_set1_ps(p[2])), _mm_set1_ps(q[2]), 1);
+
+				__m256 r = _mm256_mul_ps(c0, x);
+				r = _mm256_add_ps(r, _mm256_mul_ps(c1, y));
+				r = _mm256_add_ps(r, _mm256_mul_ps(c2, z));
+				r = _mm256_add_ps(r, c3);
+
+				__m128 rp = _mm256_castps256_ps128(r);
+				__m128 rq = _mm256_extractf128_ps(r, 1);
+				_mm_storel_pi(reinterpret_cast<__m64*>(p), rp);
+				_mm_store_ss(p + 2, _mm_movehl_ps(rp, rp));
+				_mm_storel_pi(reinterpret_cast<__m64*>(q), rq);
+				_mm_store_ss(q + 2, _mm_movehl_ps(rq, rq));
+			}
+
+			if (i < count) lower()->mat4TransformPoints(m, reinterpret_cast<float*>(base + i * stride), count - i, stride);
+		}
+
+		// 8 elements per iteration, the tail goes through the next level down
+		AVT_AVX2 void vec3DotAVX2(Vec3SoA a, Vec3SoA b, float* out, size_t count) {
+			size_t i = 0;
+			for (; i + 8 <= count; i += 8) {
+				__m256 r = _mm256_mul_ps(_mm256_loadu_ps(a.x + i), _mm256_loadu_ps(b.x + i));
+				r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_loadu_ps(a.y + i), _mm256_loadu_ps(b.y + i)));
+				r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_loadu_ps(a.z + i), _mm256_loadu_ps(b.z + i)));
+				_mm256_storeu_ps(out + i, r);
+			}
+
+			if (i < count) lower()->vec3Dot(a.from(i), b.from(i), out + i, count - i);
+		}
+
+		AVT_AVX2 void vec3CrossAVX2(Vec3SoA a, Vec3SoA b, Vec3SoA out, size_t count) {
+			size_t i = 0;
+			for (; i + 8 <= count; i += 8) {
+				__m256 ax = _mm256_loadu_ps(a.x + i), ay = _mm256_loadu_ps(a.y + i), az = _mm256_loadu_ps(a.z + i);
+				__m256 bx = _mm256_loadu_ps(b.x + i), by = _mm256_loadu_ps(b.y + i), bz = _mm256_loadu_ps(b.z + i);
+				_mm256_storeu_ps(out.x + i, _mm256_sub_ps(_mm256_mul_ps(ay, bz), _mm256_mul_ps(az, by)));
+				_mm256_storeu_ps(out.y + i, _mm256_sub_ps(_mm256_mul_ps(az, bx), _mm256_mul_ps(ax, bz)));
+				_mm256_storeu_ps(out.z + i, _mm256_sub_ps(_mm256_mul_ps(ax, by), _mm256_mul_ps(ay, bx)));
+			}
+
+			if (i < count) lower()->vec3Cross(a.from(i), b.from(i), out.from(i), count - i);
+		}
+
+		AVT_AVX2 void vec3LengthAVX2(Vec3SoA v, float* out, size_t count) {
+			size_t i = 0;
+			for (; i + 8 <= count; i += 8) {
+				__m256 x = _mm256_loadu_ps(v.x + i), y = _mm256_loadu_ps(v.y + i), z = _mm256_loadu_ps(v.z + i);
+				__m256 q = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y)), _mm256_mul_ps(z, z));
+				_mm256_storeu_ps(out + i, _mm256_sqrt_ps(q));
+			}
+
+			if (i < count) lower()->vec3Length(v.from(i), out + i, count - i);
+		}
+
+		AVT_AVX2 void vec3NormalizeAVX2(Vec3SoA v, size_t count) {
+			const __m256 zero = _mm256_setzero_ps();
+
+			size_t i = 0;
+			for (; i + 8 <= count; i += 8) {
+				__m256 x = _mm256_loadu_ps(v.x + i), y = _mm256_loadu_ps(v.y + i), z = _mm256_loadu_ps(v.z + i);
+				__m256 len = _mm256_sqrt_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y)), _mm256_mul_ps(z, z)));
+				__m256 keep = _mm256_cmp_ps(len, zero, _CMP_EQ_OQ);
+
+				_mm256_storeu_ps(v.x + i, _mm256_blendv_ps(_mm256_div_ps(x, len), x, keep));
+				_mm256_storeu_ps(v.y + i, _mm256_blendv_ps(_mm256_div_ps(y, len), y, keep));
+				_mm256_storeu_ps(v.z + i, _mm256_blendv_ps(_mm256_div_ps(z, len), z, keep));
+			}
+
+			if (i < count) lower()->vec3Normalize(v.from(i), count - i);
+		}
+
+		AVT_AVX2 void vec3TransformAVX2(const float* m, Vec3SoA v, size_t count, float w) {
+			__m256 m0 = _mm256_set1_ps(m[0]), m4 = _mm256_set1_ps(m[4]), m8 = _mm256_set1_ps(m[8]), tx = _mm256_set1_ps(m[12] * w);
+			__m256 m1 = _mm256_set1_ps(m[1]), m5 = _mm256_set1_ps(m[5]), m9 = _mm256_set1_ps(m[9]), ty = _mm256_set1_ps(m[13] * w);
+			__m256 m2 = _mm256_set1_ps(m[2]), m6 = _mm256_set1_ps(m[6]), m10 = _mm256_set1_ps(m[10]), tz = _mm256_set1_ps(m[14] * w);
+
+			size_t i = 0;
+			for (; i + 8 <= count; i += 8) {
+				__m256 x = _mm256_loadu_ps(v.x + i), y = _mm256_loadu_ps(v.y + i), z = _mm256_loadu_ps(v.z + i);
+				__m256 rx = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m0, x), _mm256_mul_ps(m4, y)), _mm256_mul_ps(m8, z)), tx);
+				__m256 ry = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m1, x), _mm256_mul_ps(m5, y)), _mm256_mul_ps(m9, z)), ty);
+				__m256 rz = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m2, x), _mm256_mul_ps(m6, y)), _mm256_mul_ps(m10, z)), tz);
+				_mm256_storeu_ps(v.x + i, rx);
+				_mm256_storeu_ps(v.y + i, ry);
+				_mm256_storeu_ps(v.z + i, rz);
+			}
+
+			if (i < count) lower()->vec3Transform(m, v.from(i), count - i, w);
+		}
+
+		AVT_AVX2 void vec3MinMaxAVX2(Vec3SoA v, size_t count, float* outMin, float* outMax) {
+			if (count < 16) {
+				lower()->vec3MinMax(v, count, outMin, outMax);
+				return;
+			}
+
+			__m256 mnx = _mm256_loadu_ps(v.x), mny = _mm256_loadu_ps(v.y), mnz = _mm256_loadu_ps(v.z);
+			__m256 mxx = mnx, mxy = mny, mxz = mnz;
+
+			size_t i = 8;
+			for (; i + 8 <= count; i += 8) {
+				__m256 x = _mm256_loadu_ps(v.x + i), y = _mm256_loadu_ps(v.y + i), z = _mm256_loadu_ps(v.z + i);
+				mnx = _mm256_min_ps(x, mnx); mny = _mm256_min_ps(y, mny); mnz = _mm256_min_ps(z, mnz);
+				mxx = _mm256_max_ps(x, mxx); mxy = _mm256_max_ps(y, mxy); mxz = _mm256_max_ps(z, mxz);
+			}
+
+			float lanes[6][8];
+			_mm256_storeu_ps(lanes[0], mnx); _mm256_storeu_ps(lanes[1], mny); _mm256_storeu_ps(lanes[2], mnz);
+			_mm256_storeu_ps(lanes[3], mxx); _mm256_storeu_ps(lanes[4], mxy); _mm256_storeu_ps(lanes[5], mxz);
+
+			float mn[3], mx[3];
+			for (int k = 0; k < 3; k++) {
+				mn[k] = lanes[k][0];
+				mx[k] = lanes[3 + k][0];
+				for (int l = 1; l < 8; l++) {
+					mn[k] = lanes[k][l] < mn[k] ? lanes[k][l] : mn[k];
+					mx[k] = lanes[3 + k][l] > mx[k] ? lanes[3 + k][l] : mx[k];
+				}
+			}
+
+			if (i < count) { // fold the tail in
+				float tmn[3], tmx[3];
+				lower()->vec3MinMax(v.from(i), count - i, tmn, tmx);
+				for (int k = 0; k < 3; k++) {
+					mn[k] = tmn[k] < mn[k] ? tmn[k] : mn[k];
+					mx[k] = tmx[k] > mx[k] ? tmx[k] : mx[k];
+				}
+			}
+
+			for (int k = 0; k < 3; k++) {
+				outMin[k] = mn[k];
+				outMax[k] = mx[k];
+			}
+		}
+
+		AVT_AVX2 inline __m256 loadKAVX2(const float* k, size_t kStride, size_t i) {
+			if (kStride == 0) return _mm256_set1_ps(k[0]);
+			if (kStride == 1) return _mm256_loadu_ps(k + i);
+			const float* p = k + i * kStride;
+			return _mm256_setr_ps(p[0], p[kStride], p[2 * kStride], p[3 * kStride],
+				p[4 * kStride], p[5 * kStride], p[6 * kStride], p[7 * kStride]);
+		}
+
+		AVT_AVX2 void quatMulAVX2(QuatSoA a, QuatSoA b, QuatSoA out, size_t count) {
+			size_t i = 0;
+			for (; i + 8 <= count; i += 8) {
+				__m256 at = _mm256_loadu_ps(a.t + i), ax = _mm256_loadu_ps(a.x + i), ay = _mm256_loadu_ps(a.y + i), az = _mm256_loadu_ps(a.z + i);
+				__m256 bt = _mm256_loadu_ps(b.t + i), bx = _mm256_loadu_ps(b.x + i), by = _mm256_loadu_ps(b.y + i), bz = _mm256_loadu_ps(b.z + i);
+
+				__m256 rt = _mm256_sub_ps(_mm256_sub_ps(_mm256_sub_ps(_mm256_mul_ps(at, bt), _mm256_mul_ps(ax, bx)), _mm256_mul_ps(ay, by)), _mm256_mul_ps(az, bz));
+				__m256 rx = _mm256_sub_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(at, bx), _mm256_mul_ps(ax, bt)), _mm256_mul_ps(ay, bz)), _mm256_mul_ps(az, by));
+				__m256 ry = _mm256_sub_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(at, by), _mm256_mul_ps(ay, bt)), _mm256_mul_ps(az, bx)), _mm256_mul_ps(ax, bz));
+				__m256 rz = _mm256_sub_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(at, bz), _mm256_mul_ps(az, bt)), _mm256_mul_ps(ax, by)), _mm256_mul_ps(ay, bx));
+
+				_mm256_storeu_ps(out.t + i, rt);
+				_mm256_storeu_ps(out.x + i, rx);
+				_mm256_storeu_ps(out.y + i, ry);
+				_mm256_storeu_ps(out.z + i, rz);
+			}
+
+			if (i < count) lower()->quatMul(a.from(i), b.from(i), out.from(i), count - i);
+		}
+
+		AVT_AVX2 inline void quatBlendAVX2(QuatSoA a, QuatSoA b, size_t i, __m256 k0, __m256 k1, QuatSoA out) {
+			__m256 t = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(a.t + i), k0), _mm256_mul_ps(_mm256_loadu_ps(b.t + i), k1));
+			__m256 x = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(a.x + i), k0), _mm256_mul_ps(_mm256_loadu_ps(b.x + i), k1));
+			__m256 y = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(a.y + i), k0), _mm256_mul_ps(_mm256_loadu_ps(b.y + i), k1));
+			__m256 z = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(a.z + i), k0), _mm256_mul_ps(_mm256_loadu_ps(b.z + i), k1));
+
+			__m256 len = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(t, t), _mm256_mul_ps(x, x)), _mm256_mul_ps(y, y)), _mm256_mul_ps(z, z));
+			len = _mm256_sqrt_ps(len);
+
+			_mm256_storeu_ps(out.t + i, _mm256_div_ps(t, len));
+			_mm256_storeu_ps(out.x + i, _mm256_div_ps(x, len));
+			_mm256_storeu_ps(out.y + i, _mm256_div_ps(y, len));
+			_mm256_storeu_ps(out.z + i, _mm256_div_ps(z, len));
+		}
+
+		AVT_AVX2 inline __m256 quatDotAVX2(QuatSoA a, QuatSoA b, size_t i) {
+			__m256 d = _mm256_mul_ps(_mm256_loadu_ps(a.x + i), _mm256_loadu_ps(b.x + i));
+			d = _mm256_add_ps(d, _mm256_mul_ps(_mm256_loadu_ps(a.y + i), _mm256_loadu_ps(b.y + i)));
+			d = _mm256_add_ps(d, _mm256_mul_ps(_mm256_loadu_ps(a.z + i), _mm256_loadu_ps(b.z + i)));
+			return _mm256_add_ps(d, _mm256_mul_ps(_mm256_loadu_ps(a.t + i), _mm256_loadu_ps(b.t + i)));
+		}
+
+		AVT_AVX2 void quatNlerpAVX2(QuatSoA a, QuatSoA b, const float* k, size_t kStride, QuatSoA out, size_t count) {
+			const __m256 one = _mm256_set1_ps(1.0f);
+			const __m256 signBit = _mm256_set1_ps(-0.0f);
+
+			size_t i = 0;
+			for (; i + 8 <= count; i += 8) {
+				__m256 cosangle = quatDotAVX2(a, b, i);
+				__m256 ki = loadKAVX2(k, kStride, i);
+				__m256 k0 = _mm256_sub_ps(one, ki);
+				__m256 positive = _mm256_cmp_ps(cosangle, _mm256_setzero_ps(), _CMP_GT_OQ);
+				__m256 k1 = _mm256_blendv_ps(_mm256_xor_ps(ki, signBit), ki, positive);
+				quatBlendAVX2(a, b, i, k0, k1, out);
+			}
+
+			if (i < count) lower()->quatNlerp(a.from(i), b.from(i), k + i * kStride, kStride, out.from(i), count - i);
+		}
+
+		AVT_AVX2 inline __m256 slerpAcosAVX2(__m256 d) {
+			__m256 p = _mm256_set1_ps(precision::poly::ACOS[0]);
+			for (int j = 1; j < 8; j++) p = _mm256_add_ps(_mm256_mul_ps(p, d), _mm256_set1_ps(precision::poly::ACOS[j]));
+			return _mm256_mul_ps(_mm256_sqrt_ps(_mm256_sub_ps(_mm256_set1_ps(1.0f), d)), p);
+		}
+
+		AVT_AVX2 inline __m256 slerpSinAVX2(__m256 a) {
+			const __m256 halfPi = _mm256_set1_ps(precision::poly::HALF_PI);
+			__m256 folded = _mm256_sub_ps(_mm256_set1_ps(precision::poly::PI), a);
+			__m256 y = _mm256_blendv_ps(a, folded, _mm256_cmp_ps(a, halfPi, _CMP_GT_OQ));
+			__m256 y2 = _mm256_mul_ps(y, y);
+			__m256 p = _mm256_set1_ps(precision::poly::SIN[0]);
+			for (int j = 1; j < 6; j++) p = _mm256_add_ps(_mm256_mul_ps(p, y2), _mm256_set1_ps(precision::poly::SIN[j]));
+			return _mm256_mul_ps(y, p);
+		}
+
+		AVT_AVX2 void quatSlerpAVX2(QuatSoA a, QuatSoA b, const float* k, size_t kStride, QuatSoA out, size_t count) {
+			const __m256 one = _mm256_set1_ps(1.0f);
+			const __m256 signBit = _mm256_set1_ps(-0.0f);
+			const __m256 nlerpDot = _mm256_set1_ps(kernels::SLERP_NLERP_DOT);
+
+			size_t i = 0;
+			for (; i + 8 <= count; i += 8) {
+				__m256 d = quatDotAVX2(a, b, i);
+				__m256 flip = _mm256_and_ps(d, signBit);
+				d = _mm256_xor_ps(d, flip);
+
+				__m256 ki = loadKAVX2(k, kStride, i);
+				__m256 k0 = _mm256_sub_ps(one, ki);
+				__m256 k1 = ki;
+
+				__m256 angle = slerpAcosAVX2(d);
+				__m256 invSin = _mm256_div_ps(one, _mm256_sqrt_ps(_mm256_sub_ps(one, _mm256_mul_ps(d, d))));
+				__m256 s1 = _mm256_mul_ps(slerpSinAVX2(_mm256_mul_ps(k1, angle)), invSin);
+				__m256 s0 = _mm256_mul_ps(slerpSinAVX2(_mm256_mul_ps(k0, angle)), invSin);
+
+				__m256 useNlerp = _mm256_cmp_ps(d, nlerpDot, _CMP_GT_OQ);
+				k0 = _mm256_blendv_ps(s0, k0, useNlerp);
+				k1 = _mm256_xor_ps(_mm256_blendv_ps(s1, k1, useNlerp), flip);
+
+				quatBlendAVX2(a, b, i, k0, k1, out);
+			}
+
+			if (i < count) lower()->quatSlerp(a.from(i), b.from(i), k + i * kStride, kStride, out.from(i), count - i);
+		}
+
+		AVT_AVX2 inline __m256 absAVX2(__m256 v) {
+			return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), v);
+		}
+
+		AVT_AVX2 inline size_t storeMaskAVX2(__m256 mask, uint8_t* out) {
+			int bits = _mm256_movemask_ps(mask);
+			size_t set = 0;
+			for (int l = 0; l < 8; l++) {
+				out[l] = (bits >> l) & 1;
+				set += out[l];
+			}
+			return set;
+		}
+
+		AVT_AVX2 size_t frustumAABBAVX2(const float* planes, Vec3SoA center, Vec3SoA extent, uint8_t* out, size_t count) {
+			const __m256 zero = _mm256_setzero_ps();
+			size_t visible = 0;
+
+			size_t i = 0;
+			for (; i + 8 <= count; i += 8) {
+				__m256 cx = _mm256_loadu_ps(center.x + i), cy = _mm256_loadu_ps(center.y + i), cz = _mm256_loadu_ps(center.z + i);
+				__m256 ex = _mm256_loadu_ps(extent.x + i), ey = _mm256_loadu_ps(extent.y + i), ez = _mm256_loadu_ps(extent.z + i);
+
+				__m256 outside = zero;
+				for (int p = 0; p < 6; p++) {
+					const float* n = planes + 4 * p;
+					__m256 d = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(n[0]), cx), _mm256_mul_ps(_mm256_set1_ps(n[1]), cy)),
+						_mm256_mul_ps(_mm256_set1_ps(n[2]), cz)), _mm256_set1_ps(n[3]));
+					__m256 r = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(std::fabs(n[0])), ex), _mm256_mul_ps(_mm256_set1_ps(std::fabs(n[1])), ey)),
+						_mm256_mul_ps(_mm256_set1_ps(std::fabs(n[2])), ez));
+					outside = _mm256_or_ps(outside, _mm256_cmp_ps(_mm256_add_ps(d, r), zero, _CMP_LT_OQ));
+				}
+				visible += storeMaskAVX2(_mm256_cmp_ps(outside, zero, _CMP_EQ_OQ), out + i);
+			}
+
+			if (i < count) visible += lower()->frustumAABB(planes, center.from(i), extent.from(i), out + i, count - i);
+			return visible;
+		}
+
+		AVT_AVX2 size_t frustumSphereAVX2(const float* planes, Vec3SoA center, const float* radius, uint8_t* out, size_t count) {
+			const __m256 zero = _mm256_setzero_ps();
+			size_t visible = 0;
+
+			size_t i = 0;
+			for (; i + 8 <= count; i += 8) {
+				__m256 cx = _mm256_loadu_ps(center.x + i), cy = _mm256_loadu_ps(center.y + i), cz = _mm256_loadu_ps(center.z + i);
+				__m256 r = _mm256_loadu_ps(radius + i);
+
+				__m256 outside = zero;
+				for (int p = 0; p < 6; p++) {
+					const float* n = planes + 4 * p;
+					__m256 d = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(n[0]), cx), _mm256_mul_ps(_mm256_set1_ps(n[1]), cy)),
+						_mm256_mul_ps(_mm256_set1_ps(n[2]), cz)), _mm256_set1_ps(n[3]));
+					outside = _mm256_or_ps(outside, _mm256_cmp_ps(_mm256_add_ps(d, r), zero, _CMP_LT_OQ));
+				}
+				visible += storeMaskAVX2(_mm256_cmp_ps(outside, zero, _CMP_EQ_OQ), out + i);
+			}
+
+			if (i < count) visible += lower()->frustumSphere(planes, center.from(i), radius + i, out + i, count - i);
+			return visible;
+		}
+
+		AVT_AVX2 void rayAABBAVX2(const float* ray, Vec3SoA center, Vec3SoA extent, float* out, size_t count) {
+			const __m256 inf = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+			const __m256 o[3] = { _mm256_set1_ps(ray[0]), _mm256_set1_ps(ray[1]), _mm256_set1_ps(ray[2]) };
+			const __m256 inv[3] = { _mm256_set1_ps(ray[3]), _mm256_set1_ps(ray[4]), _mm256_set1_ps(ray[5]) };
+			const float* cs[3] = { center.x, center.y, center.z };
+			const float* es[3] = { extent.x, extent.y, extent.z };
+
+			size_t i = 0;
+			for (; i + 8 <= count; i += 8) {
+				__m256 tNear = _mm256_setzero_ps();
+				__m256 tFar = _mm256_set1_ps(ray[6]);
+				for (int k = 0; k < 3; k++) {
+					__m256 c = _mm256_loadu_ps(cs[k] + i), e = _mm256_loadu_ps(es[k] + i);
+					__m256 t1 = _mm256_mul_ps(_mm256_sub_ps(_mm256_sub_ps(c, e), o[k]), inv[k]);
+					__m256 t2 = _mm256_mul_ps(_mm256_sub_ps(_mm256_add_ps(c, e), o[k]), inv[k]);
+					tNear = _mm256_max_ps(tNear, _mm256_min_ps(t1, t2));
+					tFar = _mm256_min_ps(tFar, _mm256_max_ps(t1, t2));
+				}
+				_mm256_storeu_ps(out + i, _mm256_blendv_ps(inf, tNear, _mm256_cmp_ps(tNear, tFar, _CMP_LE_OQ)));
+			}
+
+			if (i < count) lower()->rayAABB(ray, center.from(i), extent.from(i), out + i, count - i);
+		}
+
+		AVT_AVX2 void rayTriangleAVX2(const float* ray, Vec3SoA v0, Vec3SoA v1, Vec3SoA v2, float* out, size_t count) {
+			const __m256 zero = _mm256_setzero_ps();
+			const __m256 one = _mm256_set1_ps(1.0f);
+			const __m256 inf = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+			const __m256 eps = _mm256_set1_ps(kernels::RAY_TRIANGLE_EPSILON);
+			const __m256 ox = _mm256_set1_ps(ray[0]), oy = _mm256_set1_ps(ray[1]), oz = _mm256_set1_ps(ray[2]);
+			const __m256 dx = _mm256_set1_ps(ray[3]), dy = _mm256_set1_ps(ray[4]), dz = _mm256_set1_ps(ray[5]);
+			const __m256 tMax = _mm256_set1_ps(ray[6]);
+
+			size_t i = 0;
+			for (; i + 8 <= count; i += 8) {
+				__m256 ax = _mm256_loadu_ps(v0.x + i), ay = _mm256_loadu_ps(v0.y + i), az = _mm256_loadu_ps(v0.z + i);
+				__m256 e1x = _mm256_sub_ps(_mm256_loadu_ps(v1.x + i), ax), e1y = _mm256_sub_ps(_mm256_loadu_ps(v1.y + i), ay), e1z = _mm256_sub_ps(_mm256_loadu_ps(v1.z + i), az);
+				__m256 e2x = _mm256_sub_ps(_mm256_loadu_ps(v2.x + i), ax), e2y = _mm256_sub_ps(_mm256_loadu_ps(v2.y + i), ay), e2z = _mm256_sub_ps(_mm256_loadu_ps(v2.z + i), az);
+
+				__m256 px = _mm256_sub_ps(_mm256_mul_ps(dy, e2z), _mm256_mul_ps(dz, e2y));
+				__m256 py = _mm256_sub_ps(_mm256_mul_ps(dz, e2x), _mm256_mul_ps(dx, e2z));
+				__m256 pz = _mm256_sub_ps(_mm256_mul_ps(dx, e2y), _mm256_mul_ps(dy, e2x));
+				__m256 det = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(e1x, px), _mm256_mul_ps(e1y, py)), _mm256_mul_ps(e1z, pz));
+				__m256 invDet = _mm256_div_ps(one, det);
+
+				__m256 sx = _mm256_sub_ps(ox, ax), sy = _mm256_sub_ps(oy, ay), sz = _mm256_sub_ps(oz, az);
+				__m256 u = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(sx, px), _mm256_mul_ps(sy, py)), _mm256_mul_ps(sz, pz)), invDet);
+
+				__m256 qx = _mm256_sub_ps(_mm256_mul_ps(sy, e1z), _mm256_mul_ps(sz, e1y));
+				__m256 qy = _mm256_sub_ps(_mm256_mul_ps(sz, e1x), _mm256_mul_ps(sx, e1z));
+				__m256 qz = _mm256_sub_ps(_mm256_mul_ps(sx, e1y), _mm256_mul_ps(sy, e1x));
+				__m256 v = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, qx), _mm256_mul_ps(dy, qy)), _mm256_mul_ps(dz, qz)), invDet);
+				__m256 t = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(e2x, qx), _mm256_mul_ps(e2y, qy)), _mm256_mul_ps(e2z, qz)), invDet);
+
+				__m256 hit = _mm256_cmp_ps(absAVX2(det), eps, _CMP_GT_OQ);
+				hit = _mm256_and_ps(hit, _mm256_and_ps(_mm256_cmp_ps(u, zero, _CMP_GE_OQ), _mm256_cmp_ps(v, zero, _CMP_GE_OQ)));
+				hit = _mm256_and_ps(hit, _mm256_cmp_ps(_mm256_add_ps(u, v), one, _CMP_LE_OQ));
+				hit = _mm256_and_ps(hit, _mm256_and_ps(_mm256_cmp_ps(t, zero, _CMP_GE_OQ), _mm256_cmp_ps(t, tMax, _CMP_LE_OQ)));
+				_mm256_storeu_ps(out + i, _mm256_blendv_ps(inf, t, hit));
+			}
+
+			if (i < count) lower()->rayTriangle(ray, v0.from(i), v1.from(i), v2.from(i), out + i, count - i);
+		}
+
+		// one element at a time: broadcast loads of the child's cells scale the parent's columns,
+		// which skips the 4x4 transposes the SSE2 version needs on the way in and out
+		AVT_AVX2 void affineMulIndexedAVX2(const float* parents, const uint32_t* index, const float* local, float* out, size_t count) {
+			for (size_t i = 0; i < count; i++, local += 12, out += 12) {
+				const float* a = parents + 12 * size_t(index[i]);
+				__m128 a0 = _mm_loadu_ps(a), a1 = _mm_loadu_ps(a + 3), a2 = _mm_loadu_ps(a + 6);
+				__m128 a3 = _mm_loadu_ps(a + 8);
+				a3 = _mm_shuffle_ps(a3, a3, _MM_SHUFFLE(3, 3, 2, 1));
+
+				__m128 r0 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a0, _mm_broadcast_ss(local)), _mm_mul_ps(a1, _mm_broadcast_ss(local + 1))),
+					_mm_mul_ps(a2, _mm_broadcast_ss(local + 2)));
+				__m128 r1 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a0, _mm_broadcast_ss(local + 3)), _mm_mul_ps(a1, _mm_broadcast_ss(local + 4))),
+					_mm_mul_ps(a2, _mm_broadcast_ss(local + 5)));
+				__m128 r2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a0, _mm_broadcast_ss(local + 6)), _mm_mul_ps(a1, _mm_broadcast_ss(local + 7))),
+					_mm_mul_ps(a2, _mm_broadcast_ss(local + 8)));
+				__m128 r3 = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(a0, _mm_broadcast_ss(local + 9)), _mm_mul_ps(a1, _mm_broadcast_ss(local + 10))),
+					_mm_mul_ps(a2, _mm_broadcast_ss(local + 11))), a3);
+
+				// the 4th lane of each store is overwritten by the next one, the last one stores 3 lanes
+				// so it never touches the following element (which may be the next input)
+				_mm_storeu_ps(out, r0);
+				_mm_storeu_ps(out + 3, r1);
+				_mm_storeu_ps(out + 6, r2);
+				_mm_storel_pi(reinterpret_cast<__m64*>(out + 9), r3);
+				_mm_store_ss(out + 11, _mm_movehl_ps(r3, r3));
+			}
+		}
+
+		const KernelTable AVX2_TABLE = {
+			mat4MulAVX2,
+			nullptr, // a single mat * vec gains nothing over SSE2
+			nullptr,
+			mat4TransformPointsAVX2,
+			nullptr,
+			vec3DotAVX2,
+			vec3CrossAVX2,
+			vec3LengthAVX2,
+			vec3NormalizeAVX2,
+			vec3TransformAVX2,
+			vec3MinMaxAVX2,
+			quatMulAVX2,
+			quatNlerpAVX2,
+			quatSlerpAVX2,
+			nullptr, // the 3x4 output transposes gain nothing over SSE2
+			frustumAABBAVX2,
+			frustumSphereAVX2,
+			rayAABBAVX2,
+			rayTriangleAVX2,
+			nullptr, // bound by the transposes of the per-box transforms, same as quatToAffine
+			nullptr, // AoS in and out, same transposes as quatToAffine
+			affineMulIndexedAVX2
+		};
+
+	}
+
+	const KernelTable* kernels::avx2() {
+		return &AVX2_TABLE;
+	}
+
+}
+
+#else
+
+namespace avt {
+
+	const KernelTable* kernels::avx2() {
+		return nullptr;
+	}
+
+}
+
+#endif
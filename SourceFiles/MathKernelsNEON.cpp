@@ -0,0 +1,116 @@
+#include "../HeaderFiles/MathKernels.h"
+
+#if defined(__ARM_NEON) || defined(_M_ARM64)
+
+#if defined(_M_ARM64)
+#include <arm64_neon.h>
+#else
+#include <arm_neon.h>
+#endif
+
+namespace avt {
+
+	namespace {
+
+		// separate vmul + vadd (never vmla/vfma) to keep the scalar rounding
+		void mat4MulNEON(const float* a, const float* b, float* out) {
+			float32x4_t a0 = vld1q_f32(a);
+			float32x4_t a1 = vld1q_f32(a + 4);
+			float32x4_t a2 = vld1q_f32(a + 8);
+			float32x4_t a3 = vld1q_f32(a + 12);
+
+			float32x4_t res[4];
+			for (int col = 0; col < 4; col++) {
+				const float* bc = b + 4 * col;
+				float32x4_t r = vmulq_n_f32(a0, bc[0]);
+				r = vaddq_f32(r, vmulq_n_f32(a1, bc[1]));
+				r = vaddq_f32(r, vmulq_n_f32(a2, bc[2]));
+				r = vaddq_f32(r, vmulq_n_f32(a3, bc[3]));
+				res[col] = r;
+			}
+
+			vst1q_f32(out, res[0]);
+			vst1q_f32(out + 4, res[1]);
+			vst1q_f32(out + 8, res[2]);
+			vst1q_f32(out + 12, res[3]);
+		}
+
+		void mat4MulVec4NEON(const float* m, const float* v, float* out) {
+			float32x4_t r = vmulq_n_f32(vld1q_f32(m), v[0]);
+			r = vaddq_f32(r, vmulq_n_f32(vld1q_f32(m + 4), v[1]));
+			r = vaddq_f32(r, vmulq_n_f32(vld1q_f32(m + 8), v[2]));
+			r = vaddq_f32(r, vmulq_n_f32(vld1q_f32(m + 12), v[3]));
+			vst1q_f32(out, r);
+		}
+
+		void mat4TransposeNEON(const float* m, float* out) {
+			float32x4x4_t cols = vld4q_f32(m); // de-interleaving load is a transpose
+			vst1q_f32(out, cols.val[0]);
+			vst1q_f32(out + 4, cols.val[1]);
+			vst1q_f32(out + 8, cols.val[2]);
+			vst1q_f32(out + 12, cols.val[3]);
+		}
+
+		void mat4TransformPointsNEON(const float* m, float* xyz, size_t count, size_t stride) {
+			float32x4_t c0 = vld1q_f32(m);
+			float32x4_t c1 = vld1q_f32(m + 4);
+			float32x4_t c2 = vld1q_f32(m + 8);
+			float32x4_t c3 = vld1q_f32(m + 12);
+
+			char* base = reinterpret_cast<char*>(xyz);
+			for (size_t i = 0; i < count; i++) {
+				float* p = reinterpret_cast<float*>(base + i * stride);
+				float32x4_t r = vmulq_n_f32(c0, p[0]);
+				r = vaddq_f32(r, vmulq_n_f32(c1, p[1]));
+				r = vaddq_f32(r, vmulq_n_f32(c2, p[2]));
+				r = vaddq_f32(r, c3);
+
+				vst1_f32(p, vget_low_f32(r));
+				vst1q_lane_f32(p + 2, r, 2);
+			}
+		}
+
+		const KernelTable NEON_TABLE = {
+			mat4MulNEON,
+			mat4MulVec4NEON,
+			mat4TransposeNEON,
+			mat4TransformPointsNEON,
+			nullptr, // scalar cofactor inverse
+			nullptr, // batch Vector3 and Quaternion kernels fall back to scalar
+			nullptr,
+			nullptr,
+			nullptr,
+			nullptr,
+			nullptr,
+			nullptr,
+			nullptr,
+			nullptr,
+			nullptr,
+			nullptr, // bounding volume tests as well
+			nullptr,
+			nullptr,
+			nullptr,
+			nullptr,
+			nullptr, // and the hierarchy passes
+			nullptr
+		};
+
+	}
+
+	const KernelTable* kernels::neon() {
+		return &NEON_TABLE;
+	}
+
+}
+
+#else
+
+namespace avt {
+
+	const KernelTable* kernels::neon() {
+		return nullptr;
+	}
+
+}
+
+#endif
@@ -0,0 +1,728 @@
+#include "../HeaderFiles/MathKernels.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+
+#include <emmintrin.h>
+#include <cmath>
+#include <limits>
+
+namespace avt {
+
+	namespace {
+
+		// the next level down, it takes what a vector loop leaves over
+		const KernelTable* lower() {
+			return kernels::scalar();
+		}
+
+		// column c of the result is a0 * b[c][0] + a1 * b[c][1] + a2 * b[c][2] + a3 * b[c][3]
+		void mat4MulSSE(const float* a, const float* b, float* out) {
+			__m128 a0 = _mm_loadu_ps(a);
+			__m128 a1 = _mm_loadu_ps(a + 4);
+			__m128 a2 = _mm_loadu_ps(a + 8);
+			__m128 a3 = _mm_loadu_ps(a + 12);
+
+			__m128 res[4];
+			for (int col = 0; col < 4; col++) {
+				const float* bc = b + 4 * col;
+				__m128 r = _mm_mul_ps(a0, _mm_set1_ps(bc[0]));
+				r = _mm_add_ps(r, _mm_mul_ps(a1, _mm_set1_ps(bc[1])));
+				r = _mm_add_ps(r, _mm_mul_ps(a2, _mm_set1_ps(bc[2])));
+				r = _mm_add_ps(r, _mm_mul_ps(a3, _mm_set1_ps(bc[3])));
+				res[col] = r;
+			}
+
+			_mm_storeu_ps(out, res[0]);
+			_mm_storeu_ps(out + 4, res[1]);
+			_mm_storeu_ps(out + 8, res[2]);
+			_mm_storeu_ps(out + 12, res[3]);
+		}
+
+		void mat4MulVec4SSE(const float* m, const float* v, float* out) {
+			__m128 r = _mm_mul_ps(_mm_loadu_ps(m), _mm_set1_ps(v[0]));
+			r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(m + 4), _mm_set1_ps(v[1])));
+			r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(m + 8), _mm_set1_ps(v[2])));
+			r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(m + 12), _mm_set1_ps(v[3])));
+			_mm_storeu_ps(out, r);
+		}
+
+		void mat4TransposeSSE(const float* m, float* out) {
+			__m128 c0 = _mm_loadu_ps(m);
+			__m128 c1 = _mm_loadu_ps(m + 4);
+			__m128 c2 = _mm_loadu_ps(m + 8);
+			__m128 c3 = _mm_loadu_ps(m + 12);
+			_MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+			_mm_storeu_ps(out, c0);
+			_mm_storeu_ps(out + 4, c1);
+			_mm_storeu_ps(out + 8, c2);
+			_mm_storeu_ps(out + 12, c3);
+		}
+
+		void mat4TransformPointsSSE(const float* m, float* xyz, size_t count, size_t stride) {
+			__m128 c0 = _mm_loadu_ps(m);
+			__m128 c1 = _mm_loadu_ps(m + 4);
+			__m128 c2 = _mm_loadu_ps(m + 8);
+			__m128 c3 = _mm_loadu_ps(m + 12);
+
+			char* base = reinterpret_cast<char*>(xyz);
+			for (size_t i = 0; i < count; i++) {
+				float* p = reinterpret_cast<float*>(base + i * stride);
+				__m128 r = _mm_mul_ps(c0, _mm_set1_ps(p[0]));
+				r = _mm_add_ps(r, _mm_mul_ps(c1, _mm_set1_ps(p[1])));
+				r = _mm_add_ps(r, _mm_mul_ps(c2, _mm_set1_ps(p[2])));
+				r = _mm_add_ps(r, c3);
+
+				// store xyz only, the 4th float belongs to whatever follows the point
+				_mm_storel_pi(reinterpret_cast<__m64*>(p), r);
+				_mm_store_ss(p + 2, _mm_movehl_ps(r, r));
+			}
+		}
+
+		// 2x2 sub-determinants of two rows: lo = (d01, d02, d03, d12), hi = (d13, d23, d13, d23)
+		inline void pairDetsSSE(__m128 a, __m128 b, __m128& lo, __m128& hi) {
+			lo = _mm_sub_ps(
+				_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 0, 0, 0)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 3, 2, 1))),
+				_mm_mul_ps(_mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 0, 0)), _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 2, 1))));
+			hi = _mm_sub_ps(
+				_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 1, 2, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 3, 3, 3))),
+				_mm_mul_ps(_mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 1, 2, 1)), _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 3, 3, 3))));
+		}
+
+		// one adjugate column (before the alternating signs) from a row and the opposite pair's sub-determinants
+		inline __m128 adjColumnSSE(__m128 r, __m128 lo, __m128 hi) {
+			__m128 t = _mm_shuffle_ps(hi, lo, _MM_SHUFFLE(3, 2, 1, 0)); // (d13, d23, d03, d12)
+
+			__m128 a = _mm_mul_ps(_mm_shuffle_ps(r, r, _MM_SHUFFLE(0, 0, 0, 1)), _mm_shuffle_ps(t, t, _MM_SHUFFLE(3, 0, 1, 1)));
+			__m128 b = _mm_mul_ps(_mm_shuffle_ps(r, r, _MM_SHUFFLE(1, 1, 2, 2)), _mm_shuffle_ps(t, lo, _MM_SHUFFLE(1, 2, 2, 0)));
+			__m128 c = _mm_mul_ps(_mm_shuffle_ps(r, r, _MM_SHUFFLE(2, 3, 3, 3)), _mm_shuffle_ps(lo, lo, _MM_SHUFFLE(0, 0, 1, 3)));
+
+			return _mm_add_ps(_mm_sub_ps(a, b), c);
+		}
+
+		// same cofactor scheme as the scalar kernel, one inverse column per register
+		float mat4InverseSSE(const float* m, float* out) {
+			__m128 r0 = _mm_loadu_ps(m);
+			__m128 r1 = _mm_loadu_ps(m + 4);
+			__m128 r2 = _mm_loadu_ps(m + 8);
+			__m128 r3 = _mm_loadu_ps(m + 12);
+			_MM_TRANSPOSE4_PS(r0, r1, r2, r3); // columns -> rows
+
+			__m128 sLo, sHi, cLo, cHi;
+			pairDetsSSE(r0, r1, sLo, sHi);
+			pairDetsSSE(r2, r3, cLo, cHi);
+
+			const __m128 plusMinus = _mm_setr_ps(1.0f, -1.0f, 1.0f, -1.0f);
+			const __m128 minusPlus = _mm_setr_ps(-1.0f, 1.0f, -1.0f, 1.0f);
+
+			__m128 col0 = _mm_mul_ps(adjColumnSSE(r1, cLo, cHi), plusMinus);
+			__m128 col1 = _mm_mul_ps(adjColumnSSE(r0, cLo, cHi), minusPlus);
+			__m128 col2 = _mm_mul_ps(adjColumnSSE(r3, sLo, sHi), plusMinus);
+			__m128 col3 = _mm_mul_ps(adjColumnSSE(r2, sLo, sHi), minusPlus);
+
+			// det = row0 . adjugate column 0, summed into every lane
+			__m128 d = _mm_mul_ps(r0, col0);
+			d = _mm_add_ps(d, _mm_shuffle_ps(d, d, _MM_SHUFFLE(1, 0, 3, 2)));
+			d = _mm_add_ps(d, _mm_shuffle_ps(d, d, _MM_SHUFFLE(2, 3, 0, 1)));
+
+			float det = _mm_cvtss_f32(d);
+			if (det == 0) return det;
+
+			__m128 invDet = _mm_div_ps(_mm_set1_ps(1.0f), d);
+			_mm_storeu_ps(out, _mm_mul_ps(col0, invDet));
+			_mm_storeu_ps(out + 4, _mm_mul_ps(col1, invDet));
+			_mm_storeu_ps(out + 8, _mm_mul_ps(col2, invDet));
+			_mm_storeu_ps(out + 12, _mm_mul_ps(col3, invDet));
+			return det;
+		}
+
+		// 4 elements per iteration, the tail goes through the next level down
+		void vec3DotSSE(Vec3SoA a, Vec3SoA b, float* out, size_t count) {
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4) {
+				__m128 r = _mm_mul_ps(_mm_loadu_ps(a.x + i), _mm_loadu_ps(b.x + i));
+				r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(a.y + i), _mm_loadu_ps(b.y + i)));
+				r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(a.z + i), _mm_loadu_ps(b.z + i)));
+				_mm_storeu_ps(out + i, r);
+			}
+
+			if (i < count) lower()->vec3Dot(a.from(i), b.from(i), out + i, count - i);
+		}
+
+		void vec3CrossSSE(Vec3SoA a, Vec3SoA b, Vec3SoA out, size_t count) {
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4) {
+				__m128 ax = _mm_loadu_ps(a.x + i), ay = _mm_loadu_ps(a.y + i), az = _mm_loadu_ps(a.z + i);
+				__m128 bx = _mm_loadu_ps(b.x + i), by = _mm_loadu_ps(b.y + i), bz = _mm_loadu_ps(b.z + i);
+				_mm_storeu_ps(out.x + i, _mm_sub_ps(_mm_mul_ps(ay, bz), _mm_mul_ps(az, by)));
+				_mm_storeu_ps(out.y + i, _mm_sub_ps(_mm_mul_ps(az, bx), _mm_mul_ps(ax, bz)));
+				_mm_storeu_ps(out.z + i, _mm_sub_ps(_mm_mul_ps(ax, by), _mm_mul_ps(ay, bx)));
+			}
+
+			if (i < count) lower()->vec3Cross(a.from(i), b.from(i), out.from(i), count - i);
+		}
+
+		void vec3LengthSSE(Vec3SoA v, float* out, size_t count) {
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4) {
+				__m128 x = _mm_loadu_ps(v.x + i), y = _mm_loadu_ps(v.y + i), z = _mm_loadu_ps(v.z + i);
+				__m128 q = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+				_mm_storeu_ps(out + i, _mm_sqrt_ps(q));
+			}
+
+			if (i < count) lower()->vec3Length(v.from(i), out + i, count - i);
+		}
+
+		// exact sqrt and division (no rsqrt) so the result matches Vector3::normalize
+		void vec3NormalizeSSE(Vec3SoA v, size_t count) {
+			const __m128 zero = _mm_setzero_ps();
+
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4) {
+				__m128 x = _mm_loadu_ps(v.x + i), y = _mm_loadu_ps(v.y + i), z = _mm_loadu_ps(v.z + i);
+				__m128 len = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z)));
+				__m128 keep = _mm_cmpeq_ps(len, zero);
+
+				// select(keep, v, v / len) without SSE4.1 blends
+				x = _mm_or_ps(_mm_and_ps(keep, x), _mm_andnot_ps(keep, _mm_div_ps(x, len)));
+				y = _mm_or_ps(_mm_and_ps(keep, y), _mm_andnot_ps(keep, _mm_div_ps(y, len)));
+				z = _mm_or_ps(_mm_and_ps(keep, z), _mm_andnot_ps(keep, _mm_div_ps(z, len)));
+
+				_mm_storeu_ps(v.x + i, x);
+				_mm_storeu_ps(v.y + i, y);
+				_mm_storeu_ps(v.z + i, z);
+			}
+
+			if (i < count) lower()->vec3Normalize(v.from(i), count - i);
+		}
+
+		void vec3TransformSSE(const float* m, Vec3SoA v, size_t count, float w) {
+			__m128 m0 = _mm_set1_ps(m[0]), m4 = _mm_set1_ps(m[4]), m8 = _mm_set1_ps(m[8]), tx = _mm_set1_ps(m[12] * w);
+			__m128 m1 = _mm_set1_ps(m[1]), m5 = _mm_set1_ps(m[5]), m9 = _mm_set1_ps(m[9]), ty = _mm_set1_ps(m[13] * w);
+			__m128 m2 = _mm_set1_ps(m[2]), m6 = _mm_set1_ps(m[6]), m10 = _mm_set1_ps(m[10]), tz = _mm_set1_ps(m[14] * w);
+
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4) {
+				__m128 x = _mm_loadu_ps(v.x + i), y = _mm_loadu_ps(v.y + i), z = _mm_loadu_ps(v.z + i);
+				__m128 rx = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m0, x), _mm_mul_ps(m4, y)), _mm_mul_ps(m8, z)), tx);
+				__m128 ry = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m1, x), _mm_mul_ps(m5, y)), _mm_mul_ps(m9, z)), ty);
+				__m128 rz = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m2, x), _mm_mul_ps(m6, y)), _mm_mul_ps(m10, z)), tz);
+				_mm_storeu_ps(v.x + i, rx);
+				_mm_storeu_ps(v.y + i, ry);
+				_mm_storeu_ps(v.z + i, rz);
+			}
+
+			if (i < count) lower()->vec3Transform(m, v.from(i), count - i, w);
+		}
+
+		// _mm_min_ps(a, b) is a < b ? a : b, the same select as the scalar loop
+		void vec3MinMaxSSE(Vec3SoA v, size_t count, float* outMin, float* outMax) {
+			if (count < 8) {
+				lower()->vec3MinMax(v, count, outMin, outMax);
+				return;
+			}
+
+			__m128 mnx = _mm_loadu_ps(v.x), mny = _mm_loadu_ps(v.y), mnz = _mm_loadu_ps(v.z);
+			__m128 mxx = mnx, mxy = mny, mxz = mnz;
+
+			size_t i = 4;
+			for (; i + 4 <= count; i += 4) {
+				__m128 x = _mm_loadu_ps(v.x + i), y = _mm_loadu_ps(v.y + i), z = _mm_loadu_ps(v.z + i);
+				mnx = _mm_min_ps(x, mnx); mny = _mm_min_ps(y, mny); mnz = _mm_min_ps(z, mnz);
+				mxx = _mm_max_ps(x, mxx); mxy = _mm_max_ps(y, mxy); mxz = _mm_max_ps(z, mxz);
+			}
+
+			float lanes[6][4];
+			_mm_storeu_ps(lanes[0], mnx); _mm_storeu_ps(lanes[1], mny); _mm_storeu_ps(lanes[2], mnz);
+			_mm_storeu_ps(lanes[3], mxx); _mm_storeu_ps(lanes[4], mxy); _mm_storeu_ps(lanes[5], mxz);
+
+			float mn[3], mx[3];
+			for (int k = 0; k < 3; k++) {
+				mn[k] = lanes[k][0];
+				mx[k] = lanes[3 + k][0];
+				for (int l = 1; l < 4; l++) {
+					mn[k] = lanes[k][l] < mn[k] ? lanes[k][l] : mn[k];
+					mx[k] = lanes[3 + k][l] > mx[k] ? lanes[3 + k][l] : mx[k];
+				}
+			}
+
+			if (i < count) { // fold the tail in
+				float tmn[3], tmx[3];
+				lower()->vec3MinMax(v.from(i), count - i, tmn, tmx);
+				for (int k = 0; k < 3; k++) {
+					mn[k] = tmn[k] < mn[k] ? tmn[k] : mn[k];
+					mx[k] = tmx[k] > mx[k] ? tmx[k] : mx[k];
+				}
+			}
+
+			for (int k = 0; k < 3; k++) {
+				outMin[k] = mn[k];
+				outMax[k] = mx[k];
+			}
+		}
+
+		inline __m128 selectSSE(__m128 mask, __m128 a, __m128 b) {
+			return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+		}
+
+		inline __m128 loadKSSE(const float* k, size_t kStride, size_t i) {
+			if (kStride == 0) return _mm_set1_ps(k[0]);
+			if (kStride == 1) return _mm_loadu_ps(k + i);
+			const float* p = k + i * kStride;
+			return _mm_setr_ps(p[0], p[kStride], p[2 * kStride], p[3 * kStride]);
+		}
+
+		void quatMulSSE(QuatSoA a, QuatSoA b, QuatSoA out, size_t count) {
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4) {
+				__m128 at = _mm_loadu_ps(a.t + i), ax = _mm_loadu_ps(a.x + i), ay = _mm_loadu_ps(a.y + i), az = _mm_loadu_ps(a.z + i);
+				__m128 bt = _mm_loadu_ps(b.t + i), bx = _mm_loadu_ps(b.x + i), by = _mm_loadu_ps(b.y + i), bz = _mm_loadu_ps(b.z + i);
+
+				__m128 rt = _mm_sub_ps(_mm_sub_ps(_mm_sub_ps(_mm_mul_ps(at, bt), _mm_mul_ps(ax, bx)), _mm_mul_ps(ay, by)), _mm_mul_ps(az, bz));
+				__m128 rx = _mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(at, bx), _mm_mul_ps(ax, bt)), _mm_mul_ps(ay, bz)), _mm_mul_ps(az, by));
+				__m128 ry = _mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(at, by), _mm_mul_ps(ay, bt)), _mm_mul_ps(az, bx)), _mm_mul_ps(ax, bz));
+				__m128 rz = _mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(at, bz), _mm_mul_ps(az, bt)), _mm_mul_ps(ax, by)), _mm_mul_ps(ay, bx));
+
+				_mm_storeu_ps(out.t + i, rt);
+				_mm_storeu_ps(out.x + i, rx);
+				_mm_storeu_ps(out.y + i, ry);
+				_mm_storeu_ps(out.z + i, rz);
+			}
+
+			if (i < count) lower()->quatMul(a.from(i), b.from(i), out.from(i), count - i);
+		}
+
+		// (a * k0 + b * k1).normalized() for 4 elements starting at i
+		inline void quatBlendSSE(QuatSoA a, QuatSoA b, size_t i, __m128 k0, __m128 k1, QuatSoA out) {
+			__m128 t = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(a.t + i), k0), _mm_mul_ps(_mm_loadu_ps(b.t + i), k1));
+			__m128 x = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(a.x + i), k0), _mm_mul_ps(_mm_loadu_ps(b.x + i), k1));
+			__m128 y = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(a.y + i), k0), _mm_mul_ps(_mm_loadu_ps(b.y + i), k1));
+			__m128 z = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(a.z + i), k0), _mm_mul_ps(_mm_loadu_ps(b.z + i), k1));
+
+			__m128 len = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(t, t), _mm_mul_ps(x, x)), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+			len = _mm_sqrt_ps(len);
+
+			_mm_storeu_ps(out.t + i, _mm_div_ps(t, len));
+			_mm_storeu_ps(out.x + i, _mm_div_ps(x, len));
+			_mm_storeu_ps(out.y + i, _mm_div_ps(y, len));
+			_mm_storeu_ps(out.z + i, _mm_div_ps(z, len));
+		}
+
+		// x * y + z * w + ... in the x, y, z, t order of the scalar dot products
+		inline __m128 quatDotSSE(QuatSoA a, QuatSoA b, size_t i) {
+			__m128 d = _mm_mul_ps(_mm_loadu_ps(a.x + i), _mm_loadu_ps(b.x + i));
+			d = _mm_add_ps(d, _mm_mul_ps(_mm_loadu_ps(a.y + i), _mm_loadu_ps(b.y + i)));
+			d = _mm_add_ps(d, _mm_mul_ps(_mm_loadu_ps(a.z + i), _mm_loadu_ps(b.z + i)));
+			return _mm_add_ps(d, _mm_mul_ps(_mm_loadu_ps(a.t + i), _mm_loadu_ps(b.t + i)));
+		}
+
+		void quatNlerpSSE(QuatSoA a, QuatSoA b, const float* k, size_t kStride, QuatSoA out, size_t count) {
+			const __m128 one = _mm_set1_ps(1.0f);
+			const __m128 signBit = _mm_set1_ps(-0.0f);
+
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4) {
+				__m128 cosangle = quatDotSSE(a, b, i);
+				__m128 ki = loadKSSE(k, kStride, i);
+				__m128 k0 = _mm_sub_ps(one, ki);
+				__m128 k1 = selectSSE(_mm_cmpgt_ps(cosangle, _mm_setzero_ps()), ki, _mm_xor_ps(ki, signBit));
+				quatBlendSSE(a, b, i, k0, k1, out);
+			}
+
+			if (i < count) lower()->quatNlerp(a.from(i), b.from(i), k + i * kStride, kStride, out.from(i), count - i);
+		}
+
+		inline __m128 slerpAcosSSE(__m128 d) {
+			__m128 p = _mm_set1_ps(precision::poly::ACOS[0]);
+			for (int j = 1; j < 8; j++) p = _mm_add_ps(_mm_mul_ps(p, d), _mm_set1_ps(precision::poly::ACOS[j]));
+			return _mm_mul_ps(_mm_sqrt_ps(_mm_sub_ps(_mm_set1_ps(1.0f), d)), p);
+		}
+
+		inline __m128 slerpSinSSE(__m128 a) {
+			const __m128 halfPi = _mm_set1_ps(precision::poly::HALF_PI);
+			__m128 y = selectSSE(_mm_cmpgt_ps(a, halfPi), _mm_sub_ps(_mm_set1_ps(precision::poly::PI), a), a);
+			__m128 y2 = _mm_mul_ps(y, y);
+			__m128 p = _mm_set1_ps(precision::poly::SIN[0]);
+			for (int j = 1; j < 6; j++) p = _mm_add_ps(_mm_mul_ps(p, y2), _mm_set1_ps(precision::poly::SIN[j]));
+			return _mm_mul_ps(y, p);
+		}
+
+		// both branches of the scalar kernel evaluated, then selected per lane
+		void quatSlerpSSE(QuatSoA a, QuatSoA b, const float* k, size_t kStride, QuatSoA out, size_t count) {
+			const __m128 one = _mm_set1_ps(1.0f);
+			const __m128 signBit = _mm_set1_ps(-0.0f);
+			const __m128 nlerpDot = _mm_set1_ps(kernels::SLERP_NLERP_DOT);
+
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4) {
+				__m128 d = quatDotSSE(a, b, i);
+				__m128 flip = _mm_and_ps(d, signBit);
+				d = _mm_xor_ps(d, flip);
+
+				__m128 ki = loadKSSE(k, kStride, i);
+				__m128 k0 = _mm_sub_ps(one, ki);
+				__m128 k1 = ki;
+
+				__m128 angle = slerpAcosSSE(d);
+				__m128 invSin = _mm_div_ps(one, _mm_sqrt_ps(_mm_sub_ps(one, _mm_mul_ps(d, d))));
+				__m128 s1 = _mm_mul_ps(slerpSinSSE(_mm_mul_ps(k1, angle)), invSin);
+				__m128 s0 = _mm_mul_ps(slerpSinSSE(_mm_mul_ps(k0, angle)), invSin);
+
+				__m128 useNlerp = _mm_cmpgt_ps(d, nlerpDot);
+				k0 = selectSSE(useNlerp, k0, s0);
+				k1 = _mm_xor_ps(selectSSE(useNlerp, k1, s1), flip);
+
+				quatBlendSSE(a, b, i, k0, k1, out);
+			}
+
+			if (i < count) lower()->quatSlerp(a.from(i), b.from(i), k + i * kStride, kStride, out.from(i), count - i);
+		}
+
+		// 4 rotations computed column-wise, then transposed into 12-float records
+		void quatToAffineSSE(QuatSoA q, float* out, size_t count) {
+			const __m128 one = _mm_set1_ps(1.0f);
+			const __m128 two = _mm_set1_ps(2.0f);
+
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4, out += 48) {
+				__m128 qt = _mm_loadu_ps(q.t + i), qx = _mm_loadu_ps(q.x + i), qy = _mm_loadu_ps(q.y + i), qz = _mm_loadu_ps(q.z + i);
+				__m128 len = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(qt, qt), _mm_mul_ps(qx, qx)), _mm_mul_ps(qy, qy)), _mm_mul_ps(qz, qz));
+				len = _mm_sqrt_ps(len);
+				qt = _mm_div_ps(qt, len);
+				qx = _mm_div_ps(qx, len);
+				qy = _mm_div_ps(qy, len);
+				qz = _mm_div_ps(qz, len);
+
+				__m128 xx = _mm_mul_ps(qx, qx), xy = _mm_mul_ps(qx, qy), xz = _mm_mul_ps(qx, qz), xt = _mm_mul_ps(qx, qt);
+				__m128 yy = _mm_mul_ps(qy, qy), yz = _mm_mul_ps(qy, qz), yt = _mm_mul_ps(qy, qt);
+				__m128 zz = _mm_mul_ps(qz, qz), zt = _mm_mul_ps(qz, qt);
+
+				__m128 c0 = _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(yy, zz)));
+				__m128 c1 = _mm_mul_ps(two, _mm_add_ps(xy, zt));
+				__m128 c2 = _mm_mul_ps(two, _mm_sub_ps(xz, yt));
+				__m128 c3 = _mm_mul_ps(two, _mm_sub_ps(xy, zt));
+				__m128 c4 = _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, zz)));
+				__m128 c5 = _mm_mul_ps(two, _mm_add_ps(yz, xt));
+				__m128 c6 = _mm_mul_ps(two, _mm_add_ps(xz, yt));
+				__m128 c7 = _mm_mul_ps(two, _mm_sub_ps(yz, xt));
+				__m128 c8 = _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, yy)));
+				__m128 z0 = _mm_setzero_ps(), z1 = _mm_setzero_ps(), z2 = _mm_setzero_ps();
+
+				_MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+				_MM_TRANSPOSE4_PS(c4, c5, c6, c7);
+				_MM_TRANSPOSE4_PS(c8, z0, z1, z2);
+
+				_mm_storeu_ps(out, c0);
+				_mm_storeu_ps(out + 4, c4);
+				_mm_storeu_ps(out + 8, c8);
+				_mm_storeu_ps(out + 12, c1);
+				_mm_storeu_ps(out + 16, c5);
+				_mm_storeu_ps(out + 20, z0);
+				_mm_storeu_ps(out + 24, c2);
+				_mm_storeu_ps(out + 28, c6);
+				_mm_storeu_ps(out + 32, z1);
+				_mm_storeu_ps(out + 36, c3);
+				_mm_storeu_ps(out + 40, c7);
+				_mm_storeu_ps(out + 44, z2);
+			}
+
+			if (i < count) lower()->quatToAffine(q.from(i), out, count - i);
+		}
+
+		inline __m128 absSSE(__m128 v) {
+			return _mm_andnot_ps(_mm_set1_ps(-0.0f), v);
+		}
+
+		// one byte per lane of a compare mask, returns how many were set
+		inline size_t storeMaskSSE(__m128 mask, uint8_t* out) {
+			int bits = _mm_movemask_ps(mask);
+			for (int l = 0; l < 4; l++) out[l] = (bits >> l) & 1;
+			return out[0] + out[1] + out[2] + out[3];
+		}
+
+		size_t frustumAABBSSE(const float* planes, Vec3SoA center, Vec3SoA extent, uint8_t* out, size_t count) {
+			const __m128 zero = _mm_setzero_ps();
+			size_t visible = 0;
+
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4) {
+				__m128 cx = _mm_loadu_ps(center.x + i), cy = _mm_loadu_ps(center.y + i), cz = _mm_loadu_ps(center.z + i);
+				__m128 ex = _mm_loadu_ps(extent.x + i), ey = _mm_loadu_ps(extent.y + i), ez = _mm_loadu_ps(extent.z + i);
+
+				__m128 outside = zero;
+				for (int p = 0; p < 6; p++) {
+					const float* n = planes + 4 * p;
+					__m128 d = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(n[0]), cx), _mm_mul_ps(_mm_set1_ps(n[1]), cy)),
+						_mm_mul_ps(_mm_set1_ps(n[2]), cz)), _mm_set1_ps(n[3]));
+					__m128 r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(std::fabs(n[0])), ex), _mm_mul_ps(_mm_set1_ps(std::fabs(n[1])), ey)),
+						_mm_mul_ps(_mm_set1_ps(std::fabs(n[2])), ez));
+					outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(d, r), zero));
+				}
+				visible += storeMaskSSE(_mm_cmpeq_ps(outside, zero), out + i);
+			}
+
+			if (i < count) visible += lower()->frustumAABB(planes, center.from(i), extent.from(i), out + i, count - i);
+			return visible;
+		}
+
+		size_t frustumSphereSSE(const float* planes, Vec3SoA center, const float* radius, uint8_t* out, size_t count) {
+			const __m128 zero = _mm_setzero_ps();
+			size_t visible = 0;
+
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4) {
+				__m128 cx = _mm_loadu_ps(center.x + i), cy = _mm_loadu_ps(center.y + i), cz = _mm_loadu_ps(center.z + i);
+				__m128 r = _mm_loadu_ps(radius + i);
+
+				__m128 outside = zero;
+				for (int p = 0; p < 6; p++) {
+					const float* n = planes + 4 * p;
+					__m128 d = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(n[0]), cx), _mm_mul_ps(_mm_set1_ps(n[1]), cy)),
+						_mm_mul_ps(_mm_set1_ps(n[2]), cz)), _mm_set1_ps(n[3]));
+					outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(d, r), zero));
+				}
+				visible += storeMaskSSE(_mm_cmpeq_ps(outside, zero), out + i);
+			}
+
+			if (i < count) visible += lower()->frustumSphere(planes, center.from(i), radius + i, out + i, count - i);
+			return visible;
+		}
+
+		void rayAABBSSE(const float* ray, Vec3SoA center, Vec3SoA extent, float* out, size_t count) {
+			const __m128 inf = _mm_set1_ps(std::numeric_limits<float>::infinity());
+			const __m128 o[3] = { _mm_set1_ps(ray[0]), _mm_set1_ps(ray[1]), _mm_set1_ps(ray[2]) };
+			const __m128 inv[3] = { _mm_set1_ps(ray[3]), _mm_set1_ps(ray[4]), _mm_set1_ps(ray[5]) };
+			const float* cs[3] = { center.x, center.y, center.z };
+			const float* es[3] = { extent.x, extent.y, extent.z };
+
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4) {
+				__m128 tNear = _mm_setzero_ps();
+				__m128 tFar = _mm_set1_ps(ray[6]);
+				for (int k = 0; k < 3; k++) {
+					__m128 c = _mm_loadu_ps(cs[k] + i), e = _mm_loadu_ps(es[k] + i);
+					__m128 t1 = _mm_mul_ps(_mm_sub_ps(_mm_sub_ps(c, e), o[k]), inv[k]);
+					__m128 t2 = _mm_mul_ps(_mm_sub_ps(_mm_add_ps(c, e), o[k]), inv[k]);
+					tNear = _mm_max_ps(tNear, _mm_min_ps(t1, t2));
+					tFar = _mm_min_ps(tFar, _mm_max_ps(t1, t2));
+				}
+				_mm_storeu_ps(out + i, selectSSE(_mm_cmple_ps(tNear, tFar), tNear, inf));
+			}
+
+			if (i < count) lower()->rayAABB(ray, center.from(i), extent.from(i), out + i, count - i);
+		}
+
+		void rayTriangleSSE(const float* ray, Vec3SoA v0, Vec3SoA v1, Vec3SoA v2, float* out, size_t count) {
+			const __m128 zero = _mm_setzero_ps();
+			const __m128 one = _mm_set1_ps(1.0f);
+			const __m128 inf = _mm_set1_ps(std::numeric_limits<float>::infinity());
+			const __m128 eps = _mm_set1_ps(kernels::RAY_TRIANGLE_EPSILON);
+			const __m128 ox = _mm_set1_ps(ray[0]), oy = _mm_set1_ps(ray[1]), oz = _mm_set1_ps(ray[2]);
+			const __m128 dx = _mm_set1_ps(ray[3]), dy = _mm_set1_ps(ray[4]), dz = _mm_set1_ps(ray[5]);
+			const __m128 tMax = _mm_set1_ps(ray[6]);
+
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4) {
+				__m128 ax = _mm_loadu_ps(v0.x + i), ay = _mm_loadu_ps(v0.y + i), az = _mm_loadu_ps(v0.z + i);
+				__m128 e1x = _mm_sub_ps(_mm_loadu_ps(v1.x + i), ax), e1y = _mm_sub_ps(_mm_loadu_ps(v1.y + i), ay), e1z = _mm_sub_ps(_mm_loadu_ps(v1.z + i), az);
+				__m128 e2x = _mm_sub_ps(_mm_loadu_ps(v2.x + i), ax), e2y = _mm_sub_ps(_mm_loadu_ps(v2.y + i), ay), e2z = _mm_sub_ps(_mm_loadu_ps(v2.z + i), az);
+
+				__m128 px = _mm_sub_ps(_mm_mul_ps(dy, e2z), _mm_mul_ps(dz, e2y));
+				__m128 py = _mm_sub_ps(_mm_mul_ps(dz, e2x), _mm_mul_ps(dx, e2z));
+				__m128 pz = _mm_sub_ps(_mm_mul_ps(dx, e2y), _mm_mul_ps(dy, e2x));
+				__m128 det = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1x, px), _mm_mul_ps(e1y, py)), _mm_mul_ps(e1z, pz));
+				__m128 invDet = _mm_div_ps(one, det);
+
+				__m128 sx = _mm_sub_ps(ox, ax), sy = _mm_sub_ps(oy, ay), sz = _mm_sub_ps(oz, az);
+				__m128 u = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(sx, px), _mm_mul_ps(sy, py)), _mm_mul_ps(sz, pz)), invDet);
+
+				__m128 qx = _mm_sub_ps(_mm_mul_ps(sy, e1z), _mm_mul_ps(sz, e1y));
+				__m128 qy = _mm_sub_ps(_mm_mul_ps(sz, e1x), _mm_mul_ps(sx, e1z));
+				__m128 qz = _mm_sub_ps(_mm_mul_ps(sx, e1y), _mm_mul_ps(sy, e1x));
+				__m128 v = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, qx), _mm_mul_ps(dy, qy)), _mm_mul_ps(dz, qz)), invDet);
+				__m128 t = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy)), _mm_mul_ps(e2z, qz)), invDet);
+
+				__m128 hit = _mm_cmpgt_ps(absSSE(det), eps);
+				hit = _mm_and_ps(hit, _mm_and_ps(_mm_cmpge_ps(u, zero), _mm_cmpge_ps(v, zero)));
+				hit = _mm_and_ps(hit, _mm_cmple_ps(_mm_add_ps(u, v), one));
+				hit = _mm_and_ps(hit, _mm_and_ps(_mm_cmpge_ps(t, zero), _mm_cmple_ps(t, tMax)));
+				_mm_storeu_ps(out + i, selectSSE(hit, t, inf));
+			}
+
+			if (i < count) lower()->rayTriangle(ray, v0.from(i), v1.from(i), v2.from(i), out + i, count - i);
+		}
+
+		// the 4 transforms are transposed so every register holds one Affine cell of 4 elements
+		void aabbTransformSSE(const float* m, size_t mStride, Vec3SoA center, Vec3SoA extent, Vec3SoA outCenter, Vec3SoA outExtent, size_t count) {
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4) {
+				const float* m0 = m + i * mStride;
+				const float* m1 = m0 + mStride;
+				const float* m2 = m1 + mStride;
+				const float* m3 = m2 + mStride;
+
+				__m128 a[12];
+				for (int j = 0; j < 12; j += 4) {
+					a[j] = _mm_loadu_ps(m0 + j);
+					a[j + 1] = _mm_loadu_ps(m1 + j);
+					a[j + 2] = _mm_loadu_ps(m2 + j);
+					a[j + 3] = _mm_loadu_ps(m3 + j);
+					_MM_TRANSPOSE4_PS(a[j], a[j + 1], a[j + 2], a[j + 3]);
+				}
+
+				__m128 cx = _mm_loadu_ps(center.x + i), cy = _mm_loadu_ps(center.y + i), cz = _mm_loadu_ps(center.z + i);
+				__m128 ex = _mm_loadu_ps(extent.x + i), ey = _mm_loadu_ps(extent.y + i), ez = _mm_loadu_ps(extent.z + i);
+
+				__m128 rcx = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(a[0], cx), _mm_mul_ps(a[3], cy)), _mm_mul_ps(a[6], cz)), a[9]);
+				__m128 rcy = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(a[1], cx), _mm_mul_ps(a[4], cy)), _mm_mul_ps(a[7], cz)), a[10]);
+				__m128 rcz = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(a[2], cx), _mm_mul_ps(a[5], cy)), _mm_mul_ps(a[8], cz)), a[11]);
+
+				__m128 rex = _mm_add_ps(_mm_add_ps(_mm_mul_ps(absSSE(a[0]), ex), _mm_mul_ps(absSSE(a[3]), ey)), _mm_mul_ps(absSSE(a[6]), ez));
+				__m128 rey = _mm_add_ps(_mm_add_ps(_mm_mul_ps(absSSE(a[1]), ex), _mm_mul_ps(absSSE(a[4]), ey)), _mm_mul_ps(absSSE(a[7]), ez));
+				__m128 rez = _mm_add_ps(_mm_add_ps(_mm_mul_ps(absSSE(a[2]), ex), _mm_mul_ps(absSSE(a[5]), ey)), _mm_mul_ps(absSSE(a[8]), ez));
+
+				_mm_storeu_ps(outCenter.x + i, rcx);
+				_mm_storeu_ps(outCenter.y + i, rcy);
+				_mm_storeu_ps(outCenter.z + i, rcz);
+				_mm_storeu_ps(outExtent.x + i, rex);
+				_mm_storeu_ps(outExtent.y + i, rey);
+				_mm_storeu_ps(outExtent.z + i, rez);
+			}
+
+			if (i < count) {
+				lower()->aabbTransform(m + i * mStride, mStride, center.from(i), extent.from(i),
+					outCenter.from(i), outExtent.from(i), count - i);
+			}
+		}
+
+		// 4 packed Vector3s (12 floats) into x, y and z lanes
+		inline void load3x4SSE(const float* p, __m128& x, __m128& y, __m128& z) {
+			__m128 v0 = _mm_loadu_ps(p), v1 = _mm_loadu_ps(p + 4), v2 = _mm_loadu_ps(p + 8);
+			x = _mm_shuffle_ps(_mm_shuffle_ps(v0, v0, _MM_SHUFFLE(3, 3, 0, 0)), _mm_shuffle_ps(v1, v2, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0));
+			y = _mm_shuffle_ps(_mm_shuffle_ps(v0, v1, _MM_SHUFFLE(0, 0, 1, 1)), _mm_shuffle_ps(v1, v2, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+			z = _mm_shuffle_ps(_mm_shuffle_ps(v0, v1, _MM_SHUFFLE(1, 1, 2, 2)), _mm_shuffle_ps(v2, v2, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+		}
+
+		// 12 lanes of cells (one Affine per lane) back to 4 packed Affines
+		inline void storeAffine4SSE(__m128* c, float* out) {
+			_MM_TRANSPOSE4_PS(c[0], c[1], c[2], c[3]);
+			_MM_TRANSPOSE4_PS(c[4], c[5], c[6], c[7]);
+			_MM_TRANSPOSE4_PS(c[8], c[9], c[10], c[11]);
+			for (int e = 0; e < 4; e++) {
+				_mm_storeu_ps(out + 12 * e, c[e]);
+				_mm_storeu_ps(out + 12 * e + 4, c[4 + e]);
+				_mm_storeu_ps(out + 12 * e + 8, c[8 + e]);
+			}
+		}
+
+		void affineFromTRSSSE(const float* t, const float* r, const float* s, float* out, size_t count) {
+			const __m128 one = _mm_set1_ps(1.0f);
+			const __m128 two = _mm_set1_ps(2.0f);
+
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4, t += 12, r += 16, s += 12, out += 48) {
+				__m128 qt = _mm_loadu_ps(r), qx = _mm_loadu_ps(r + 4), qy = _mm_loadu_ps(r + 8), qz = _mm_loadu_ps(r + 12);
+				_MM_TRANSPOSE4_PS(qt, qx, qy, qz);
+
+				__m128 len = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(qt, qt), _mm_mul_ps(qx, qx)), _mm_mul_ps(qy, qy)), _mm_mul_ps(qz, qz));
+				len = _mm_sqrt_ps(len);
+				qt = _mm_div_ps(qt, len);
+				qx = _mm_div_ps(qx, len);
+				qy = _mm_div_ps(qy, len);
+				qz = _mm_div_ps(qz, len);
+
+				__m128 xx = _mm_mul_ps(qx, qx), xy = _mm_mul_ps(qx, qy), xz = _mm_mul_ps(qx, qz), xt = _mm_mul_ps(qx, qt);
+				__m128 yy = _mm_mul_ps(qy, qy), yz = _mm_mul_ps(qy, qz), yt = _mm_mul_ps(qy, qt);
+				__m128 zz = _mm_mul_ps(qz, qz), zt = _mm_mul_ps(qz, qt);
+
+				__m128 sx, sy, sz;
+				load3x4SSE(s, sx, sy, sz);
+
+				__m128 c[12];
+				c[0] = _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(yy, zz))), sx);
+				c[1] = _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xy, zt)), sx);
+				c[2] = _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xz, yt)), sx);
+				c[3] = _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xy, zt)), sy);
+				c[4] = _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, zz))), sy);
+				c[5] = _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(yz, xt)), sy);
+				c[6] = _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xz, yt)), sz);
+				c[7] = _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(yz, xt)), sz);
+				c[8] = _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, yy))), sz);
+				load3x4SSE(t, c[9], c[10], c[11]);
+
+				storeAffine4SSE(c, out);
+			}
+
+			if (i < count) lower()->affineFromTRS(t, r, s, out, count - i);
+		}
+
+		// one element at a time, the child's cells broadcast against the parent's columns
+		void affineMulIndexedSSE(const float* parents, const uint32_t* index, const float* local, float* out, size_t count) {
+			for (size_t i = 0; i < count; i++, local += 12, out += 12) {
+				const float* a = parents + 12 * size_t(index[i]);
+				__m128 a0 = _mm_loadu_ps(a), a1 = _mm_loadu_ps(a + 3), a2 = _mm_loadu_ps(a + 6);
+				__m128 a3 = _mm_loadu_ps(a + 8);
+				a3 = _mm_shuffle_ps(a3, a3, _MM_SHUFFLE(3, 3, 2, 1));
+
+				__m128 r0 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a0, _mm_load1_ps(local)), _mm_mul_ps(a1, _mm_load1_ps(local + 1))),
+					_mm_mul_ps(a2, _mm_load1_ps(local + 2)));
+				__m128 r1 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a0, _mm_load1_ps(local + 3)), _mm_mul_ps(a1, _mm_load1_ps(local + 4))),
+					_mm_mul_ps(a2, _mm_load1_ps(local + 5)));
+				__m128 r2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a0, _mm_load1_ps(local + 6)), _mm_mul_ps(a1, _mm_load1_ps(local + 7))),
+					_mm_mul_ps(a2, _mm_load1_ps(local + 8)));
+				__m128 r3 = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(a0, _mm_load1_ps(local + 9)), _mm_mul_ps(a1, _mm_load1_ps(local + 10))),
+					_mm_mul_ps(a2, _mm_load1_ps(local + 11))), a3);
+
+				// the 4th lane of each store is overwritten by the next one, the last one stores 3 lanes
+				// so it never touches the following element (which may be the next input)
+				_mm_storeu_ps(out, r0);
+				_mm_storeu_ps(out + 3, r1);
+				_mm_storeu_ps(out + 6, r2);
+				_mm_storel_pi(reinterpret_cast<__m64*>(out + 9), r3);
+				_mm_store_ss(out + 11, _mm_movehl_ps(r3, r3));
+			}
+		}
+
+		const KernelTable SSE2_TABLE = {
+			mat4MulSSE,
+			mat4MulVec4SSE,
+			mat4TransposeSSE,
+			mat4TransformPointsSSE,
+			mat4InverseSSE,
+			vec3DotSSE,
+			vec3CrossSSE,
+			vec3LengthSSE,
+			vec3NormalizeSSE,
+			vec3TransformSSE,
+			vec3MinMaxSSE,
+			quatMulSSE,
+			quatNlerpSSE,
+			quatSlerpSSE,
+			quatToAffineSSE,
+			frustumAABBSSE,
+			frustumSphereSSE,
+			rayAABBSSE,
+			rayTriangleSSE,
+			aabbTransformSSE,
+			affineFromTRSSSE,
+			affineMulIndexedSSE
+		};
+
+	}
+
+	const KernelTable* kernels::sse2() {
+		return &SSE2_TABLE;
+	}
+
+}
+
+#else
+
+namespace avt {
+
+	const KernelTable* kernels::sse2() {
+		return nullptr;
+	}
+
+}
+
+#endif
@@ -1,4 +1,6 @@
 #include "../HeaderFiles/Mesh.h"
+#include "../HeaderFiles/MathKernels.h"
+#include "../HeaderFiles/Vector3Stream.h"
 
 #include <set>
 
@@ -11,10 +13,11 @@ namespace avt {
 	}
 
 	void Mesh::applyTransform(Mat4 mat) {
-		for (auto& v : _meshData) {
-			v.position = (mat * v.position.to4D()).to3D();
-		}
+		if (_meshData.empty()) return;
+
+		MathKernels::get().mat4TransformPoints(mat.data(), &_meshData[0].position.x, _meshData.size(), sizeof(Vertex));
 		_dirty = true;
+		_boundsDirty = true;
 	}
 
 	void Mesh::setup() {
@@ -30,6 +33,7 @@ namespace avt {
 
 		_va = std::make_shared<VertexArray>();
 		_va->addVertexBuffer(_vb);
+		_uploads++;
 
 		_va->unbind();
 		_vb->unbind();
@@ -43,10 +47,13 @@ namespace avt {
 			return;
 		}
 
+		GLsizeiptr size = (GLsizeiptr)(_meshData.size() * sizeof(Vertex));
+		if (size > _vb->capacity()) _vb->resize(size, false); // same buffer name, the vertex array still points at it
 		_vb->upload(_meshData);
 		_vb->unbind();
 
 		_vertexNum = static_cast<int>(_meshData.size());
+		_uploads++;
 		_dirty = false;
 	}
 
@@ -63,23 +70,32 @@ namespace avt {
 			_meshData[size - 3].normal = normal;
 		}
 		_dirty = true;
+		_boundsDirty = true;
 	}
 
 	void Mesh::computeFaceNormals() {
-		for (size_t i = 0; i < _meshData.size(); i += 3) {
-			Vertex& v1 = _meshData[i];
-			Vertex& v2 = _meshData[i + 1];
-			Vertex& v3 = _meshData[i + 2];
-
-			Vector3 normal = (v1.position-v2.position).cross(v2.position - v3.position).normalized();
-
-			v1.normal = normal;
-			v2.normal = normal;
-			v3.normal = normal;
-		}
+		size_t faces = _meshData.size() / 3;
+		if (faces == 0) return;
+
+		// one SoA lane per triangle: normal = (v1 - v2) x (v2 - v3), normalized
+		const size_t faceStride = 3 * sizeof(Vertex);
+		Vector3Stream v1, v2, v3;
+		v1.gather(&_meshData[0].position.x, faces, faceStride);
+		v2.gather(&_meshData[1].position.x, faces, faceStride);
+		v3.gather(&_meshData[2].position.x, faces, faceStride);
+
+		v1 -= v2;
+		v2 -= v3;
+		v1.cross(v2, v1);
+		v1.normalize();
+
+		v1.scatter(&_meshData[0].normal.x, faceStride);
+		v1.scatter(&_meshData[1].normal.x, faceStride);
+		v1.scatter(&_meshData[2].normal.x, faceStride);
 		_dirty = true;
 	}
 
+	// normals only feed lighting, so these loops use the fast rsqrt/acos (see FastMath.h)
 	void Mesh::computeVertexNormals(bool weighted) {
 		std::vector<Vertex*> current;
 		const Vector3 zero;
@@ -100,12 +116,12 @@ namespace avt {
 				Vertex& v3 = _meshData[j - j%3 + 2];
 
 				Vector3 fn = (v1.position - v2.position).cross(v2.position - v3.position);
-				if (!weighted) fn.normalize();
+				if (!weighted) fn.normalize<precision::Fast>();
 				normal += fn;
 
 				current.push_back(&_meshData[j]);
 			}
-			normal.normalize();
+			normal.normalize<precision::Fast>();
 			for (auto v : current) {
 				v->normal = normal;
 			}
@@ -132,7 +148,7 @@ namespace avt {
 
 			Vector3 baseNormal = (v1.position - v2.position).cross(v2.position - v3.position);
 			Vector3 normal = baseNormal;
-			if (!weighted) normal.normalize();
+			if (!weighted) normal.normalize<precision::Fast>();
 			current.push_back(&_meshData[i]);
 
 			for (size_t j = i - i%3 + 3; j < _meshData.size(); j++) {
@@ -144,14 +160,14 @@ namespace avt {
 
 				Vector3 fn = (v1.position - v2.position).cross(v2.position - v3.position);
 
-				if (fn.angleTo(baseNormal) > threshold) continue;
+				if (fn.angleTo<precision::Fast>(baseNormal) > threshold) continue;
 
-				if (!weighted) fn.normalize();
+				if (!weighted) fn.normalize<precision::Fast>();
 				normal += fn;
 
 				current.push_back(&_meshData[j]);
 			}
-			normal.normalize();
+			normal.normalize<precision::Fast>();
 			for (auto v : current) {
 				v->normal = normal;
 			}
@@ -0,0 +1,78 @@
+#include "../HeaderFiles/MeshArena.h"
+
+#include "../HeaderFiles/Mesh.h"
+
+namespace avt {
+
+	void MeshArena::create(const VertexBuffer& meshVertices) {
+		const GLsizei stride = sizeof(Vertex);
+		_vertices = std::make_shared<VertexBuffer>(4096 * stride, meshVertices.layout());
+
+		std::vector<GLint> indices(1024);
+		for (size_t i = 0; i < indices.size(); i++) indices[i] = (GLint)i;
+		_objectIndices = std::make_shared<VertexBuffer>(indices, VertexBufferLayout({ { ShaderDataType::INT, "ObjectIndex" } }));
+
+		_va = std::make_shared<VertexArray>();
+		_va->addVertexBuffer(_vertices);
+		_va->addVertexBuffer(_objectIndices, true);
+		_va->unbind();
+		_vertices->unbind();
+	}
+
+	// the buffer keeps its name when it grows, so the vertex array still points at it
+	void MeshArena::reserve(GLsizei vertices) {
+		const GLsizei stride = sizeof(Vertex);
+		GLsizei capacity = _vertices->capacityCount();
+		if (vertices <= capacity) return;
+
+		_vertices->resize((GLsizeiptr)(vertices > 2 * capacity ? vertices : 2 * capacity) * stride);
+	}
+
+	MeshArena::Range MeshArena::place(const Mesh& mesh) {
+		auto& meshVertices = mesh.vb();
+		if (!meshVertices) return Range();
+
+		auto it = _entries.find(&mesh);
+		if (it != _entries.end() && it->second.uploads == mesh.uploads()) return it->second.range;
+
+		if (!_vertices) create(*meshVertices);
+		const GLsizei stride = sizeof(Vertex);
+		GLsizei count = meshVertices->size() / stride;
+
+		Entry* entry;
+		if (it != _entries.end() && count <= it->second.capacity) {
+			entry = &it->second;
+			entry->range.count = count;
+		} else {
+			reserve(_used + count);
+			entry = &_entries[&mesh];
+			entry->range.first = _used;
+			entry->range.count = count;
+			entry->capacity = count;
+			_used += count;
+		}
+		entry->uploads = mesh.uploads();
+
+		_vertices->copy(*meshVertices, 0, (GLintptr)entry->range.first * stride, (GLsizeiptr)count * stride);
+		return entry->range;
+	}
+
+	void MeshArena::reserveObjects(GLsizei count) {
+		if (!_objectIndices) return;
+		GLsizei capacity = _objectIndices->capacityCount();
+		if (count <= capacity) return;
+
+		std::vector<GLint> indices(count > 2 * capacity ? count : 2 * capacity);
+		for (size_t i = 0; i < indices.size(); i++) indices[i] = (GLint)i;
+		_objectIndices->resize(indices.size() * sizeof(GLint), false);
+		_objectIndices->upload(indices);
+		_objectIndices->unbind();
+	}
+
+	void MeshArena::clear() {
+		_entries.clear();
+		_used = 0;
+		if (_vertices) _vertices->clear();
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,42 @@
+#include "../HeaderFiles/Prefab.h"
+
+#include "../HeaderFiles/Mesh.h" // ahead of SceneNode.h, see SceneFile.cpp
+#include "../HeaderFiles/Renderable.h"
+#include "../HeaderFiles/SceneNode.h"
+
+
+namespace avt {
+
+	Prefab::Prefab(const std::vector<std::pair<Affine, std::shared_ptr<Renderable>>>& parts) {
+		_parts.reserve(parts.size());
+		for (auto& p : parts) {
+			if (!p.second) continue;
+
+			Part part = { p.first, p.second, AABB() };
+			const std::shared_ptr<Mesh>& mesh = p.second->mesh();
+			if (mesh && !mesh->bounds().empty()) {
+				part.bounds = mesh->bounds().transformed(p.first);
+				_bounds.expand(part.bounds);
+			} else {
+				_bounded = false;
+			}
+			_parts.push_back(part);
+		}
+	}
+
+	std::shared_ptr<const Prefab> Prefab::fromNode(const SceneNode* root) {
+		std::vector<std::pair<Affine, std::shared_ptr<Renderable>>> parts;
+		std::vector<std::pair<const SceneNode*, Affine>> stack{ { root, Affine::identity() } };
+		while (!stack.empty()) {
+			auto entry = stack.back();
+			stack.pop_back();
+
+			if (entry.first->getRenderable()) parts.push_back({ entry.second, entry.first->getRenderable() });
+			for (const SceneNode* child : entry.first->children()) {
+				stack.push_back({ child, entry.second * child->getTransform() });
+			}
+		}
+		return std::make_shared<const Prefab>(parts);
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,55 @@
+#include "../HeaderFiles/QuaternionStream.h"
+
+#include "../HeaderFiles/Affine.h"
+
+
+namespace avt {
+
+	namespace {
+
+		// resizes out to the common length, unless it is one of the inputs
+		size_t prepareOutput(const QuaternionStream& a, const QuaternionStream& b, QuaternionStream& out) {
+			size_t n = a.size() < b.size() ? a.size() : b.size();
+			if (&out != &a && &out != &b) out.clear();
+			out.resize(n);
+			return n;
+		}
+
+	}
+
+	void QuaternionStream::multiply(const QuaternionStream& a, const QuaternionStream& b, QuaternionStream& out) {
+		size_t n = prepareOutput(a, b, out);
+		if (n == 0) return;
+		MathKernels::get().quatMul(a.view(), b.view(), out.view(), n);
+	}
+
+	void QuaternionStream::nlerp(const QuaternionStream& a, const QuaternionStream& b, float k, QuaternionStream& out) {
+		size_t n = prepareOutput(a, b, out);
+		if (n == 0) return;
+		MathKernels::get().quatNlerp(a.view(), b.view(), &k, 0, out.view(), n);
+	}
+
+	void QuaternionStream::nlerp(const QuaternionStream& a, const QuaternionStream& b, const float* k, QuaternionStream& out) {
+		size_t n = prepareOutput(a, b, out);
+		if (n == 0) return;
+		MathKernels::get().quatNlerp(a.view(), b.view(), k, 1, out.view(), n);
+	}
+
+	void QuaternionStream::slerp(const QuaternionStream& a, const QuaternionStream& b, float k, QuaternionStream& out) {
+		size_t n = prepareOutput(a, b, out);
+		if (n == 0) return;
+		MathKernels::get().quatSlerp(a.view(), b.view(), &k, 0, out.view(), n);
+	}
+
+	void QuaternionStream::slerp(const QuaternionStream& a, const QuaternionStream& b, const float* k, QuaternionStream& out) {
+		size_t n = prepareOutput(a, b, out);
+		if (n == 0) return;
+		MathKernels::get().quatSlerp(a.view(), b.view(), k, 1, out.view(), n);
+	}
+
+	void QuaternionStream::toAffine(Affine* out) const {
+		if (empty()) return;
+		MathKernels::get().quatToAffine(view(), out->data(), size());
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,148 @@
+#include "../HeaderFiles/RenderQueue.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "../HeaderFiles/Mesh.h"
+#include "../HeaderFiles/Material.h"
+
+
+namespace avt {
+
+	namespace {
+		// widths of the key fields, see RenderQueue
+		const uint32_t ID_MAX[3] = { (1u << 12) - 1, (1u << 16) - 1, (1u << 16) - 1 }; // shader, material, mesh
+
+		enum Kind { SHADER, MATERIAL, MESH };
+
+		size_t slotOf(const void* object, size_t mask) {
+			uint64_t p = reinterpret_cast<uintptr_t>(object);
+			return static_cast<size_t>((p >> 4) * 0x9e3779b97f4a7c15ull >> 32) & mask;
+		}
+	}
+
+	// past the field's range every later object shares the last id: still drawn right, only
+	// grouped less well
+	uint32_t RenderQueue::id(const void* object, int kind) {
+		if (_idCount * 2 >= _idKeys.size()) {
+			std::vector<const void*> keys(_idKeys.empty() ? 64 : _idKeys.size() * 2, nullptr);
+			std::vector<uint16_t> values(keys.size());
+			for (size_t i = 0; i < _idKeys.size(); i++) {
+				if (!_idKeys[i]) continue;
+				size_t s = slotOf(_idKeys[i], keys.size() - 1);
+				while (keys[s]) s = (s + 1) & (keys.size() - 1);
+				keys[s] = _idKeys[i];
+				values[s] = _idValues[i];
+			}
+			_idKeys.swap(keys);
+			_idValues.swap(values);
+		}
+
+		size_t mask = _idKeys.size() - 1;
+		size_t s = slotOf(object, mask);
+		while (_idKeys[s]) {
+			if (_idKeys[s] == object) return _idValues[s];
+			s = (s + 1) & mask;
+		}
+
+		uint32_t next = _nextId[kind];
+		_nextId[kind] = next < ID_MAX[kind] ? next + 1 : next;
+		_idKeys[s] = object;
+		_idValues[s] = static_cast<uint16_t>(next);
+		_idCount++;
+		return next;
+	}
+
+	void RenderQueue::begin(const Vector3& eye) {
+		_items.clear();
+		_order.clear();
+		std::fill(_idKeys.begin(), _idKeys.end(), nullptr);
+		_idCount = 0;
+		_nextId[SHADER] = _nextId[MATERIAL] = _nextId[MESH] = 0;
+		_eye = eye;
+	}
+
+	bool RenderQueue::submit(const Renderable& rend, const Affine& world, unsigned pass) {
+		Mesh* mesh = rend.mesh().get();
+		Material* material = rend.material().get();
+		if (!mesh || !material) return false;
+
+		if (_updateMeshes && mesh->autoBufferUpdate()) mesh->updateBufferData();
+		Shader* shader = material->shader().get();
+		if (!shader || (!mesh->va() && (_updateMeshes || !mesh->autoBufferUpdate()))) return false;
+
+		push({ world, mesh, material, shader, rend.drawMode() }, material->blended() ? BLENDED : pass);
+		return true;
+	}
+
+	void RenderQueue::append(const RenderQueue& other, size_t begin) {
+		for (size_t i = begin; i < other.size(); i++) {
+			push(other[i], other.pass(i));
+		}
+	}
+
+	void RenderQueue::push(const Item& item, unsigned pass) {
+		// the bit pattern of a non-negative float grows with it, its top half is a coarse depth
+		float distance = (item.world.translation() - _eye).quadrance();
+		uint32_t bits;
+		std::memcpy(&bits, &distance, sizeof(bits));
+
+		uint64_t key;
+		if (item.material->blended()) { // depth first, inverted so the farthest comes first
+			key = uint64_t(BLENDED) << 60
+				| uint64_t(~bits >> 4) << 32
+				| uint64_t(id(item.material, MATERIAL)) << 16
+				| uint64_t(id(item.mesh, MESH));
+		} else {
+			key = uint64_t(pass < BLENDED ? pass : BLENDED - 1) << 60
+				| uint64_t(id(item.shader, SHADER)) << 48
+				| uint64_t(id(item.material, MATERIAL)) << 32
+				| uint64_t(id(item.mesh, MESH)) << 16
+				| (bits >> 16);
+		}
+
+		_order.push_back({ key, static_cast<uint32_t>(_items.size()) });
+		_items.push_back(item);
+	}
+
+	size_t RenderQueue::blendedBegin() const {
+		auto it = std::lower_bound(_order.begin(), _order.end(), uint64_t(BLENDED) << 60, [](const Entry& e, uint64_t key) { return e.key < key; });
+		return static_cast<size_t>(it - _order.begin());
+	}
+
+	// LSD radix sort on bytes, skipping the bytes every key shares (most of the id bits in a
+	// small scene)
+	void RenderQueue::sort() {
+		size_t n = _order.size();
+		if (n < 2) return;
+
+		uint32_t counts[8][256] = {};
+		for (const Entry& e : _order) {
+			for (int b = 0; b < 8; b++) {
+				counts[b][(e.key >> (8 * b)) & 0xff]++;
+			}
+		}
+
+		_scratch.resize(n);
+		Entry* src = _order.data();
+		Entry* dst = _scratch.data();
+		for (int b = 0; b < 8; b++) {
+			uint32_t* count = counts[b];
+			if (count[(src[0].key >> (8 * b)) & 0xff] == n) continue;
+
+			uint32_t sum = 0;
+			for (int i = 0; i < 256; i++) {
+				uint32_t c = count[i];
+				count[i] = sum;
+				sum += c;
+			}
+			for (size_t i = 0; i < n; i++) {
+				dst[count[(src[i].key >> (8 * b)) & 0xff]++] = src[i];
+			}
+			std::swap(src, dst);
+		}
+		if (src != _order.data()) _order.swap(_scratch);
+	}
+
+}
\ No newline at end of file
@@ -3,7 +3,9 @@
 
 #include "../HeaderFiles/avt_math.h"
 #include "../HeaderFiles/Mesh.h"
+#include "../HeaderFiles/Prefab.h"
 #include "../HeaderFiles/StencilPicker.h"
+#include "../HeaderFiles/TaskSystem.h"
 
 #include "../HeaderFiles/UniformBuffer.h"
 #include "../HeaderFiles/VertexArray.h"
@@ -33,127 +35,371 @@ namespace avt {
 		ub.unbind();
 	}*/
 
-	void Renderer::begin(Camera* camera) {
+	namespace {
+		// draw(rend, world) for the node itself, false when its subtree is out of view. A subtree whose
+		// bounds are out of view is skipped whole, one fully inside (inside becomes true) is taken without
+		// testing its nodes again. A prefab's parts are expanded here, culled one by one when the
+		// instance straddles the frustum
+		template<typename F>
+		bool visitNode(SceneNode* node, const Frustum& frustum, bool& inside, F& draw) {
+			if (!inside) {
+				const AABB& bounds = node->getSubtreeBounds();
+				if (bounds.empty() || !frustum.intersects(bounds)) return false;
+				inside = frustum.contains(bounds);
+			}
+
+			if (node->getRenderable() && !node->isBatched()) draw(node->getRenderable(), node->getWorldTransform());
+
+			if (auto& prefab = node->getPrefab()) {
+				const Affine& world = node->getWorldTransform();
+				prefab->expand(world, node->getPrefabOverrides().get(), [&](const Prefab::Part& part, const std::shared_ptr<Renderable>& rend, const Affine& partWorld) {
+					if (inside || part.bounds.empty() || frustum.intersects(part.bounds.transformed(world))) draw(rend, partWorld);
+				});
+			}
+			return true;
+		}
+
+		// draw(rend, world) for what may be in view in the subtree
+		template<typename F>
+		void visitVisible(SceneNode* node, const Frustum& frustum, bool inside, F& draw) {
+			if (!visitNode(node, frustum, inside, draw)) return;
+
+			for (auto childNode : *node) {
+				visitVisible(childNode, frustum, inside, draw);
+			}
+		}
+	}
+
+	void Renderer::draw(Scene& scene, Camera* camera) {
+		// world matrices are updated in one pass over the scene's flat hierarchy, traversal only reads them
+		scene.updateTransforms(_tasks);
+
 		if (_autoClear) clear();
 
 		auto& ub = camera->getUBO();
 		ub->bind();
 		ub->upload({ camera->viewMatrix(), camera->projMatrix() });
 
-		_activeCam = camera;
-	}
+		Frustum frustum(camera->projMatrix() * camera->viewMatrix());
+		if (_path == RenderPath::Queue) {
+			_queue.begin(camera->position());
+			collect(scene, frustum);
+			drawQueue();
+		} else if (_path == RenderPath::Recorded) {
+			record(scene, frustum, camera->position());
+			for (size_t i = 0; i < _recorded; i++) {
+				_backend.execute(_slots[i]->commands);
+			}
+			GLState::useProgram(0);
+			GLState::bindVertexArray(0);
+		} else {
+			// objects leave their program and vertex array bound, an unchanged one isn't bound again
+			drawNode(scene.getRoot(), frustum);
+			drawStatic(scene, frustum);
+			GLState::useProgram(0);
+			GLState::bindVertexArray(0);
+		}
 
-	void Renderer::end() {
-		_activeCam->getUBO()->unbind();
-		_activeCam = nullptr;
-		_subs.clear();
+		ub->unbind();
 	}
 
-	void Renderer::traverse(SceneNode* node, bool dirty) {
-		//auto newWorldMat = worldMatrix * node->getTransform();
-		dirty = dirty || node->dirty();
-		if (dirty) node->updateWorldFromParent();
+	void Renderer::drawNode(SceneNode* root, const Frustum& frustum) {
+		auto draw = [this](const std::shared_ptr<Renderable>& rend, const Affine& world) { drawRenderable(rend, world); };
+		visitVisible(root, frustum, false, draw);
+	}
 
-		if (node->getRenderable()) submit(node->getRenderable(), node->getWorldTransform());
+	// one draw per chunk in view, the vertices are already in world space
+	void Renderer::drawStatic(const Scene& scene, const Frustum& frustum) {
+		auto& chunks = scene.staticBatch().chunks();
+		if (chunks.empty()) return;
 
-		for (auto childNode : *node) {
-			traverse(childNode, dirty);
+		for (auto& chunk : chunks) {
+			if (frustum.intersects(chunk.bounds)) drawRenderable(chunk.rend, Affine::identity());
 		}
 	}
 
-	void Renderer::submit(const std::shared_ptr<Renderable>& rend, const Mat4& worldMatrix) {
+	void Renderer::drawRenderable(const std::shared_ptr<Renderable>& rend, const Affine& worldMatrix) {
 		auto& mesh = rend->mesh();
 		auto& material = rend->material();
+		auto& shader = material->shader();
 
-		if (mesh && mesh->autoBufferUpdate()) mesh->updateBufferData();
-		if (!material || !material->shader() || !mesh || !mesh->va()) return;
-
-		auto it = _subs.find(material);
-		if (it == _subs.end()) { // new shader
-			_subs.insert({ material, {{mesh, {worldMatrix}}} });
-		} else { // seen shader
-			auto it2 = it->second.find(mesh);
-			if (it2 == it->second.end()) { // new mesh
-				it->second.insert({ mesh, {worldMatrix} });
-			} else { // seen mesh
-				it2->second.push_back(worldMatrix);
-			}
+		if (mesh->autoBufferUpdate()) mesh->updateBufferData();
+		
+		auto& va = mesh->va();
+		if (!va || !material || !shader) return;
+
+		if (shader->usesObjectBuffer()) { // through the arena, an object buffer of one
+			MeshArena::Range range = _arena.place(*mesh);
+			_objectData.resize(1);
+			worldMatrix.toMat4(_objectData[0].model);
+			_objectData[0].material = 0;
+			uploadObjects();
+			if (_objects->bindingPoint() != shader->objectBinding()) _objects->setBindingPoint(shader->objectBinding());
+
+			_arena.va()->bind();
+			material->bind();
+			if (shader->usesLightViewProj()) shader->uploadLightViewProj(_lightSpace);
+			glDrawArraysInstanced(getGLdrawMode(rend->drawMode()), range.first, range.count, 1);
+			return;
+		}
+
+		va->bind();
+		material->bind(); // binds shader
+		//shader->bind();
+		Mat4 model = worldMatrix.toMat4();
+		if (shader->instanced()) { // an instance of one
+			uploadInstances(model.data(), 1);
+			va->setInstanceMatrices(*_instances, shader->instanceLocation());
+			if (shader->usesLightViewProj()) shader->uploadLightViewProj(_lightSpace);
+			glDrawArraysInstanced(getGLdrawMode(rend->drawMode()), 0, mesh->vertexCount(), 1);
+		} else {
+			shader->uploadModelMatrix(model);
+			if (shader->usesNormalMatrix()) shader->uploadNormalMatrix(worldMatrix.normalMatrix());
+			if (shader->usesLightSpaceMatrix()) shader->uploadLightSpaceMatrix(_lightSpace * model);
+			if (shader->usesLightViewProj()) shader->uploadLightViewProj(_lightSpace);
+
+			glDrawArrays(getGLdrawMode(rend->drawMode()), 0, mesh->vertexCount());
+		}
+
+	}
+
+
+	void Renderer::collect(const Scene& scene, const Frustum& frustum) {
+		auto submit = [this](const std::shared_ptr<Renderable>& rend, const Affine& world) { _queue.submit(*rend, world); };
+		visitVisible(scene.getRoot(), frustum, false, submit);
+
+		for (auto& chunk : scene.staticBatch().chunks()) {
+			if (frustum.intersects(chunk.bounds)) _queue.submit(*chunk.rend, Affine::identity());
 		}
 	}
 
-	void Renderer::draw() {
-		for (auto& materialGroup : _subs) {
-			auto& material = materialGroup.first;
-			auto& shader = material->shader();
-			material->bind(); // also binds shader
-			//std::cout << "shader: " << shader << std::endl;
-			for (auto& meshGroup : materialGroup.second) {
-				auto& mesh = meshGroup.first;
-				mesh->va()->bind();
-				//std::cout << "mesh: " << mesh << std::endl;
-				for (auto& transform : meshGroup.second) {
-					shader->uploadModelMatrix(transform);
-					glDrawArrays(GL_TRIANGLES, 0, mesh->vertexCount());
+	// The top of the tree is walked here, a level at a time, until there are subtrees enough to share
+	// out. Contiguous ranges of them are then culled in parallel, each into its own queue that is sorted
+	// and recorded into its own command buffer; the nodes above them and the static chunks go into the
+	// first queue. Each share is sorted on its own, so state changes are grouped per buffer rather than
+	// over the frame. Blended items are left out of the shares and gathered after them into one last
+	// buffer, back to front over the whole frame. Meshes are set up or updated by the replay, the only
+	// part touching GL
+	void Renderer::record(const Scene& scene, const Frustum& frustum, const Vector3& eye) {
+		unsigned threads = _tasks ? _tasks->threads() : 1;
+		size_t slots = threads > 1 ? threads * 4 : 1; // a few shares per thread, subtrees differ in size
+
+		while (_slots.size() < slots + 1) {
+			_slots.emplace_back(new RecordSlot());
+			_slots.back()->queue.setMeshUpdates(false);
+		}
+		for (size_t i = 0; i < slots; i++) {
+			_slots[i]->queue.begin(eye);
+		}
+
+		RenderQueue& top = _slots[0]->queue;
+		auto submitTop = [&top](const std::shared_ptr<Renderable>& rend, const Affine& world) { top.submit(*rend, world); };
+
+		_roots.clear();
+		_roots.push_back({ scene.getRoot(), false });
+		while (_roots.size() < slots) {
+			_nextRoots.clear();
+			bool split = false;
+			for (auto& root : _roots) {
+				if (root.first->children().empty()) {
+					_nextRoots.push_back(root);
+					continue;
+				}
+				bool inside = root.second;
+				if (!visitNode(root.first, frustum, inside, submitTop)) continue;
+				for (auto childNode : *root.first) {
+					_nextRoots.push_back({ childNode, inside });
 				}
-				//std::cout << meshGroup.second.size() << " tranforms" << std::endl;
-				mesh->va()->unbind();
+				split = true;
 			}
-			material->unbind();
+			_roots.swap(_nextRoots);
+			if (!split) break;
 		}
-	}
 
+		for (auto& chunk : scene.staticBatch().chunks()) {
+			if (frustum.intersects(chunk.bounds)) top.submit(*chunk.rend, Affine::identity());
+		}
 
+		size_t n = _roots.size();
+		if (n < slots) slots = n > 0 ? n : 1;
+		auto recordSlots = [this, &frustum, n, slots](size_t begin, size_t end) {
+			for (size_t s = begin; s < end; s++) {
+				RecordSlot& slot = *_slots[s];
+				auto submit = [&slot](const std::shared_ptr<Renderable>& rend, const Affine& world) { slot.queue.submit(*rend, world); };
+				for (size_t r = s * n / slots; r < (s + 1) * n / slots; r++) {
+					visitVisible(_roots[r].first, frustum, _roots[r].second, submit);
+				}
 
-	void Renderer::draw(const Scene& scene, Camera* camera) {
+				slot.queue.sort();
+				slot.commands.clear();
+				slot.commands.record(slot.queue, 0, slot.queue.blendedBegin());
+			}
+		};
+		if (_tasks && slots > 1) _tasks->parallelFor(slots, 1, recordSlots);
+		else recordSlots(0, slots);
+
+		RecordSlot& blended = *_slots[slots];
+		blended.queue.begin(eye);
+		for (size_t s = 0; s < slots; s++) {
+			blended.queue.append(_slots[s]->queue, _slots[s]->queue.blendedBegin());
+		}
+		blended.queue.sort();
+		blended.commands.clear();
+		blended.commands.record(blended.queue);
 
-		//begin(camera);
-		//traverse(scene.getRoot(), false);
-		//draw();
-		//end();
-		//return;
+		_recorded = slots + 1;
+	}
 
-		if (_autoClear) clear();
+	// binds only on a change of material or mesh, the order puts equal ones next to each other.
+	// With an instanced shader a run of the same mesh, material and mode is a single draw, reading
+	// its model matrices from the one upload of the frame's instanced draws. With an object buffer
+	// all of a material's objects are one multi-draw, see buildIndirect
+	void Renderer::drawQueue() {
+		_queue.sort();
+		buildIndirect();
+
+		_instanceData.clear();
+		for (size_t i = 0; i < _queue.size(); i++) {
+			const RenderQueue::Item& item = _queue[i];
+			if (!item.shader->instanced()) continue;
+			_instanceData.resize(_instanceData.size() + 16);
+			item.world.toMat4(&_instanceData[_instanceData.size() - 16]);
+		}
+		uploadInstances(_instanceData.data(), _instanceData.size() / 16);
+
+		Material* material = nullptr;
+		Mesh* mesh = nullptr;
+		GLsizei instance = 0;
+		size_t batch = 0;
+		bool arena = false; // the arena's vertex array is bound
+		if (!_batches.empty()) _commands->bind();
+		for (size_t i = 0; i < _queue.size();) {
+			const RenderQueue::Item& item = _queue[i];
+			if (batch < _batches.size() && _batches[batch].begin == i) {
+				const IndirectBatch& b = _batches[batch++];
+				if (item.material != material) {
+					material = item.material;
+					material->bind(); // binds shader
+				}
+				if (!arena) _arena.va()->bind();
+				arena = true;
+				mesh = nullptr;
 
-		auto& ub = camera->getUBO();
-		ub->bind();
-		ub->upload({ camera->viewMatrix(), camera->projMatrix() });
+				Shader* shader = item.shader;
+				if (_objects->bindingPoint() != shader->objectBinding()) _objects->setBindingPoint(shader->objectBinding());
+				if (shader->usesLightViewProj()) shader->uploadLightViewProj(_lightSpace);
+				glMultiDrawArraysIndirect(getGLdrawMode(item.mode), (const void*)(b.command * sizeof(DrawCommand)), (GLsizei)b.commands, 0);
 
-		drawNode(scene.getRoot(), false);
+				i = b.end;
+				continue;
+			}
 
-		ub->unbind();
-	}
+			if (item.material != material) {
+				material = item.material;
+				material->bind(); // binds shader
+			}
+			if (item.mesh != mesh) {
+				mesh = item.mesh;
+				mesh->va()->bind();
+				arena = false;
+			}
+
+			Shader* shader = item.shader;
+			if (shader->instanced()) {
+				size_t end = i + 1;
+				while (end < _queue.size() && _queue[end].material == material && _queue[end].mesh == mesh && _queue[end].mode == item.mode) end++;
+				GLsizei count = (GLsizei)(end - i);
+
+				mesh->va()->setInstanceMatrices(*_instances, shader->instanceLocation(), instance);
+				if (shader->usesLightViewProj()) shader->uploadLightViewProj(_lightSpace);
+				glDrawArraysInstanced(getGLdrawMode(item.mode), 0, mesh->vertexCount(), count);
 
-	void Renderer::drawNode(SceneNode* node, bool dirty) {
-		//auto newWorldMat = worldMatrix * node->getTransform();
-		dirty = dirty || node->dirty();
-		if (dirty) node->updateWorldFromParent();
+				instance += count;
+				i = end;
+				continue;
+			}
 
-		if (node->getRenderable()) drawRenderable(node->getRenderable(), node->getWorldTransform());
+			Mat4 model = item.world.toMat4();
+			shader->uploadModelMatrix(model);
+			if (shader->usesNormalMatrix()) shader->uploadNormalMatrix(item.world.normalMatrix());
+			if (shader->usesLightSpaceMatrix()) shader->uploadLightSpaceMatrix(_lightSpace * model);
+			if (shader->usesLightViewProj()) shader->uploadLightViewProj(_lightSpace);
 
-		for (auto childNode : *node) {
-			drawNode(childNode, dirty);
+			glDrawArrays(getGLdrawMode(item.mode), 0, mesh->vertexCount());
+			i++;
 		}
+
+		if (material) material->unbind();
+		if (mesh) mesh->va()->unbind();
+		else if (arena) _arena.va()->unbind();
+		if (!_batches.empty()) _commands->unbind();
 	}
 
-	void Renderer::drawRenderable(const std::shared_ptr<Renderable>& rend, const Mat4& worldMatrix) {
-		auto& mesh = rend->mesh();
-		auto& material = rend->material();
-		auto& shader = material->shader();
+	// Per material and draw mode of the object buffer shaders, one command per run of a mesh,
+	// as many instances as the run has objects. The meshes are read from the arena, the objects'
+	// matrices and material ids from one storage buffer, the commands from one indirect buffer:
+	// the draw calls don't grow with the object count, only these arrays do
+	void Renderer::buildIndirect() {
+		_objectData.clear();
+		_commandData.clear();
+		_batches.clear();
+
+		size_t n = _queue.size();
+		for (size_t i = 0; i < n;) {
+			const RenderQueue::Item& item = _queue[i];
+			if (!item.shader->usesObjectBuffer()) {
+				i++;
+				continue;
+			}
 
-		if (mesh->autoBufferUpdate()) mesh->updateBufferData();
-		
-		auto& va = mesh->va();
-		if (!va || !material || !shader) return;
+			IndirectBatch batch = { i, i, _commandData.size(), 0 };
+			size_t end = i;
+			while (end < n && _queue[end].material == item.material && _queue[end].mode == item.mode) {
+				Mesh* mesh = _queue[end].mesh;
+				MeshArena::Range range = _arena.place(*mesh);
+				GLuint base = (GLuint)_objectData.size();
+
+				size_t run = end;
+				for (; end < n && _queue[end].mesh == mesh && _queue[end].material == item.material && _queue[end].mode == item.mode; end++) {
+					_objectData.emplace_back();
+					MeshArena::Object& object = _objectData.back();
+					_queue[end].world.toMat4(object.model);
+					object.material = _queue.materialId(end);
+				}
+				_commandData.push_back({ (GLuint)range.count, (GLuint)(end - run), (GLuint)range.first, base });
+			}
+			batch.end = end;
+			batch.commands = _commandData.size() - batch.command;
+			_batches.push_back(batch);
+			i = end;
+		}
+		if (_batches.empty()) return;
 
-		va->bind();
-		material->bind(); // binds shader
-		//shader->bind();
-		shader->uploadModelMatrix(worldMatrix);
+		uploadObjects();
+		if (!_commands) _commands.reset(new StorageBuffer(GL_DRAW_INDIRECT_BUFFER));
+		_commands->upload(_commandData);
+		_commands->unbind();
+	}
 
-		glDrawArrays(getGLdrawMode(rend->drawMode()), 0, mesh->vertexCount());
+	void Renderer::uploadObjects() {
+		if (!_objects) _objects.reset(new StorageBuffer(GL_SHADER_STORAGE_BUFFER, 1));
+		_objects->upload(_objectData);
+		_objects->unbind();
+		_arena.reserveObjects((GLsizei)_objectData.size());
+	}
 
-		material->unbind();
-		va->unbind();
+	// the storage is orphaned before each upload so it doesn't wait on draws still reading the last one
+	void Renderer::uploadInstances(const float* matrices, size_t count) {
+		if (count == 0) return;
+		GLsizeiptr size = (GLsizeiptr)(count * 16 * sizeof(float));
+
+		if (!_instances) {
+			_instances.reset(new VertexBuffer(size, { { ShaderDataType::MAT4, "InstanceModel" } }));
+		} else {
+			GLsizeiptr capacity = _instances->capacity();
+			_instances->resize(capacity < size ? size + size / 2 : capacity, false);
+		}
+		_instances->upload(matrices, size);
 	}
 
 
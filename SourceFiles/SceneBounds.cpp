@@ -0,0 +1,110 @@
+#include "../HeaderFiles/SceneBounds.h"
+#include "../HeaderFiles/Mesh.h" // ahead of SceneNode.h, see SceneFile.cpp
+#include "../HeaderFiles/Prefab.h"
+#include "../HeaderFiles/Renderable.h"
+#include "../HeaderFiles/SceneNode.h"
+
+
+namespace avt {
+
+	// false when the node has nothing to bound, or something without bounds
+	bool SceneBounds::worldBounds(SceneNode* node, AABB& box) {
+		const auto& rend = node->getRenderable();
+		const auto& prefab = node->getPrefab();
+		AABB local;
+		if (rend) {
+			if (!rend->mesh() || rend->mesh()->bounds().empty()) return false;
+			local = rend->mesh()->bounds();
+		}
+		if (prefab) {
+			if (!prefab->bounded()) return false;
+			local.expand(prefab->bounds());
+		}
+		if (local.empty()) return false;
+
+		box = local.transformed(node->getWorldTransform());
+		return true;
+	}
+
+	void SceneBounds::add(SceneNode* node) {
+		TransformHierarchy::Id id = node->getTransformId();
+		if (!node->getRenderable() && !node->getPrefab()) {
+			remove(id);
+			return;
+		}
+
+		if (id >= _entries.size()) _entries.resize(id + 1);
+		Entry& entry = _entries[id];
+		entry.node = node;
+		if (!entry.queued) {
+			entry.queued = true;
+			_queued.push_back(id);
+		}
+	}
+
+	void SceneBounds::remove(TransformHierarchy::Id id) {
+		if (id >= _entries.size()) return;
+
+		Entry& entry = _entries[id];
+		if (entry.node) entry.node->markSubtreeDirty();
+		if (entry.proxy != DynamicBVH::NONE) _bvh.remove(entry.proxy);
+		entry = Entry();
+		_components.bounds().remove(id);
+	}
+
+	void SceneBounds::clear() {
+		_bvh.clear();
+		_entries.clear();
+		_queued.clear();
+	}
+
+	void SceneBounds::update(const TransformHierarchy& transforms) {
+		AABB box;
+
+		// an id removed and added again since is queued twice, the flag lets it through once
+		for (TransformHierarchy::Id id : _queued) {
+			Entry& entry = _entries[id];
+			if (!entry.queued) continue;
+			entry.queued = false;
+
+			bool placed = worldBounds(entry.node, box);
+			if (placed && entry.proxy == DynamicBVH::NONE) entry.proxy = _bvh.insert(box, id);
+			else if (placed) _bvh.update(entry.proxy, box);
+			else if (entry.proxy != DynamicBVH::NONE) {
+				_bvh.remove(entry.proxy);
+				entry.proxy = DynamicBVH::NONE;
+			}
+
+			if (placed) _components.bounds().set(id, { box });
+			else _components.bounds().remove(id);
+			entry.node->markSubtreeDirty();
+		}
+		_queued.clear();
+
+		for (auto& range : transforms.updatedSlots()) {
+			for (uint32_t s = range.first; s < range.second; s++) {
+				TransformHierarchy::Id id = transforms.idAt(s);
+				if (id >= _entries.size() || _entries[id].proxy == DynamicBVH::NONE) continue;
+
+				if (worldBounds(_entries[id].node, box)) {
+					_bvh.update(_entries[id].proxy, box);
+					_components.bounds().get(id).box = box;
+					_entries[id].node->markSubtreeDirty();
+				}
+			}
+		}
+
+		_bvh.refit();
+	}
+
+	SceneNode* SceneBounds::raycast(const Ray& ray, float& t) const {
+		SceneNode* closest = nullptr;
+		_bvh.raycast(ray, [&](uint32_t id, float hit) {
+			closest = _entries[id].node;
+			t = hit;
+			return hit;
+		});
+		return closest;
+	}
+
+}
\ No newline at end of file
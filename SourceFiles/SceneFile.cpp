@@ -0,0 +1,295 @@
+#include "../HeaderFiles/SceneFile.h"
+
+#include <cstring>
+#include <fstream>
+#include <unordered_map>
+#include <vector>
+
+#include "../HeaderFiles/MappedFile.h"
+#include "../HeaderFiles/Mesh.h"
+#include "../HeaderFiles/Material.h"
+#include "../HeaderFiles/Prefab.h"
+#include "../HeaderFiles/RenderMesh.h"
+#include "../HeaderFiles/Scene.h"
+#include "../HeaderFiles/SceneNode.h"
+#include "../HeaderFiles/StencilPicker.h"
+
+
+namespace avt {
+
+	//////// SCENE ASSETS
+
+	uint64_t SceneAssets::hash(const void* data, size_t size) {
+		const uint8_t* bytes = static_cast<const uint8_t*>(data);
+		uint64_t h = 0xcbf29ce484222325ull;
+		for (size_t i = 0; i < size; i++) {
+			h = (h ^ bytes[i]) * 0x100000001b3ull;
+		}
+		return h;
+	}
+
+	namespace {
+		// replaces an earlier asset under the same hash
+		template<typename T>
+		void put(std::vector<std::pair<uint64_t, std::shared_ptr<T>>>& assets, uint64_t hash, const std::shared_ptr<T>& asset) {
+			for (auto& a : assets) {
+				if (a.first == hash) {
+					a.second = asset;
+					return;
+				}
+			}
+			assets.push_back({ hash, asset });
+		}
+
+		template<typename T>
+		std::shared_ptr<T> find(const std::vector<std::pair<uint64_t, std::shared_ptr<T>>>& assets, uint64_t hash) {
+			for (auto& a : assets) {
+				if (a.first == hash) return a.second;
+			}
+			return nullptr;
+		}
+
+		template<typename T, typename U>
+		bool findHash(const std::vector<std::pair<uint64_t, std::shared_ptr<T>>>& assets, const U* asset, uint64_t& hash) {
+			for (auto& a : assets) {
+				if (a.second.get() == asset) {
+					hash = a.first;
+					return true;
+				}
+			}
+			return false;
+		}
+	}
+
+	uint64_t SceneAssets::add(const std::shared_ptr<Mesh>& mesh) {
+		const std::vector<Vertex>& data = mesh->data();
+		uint64_t h = hash(data.data(), data.size() * sizeof(Vertex));
+		put(_meshes, h, mesh);
+		return h;
+	}
+
+	uint64_t SceneAssets::add(const std::shared_ptr<Material>& material, const std::string& key) {
+		uint64_t h = hash(key.data(), key.size());
+		put(_materials, h, material);
+		return h;
+	}
+
+	uint64_t SceneAssets::add(const std::shared_ptr<const Prefab>& prefab, const std::string& key) {
+		uint64_t h = hash(key.data(), key.size());
+		put(_prefabs, h, prefab);
+		return h;
+	}
+
+	std::shared_ptr<Mesh> SceneAssets::mesh(uint64_t hash) const {
+		return find(_meshes, hash);
+	}
+
+	std::shared_ptr<Material> SceneAssets::material(uint64_t hash) const {
+		return find(_materials, hash);
+	}
+
+	std::shared_ptr<const Prefab> SceneAssets::prefab(uint64_t hash) const {
+		return find(_prefabs, hash);
+	}
+
+	bool SceneAssets::hashOf(const Mesh* mesh, uint64_t& hash) const {
+		return findHash(_meshes, mesh, hash);
+	}
+
+	bool SceneAssets::hashOf(const Material* material, uint64_t& hash) const {
+		return findHash(_materials, material, hash);
+	}
+
+	bool SceneAssets::hashOf(const Prefab* prefab, uint64_t& hash) const {
+		return findHash(_prefabs, prefab, hash);
+	}
+
+
+	//////// SAVE
+
+	SceneFileStatus SceneFile::save(const std::string& path, const Scene& scene, const SceneAssets& assets) {
+		// breadth-first, so every parent is written before its children
+		std::vector<SceneNode*> order{ scene.getRoot() };
+		std::vector<NodeEntry> nodes;
+		std::vector<RenderableEntry> renderables;
+		std::unordered_map<const avt::Renderable*, uint32_t> renderableIndex;
+		std::vector<uint64_t> prefabs;
+		std::unordered_map<const Prefab*, uint32_t> prefabIndex;
+		std::string strings;
+
+		for (size_t i = 0; i < order.size(); i++) {
+			SceneNode* node = order[i];
+			NodeEntry entry;
+
+			entry.parent = NONE;
+			entry.childCount = static_cast<uint32_t>(node->children().size());
+			for (SceneNode* child : *node) {
+				order.push_back(child);
+			}
+
+			entry.renderable = NONE;
+			const avt::Renderable* rend = node->getRenderable().get();
+			if (rend) {
+				auto it = renderableIndex.find(rend);
+				if (it == renderableIndex.end()) {
+					RenderableEntry r;
+					if (!rend->mesh() || !assets.hashOf(rend->mesh().get(), r.mesh)) return SceneFileStatus::MissingAsset;
+					if (!rend->material() || !assets.hashOf(rend->material().get(), r.material)) return SceneFileStatus::MissingAsset;
+
+					it = renderableIndex.insert({ rend, static_cast<uint32_t>(renderables.size()) }).first;
+					renderables.push_back(r);
+				}
+				entry.renderable = it->second;
+			}
+
+			entry.prefab = NONE;
+			const Prefab* prefab = node->getPrefab().get();
+			if (prefab) {
+				if (node->getPrefabOverrides()) return SceneFileStatus::MissingAsset;
+
+				auto it = prefabIndex.find(prefab);
+				if (it == prefabIndex.end()) {
+					uint64_t h;
+					if (!assets.hashOf(prefab, h)) return SceneFileStatus::MissingAsset;
+
+					it = prefabIndex.insert({ prefab, static_cast<uint32_t>(prefabs.size()) }).first;
+					prefabs.push_back(h);
+				}
+				entry.prefab = it->second;
+			}
+
+			entry.pickAlias = NONE;
+			if (const std::string* alias = StencilPicker::getAlias(node)) {
+				entry.pickAlias = static_cast<uint32_t>(strings.size());
+				strings.append(alias->c_str(), alias->size() + 1);
+			}
+			entry.flags = node->isStatic() ? STATIC : 0;
+
+			const Vector3& t = node->getTranslation();
+			const Quaternion& q = node->getRotation();
+			const Vector3& s = node->getScale();
+			entry.translation[0] = t.x; entry.translation[1] = t.y; entry.translation[2] = t.z;
+			entry.rotation[0] = q.t; entry.rotation[1] = q.x; entry.rotation[2] = q.y; entry.rotation[3] = q.z;
+			entry.scale[0] = s.x; entry.scale[1] = s.y; entry.scale[2] = s.z;
+			nodes.push_back(entry);
+		}
+
+		// parent indices, children were queued in order so each node's children are consecutive
+		for (size_t i = 0, next = 1; i < nodes.size(); i++) {
+			for (uint32_t c = 0; c < nodes[i].childCount; c++) {
+				nodes[next++].parent = static_cast<uint32_t>(i);
+			}
+		}
+
+		Header header = { { 'L', 'S', 'C', 'N' }, VERSION, static_cast<uint32_t>(nodes.size()),
+			static_cast<uint32_t>(renderables.size()), static_cast<uint32_t>(strings.size()), static_cast<uint32_t>(prefabs.size()) };
+
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		if (!file) return SceneFileStatus::CannotOpen;
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		file.write(reinterpret_cast<const char*>(renderables.data()), renderables.size() * sizeof(RenderableEntry));
+		file.write(reinterpret_cast<const char*>(prefabs.data()), prefabs.size() * sizeof(uint64_t));
+		file.write(reinterpret_cast<const char*>(nodes.data()), nodes.size() * sizeof(NodeEntry));
+		file.write(strings.data(), strings.size());
+		return file ? SceneFileStatus::Ok : SceneFileStatus::CannotOpen;
+	}
+
+
+	//////// LOAD
+
+	SceneFileStatus SceneFile::load(const std::string& path, Scene& scene, const SceneAssets& assets) {
+		MappedFile file;
+		if (!file.open(path)) return SceneFileStatus::CannotOpen;
+
+		const uint8_t* data = file.data();
+		if (file.size() < sizeof(Header)) return SceneFileStatus::BadFormat;
+
+		const Header& header = *reinterpret_cast<const Header*>(data);
+		if (std::memcmp(header.magic, "LSCN", 4) != 0 || header.version != VERSION || header.nodeCount == 0) {
+			return SceneFileStatus::BadFormat;
+		}
+
+		const uint64_t prefabsOffset = sizeof(Header) + uint64_t(header.renderableCount) * sizeof(RenderableEntry);
+		const uint64_t nodesOffset = prefabsOffset + uint64_t(header.prefabCount) * sizeof(uint64_t);
+		const uint64_t stringsOffset = nodesOffset + uint64_t(header.nodeCount) * sizeof(NodeEntry);
+		if (stringsOffset + header.stringBytes != file.size()) return SceneFileStatus::BadFormat;
+
+		const RenderableEntry* renderables = reinterpret_cast<const RenderableEntry*>(data + sizeof(Header));
+		const uint64_t* prefabHashes = reinterpret_cast<const uint64_t*>(data + prefabsOffset);
+		const NodeEntry* nodes = reinterpret_cast<const NodeEntry*>(data + nodesOffset);
+		const char* strings = reinterpret_cast<const char*>(data + stringsOffset);
+		if (header.stringBytes && strings[header.stringBytes - 1] != '\0') return SceneFileStatus::BadFormat;
+
+		// one RenderMesh per entry, shared by every node using it
+		std::vector<std::shared_ptr<avt::Renderable>> rends;
+		rends.reserve(header.renderableCount);
+		for (uint32_t i = 0; i < header.renderableCount; i++) {
+			std::shared_ptr<Mesh> mesh = assets.mesh(renderables[i].mesh);
+			std::shared_ptr<Material> material = assets.material(renderables[i].material);
+			if (!mesh || !material) return SceneFileStatus::MissingAsset;
+			rends.push_back(std::make_shared<RenderMesh>(mesh, material));
+		}
+
+		std::vector<std::shared_ptr<const Prefab>> prefabs;
+		prefabs.reserve(header.prefabCount);
+		for (uint32_t i = 0; i < header.prefabCount; i++) {
+			prefabs.push_back(assets.prefab(prefabHashes[i]));
+			if (!prefabs.back()) return SceneFileStatus::MissingAsset;
+		}
+
+		// the picker keeps raw pointers, which would alias the new nodes once the pool restarts
+		StencilPicker::removeTargetsIn(&scene.transforms());
+		scene.clear();
+		scene.transforms().reserve(header.nodeCount);
+
+		const std::shared_ptr<avt::Renderable> none;
+		std::vector<SceneNode*> created(header.nodeCount);
+		std::vector<uint32_t> picked;
+		bool anyStatic = false;
+
+		for (uint32_t i = 0; i < header.nodeCount; i++) {
+			const NodeEntry& entry = nodes[i];
+
+			bool valid = (i == 0 ? entry.parent == NONE : entry.parent < i)
+				&& (entry.renderable == NONE || entry.renderable < header.renderableCount)
+				&& (entry.prefab == NONE || entry.prefab < header.prefabCount)
+				&& (entry.pickAlias == NONE || entry.pickAlias < header.stringBytes)
+				&& entry.childCount < header.nodeCount;
+			if (!valid) {
+				StencilPicker::removeTargetsIn(&scene.transforms());
+				scene.clear();
+				return SceneFileStatus::BadFormat;
+			}
+
+			const std::shared_ptr<avt::Renderable>& rend = entry.renderable == NONE ? none : rends[entry.renderable];
+			SceneNode* node;
+			if (i == 0) {
+				node = scene.getRoot();
+				node->setRenderable(rend);
+			} else {
+				node = created[entry.parent]->createNode(rend);
+			}
+			created[i] = node;
+			if (entry.prefab != NONE) node->setPrefab(prefabs[entry.prefab]);
+
+			node->reserveChildren(entry.childCount);
+			node->setTranslation(Vector3(entry.translation[0], entry.translation[1], entry.translation[2]));
+			node->setRotation(Quaternion(entry.rotation[0], entry.rotation[1], entry.rotation[2], entry.rotation[3]));
+			node->setScale(Vector3(entry.scale[0], entry.scale[1], entry.scale[2]));
+			node->setStatic((entry.flags & STATIC) != 0);
+			anyStatic = anyStatic || (entry.flags & STATIC);
+
+			if (entry.pickAlias != NONE) picked.push_back(i);
+		}
+
+		// only once the whole file is known good, the picker keeps raw node pointers
+		for (uint32_t i : picked) {
+			StencilPicker::addTarget(created[i], std::string(strings + nodes[i].pickAlias));
+		}
+
+		// after the targets, they keep drawing on their own
+		if (anyStatic) scene.bakeStatic();
+		return SceneFileStatus::Ok;
+	}
+
+}
\ No newline at end of file
@@ -1,7 +1,156 @@
 #include "../HeaderFiles/SceneNode.h"
+#include "../HeaderFiles/SceneBounds.h"
+#include "../HeaderFiles/SceneNodePool.h"
+#include "../HeaderFiles/StaticBatch.h"
 
 
 namespace avt {
 
+	SceneNode::~SceneNode() {
+		// when the whole pool is being cleared, nodes of that pool are destroyed by it and the
+		// hierarchy is reset by the Scene
+		bool bulk = _pool && _pool->clearing();
+
+		for (auto node : _nodes) {
+			if (!bulk || node->_pool != _pool) destroy(node);
+		}
+		if (bulk) return; // Scene::clear empties its batch first
+
+		if (_batch) _batch->remove(this);
+		if (_bounds) _bounds->remove(_id);
+		_components->remove(_id);
+		_transforms->remove(_id);
+	}
+
+	void SceneNode::destroy(SceneNode* node) {
+		if (node->_pool) node->_pool->destroy(node);
+		else delete node;
+	}
+
+	SceneNode* SceneNode::createNode(const std::shared_ptr<Renderable>& rend) {
+		SceneNode* node = _pool ? _pool->create(_transforms, _components, this, rend) : new SceneNode(_transforms, _components, this, rend);
+		node->_childIndex = static_cast<uint32_t>(_nodes.size());
+		_nodes.push_back(node);
+		if (_bounds && rend) _bounds->add(node);
+		return node;
+	}
+
+	void SceneNode::setRenderable(const std::shared_ptr<Renderable>& rend) {
+		_components->setRenderable(_id, rend);
+		if (_bounds) _bounds->add(this);
+	}
+
+	void SceneNode::setPrefab(const std::shared_ptr<const Prefab>& prefab, const std::shared_ptr<const PrefabOverrides>& overrides) {
+		_components->setPrefab(_id, prefab, overrides);
+		if (_bounds) _bounds->add(this);
+	}
+
+	SceneNode* SceneNode::createInstance(const std::shared_ptr<const Prefab>& prefab, const std::shared_ptr<const PrefabOverrides>& overrides) {
+		SceneNode* node = createNode();
+		node->setPrefab(prefab, overrides);
+		return node;
+	}
+
+	SceneNode* SceneNode::addNode(SceneNode* node) {
+		// a pooled node lives in its scene's pool, it can't leave for another hierarchy
+		if (node->_pool && node->_transforms != _transforms) return nullptr;
+
+		node->detach();
+
+		if (node->_transforms == _transforms) {
+			_transforms->setParent(node->_id, _id);
+		} else {
+			// a standalone node's own hierarchy and registry have to outlive the move
+			std::unique_ptr<TransformHierarchy> previous = std::move(node->_ownTransforms);
+			std::unique_ptr<EntityRegistry> previousComponents = std::move(node->_ownComponents);
+			node->moveTo(_transforms, _components, _id, _bounds);
+		}
+
+		node->_childIndex = static_cast<uint32_t>(_nodes.size());
+		_nodes.push_back(node);
+		node->_parent = this;
+		markSubtreeDirty();
+		return node;
+	}
+
+	bool SceneNode::deleteNode(int index) {
+		if (index < 0 || index >= _nodes.size()) return false;
+
+		SceneNode* node = _nodes[index];
+		node->detach();
+		destroy(node);
+		return true;
+	}
+
+	void SceneNode::deleteAll() {
+		if (_nodes.empty()) return;
+
+		for (auto node : _nodes) {
+			destroy(node);
+		}
+		_nodes.clear();
+		markSubtreeDirty();
+	}
+
+	void SceneNode::detach() {
+		if (!_parent) return;
+
+		_parent->markSubtreeDirty();
+		auto& siblings = _parent->_nodes;
+		siblings[_childIndex] = siblings.back();
+		siblings[_childIndex]->_childIndex = _childIndex;
+		siblings.pop_back();
+		_parent = nullptr;
+	}
+
+	void SceneNode::moveTo(TransformHierarchy* transforms, EntityRegistry* components, TransformHierarchy::Id parent, SceneBounds* bounds) {
+		Vector3 translation = getTranslation();
+		Quaternion rotation = getRotation();
+		Vector3 scale = getScale();
+		std::shared_ptr<Renderable> rend = getRenderable();
+		std::shared_ptr<const Prefab> prefab = getPrefab();
+		std::shared_ptr<const PrefabOverrides> overrides = getPrefabOverrides();
+		unsigned int stencil = getStencilIndex();
+		if (_bounds) _bounds->remove(_id);
+		_components->remove(_id);
+		_transforms->remove(_id);
+
+		_transforms = transforms;
+		_id = transforms->create(parent);
+		transforms->setTranslation(_id, translation);
+		transforms->setRotation(_id, rotation);
+		transforms->setScale(_id, scale);
+		_components = components;
+		components->setRenderable(_id, rend);
+		components->setPrefab(_id, prefab, overrides);
+		components->setPick(_id, stencil);
+		_bounds = bounds;
+		if (_bounds && (rend || prefab)) _bounds->add(this);
+
+		for (auto node : _nodes) {
+			node->moveTo(transforms, components, _id, bounds);
+		}
+	}
+
+	void SceneNode::refreshSubtreeBounds() {
+		// far beyond any scene, yet finite so frustum tests stay well defined
+		static const AABB unbounded(Vector3(-1e30f, -1e30f, -1e30f), Vector3(1e30f, 1e30f, 1e30f));
+
+		if (!_subtreeDirty) return;
+
+		if (const WorldBounds* own = _components->bounds().find(_id)) _subtreeBounds = own->box;
+		else if (_components->renderableIds().has(_id) || _components->prefabInstances().has(_id)) _subtreeBounds = unbounded;
+		else _subtreeBounds = AABB();
+
+		for (auto node : _nodes) {
+			node->refreshSubtreeBounds();
+			_subtreeBounds.expand(node->_subtreeBounds);
+		}
+		_subtreeDirty = false;
+	}
+
+	NodeHandle SceneNode::handle() const {
+		return _pool ? _pool->handle(this) : NodeHandle();
+	}
 
 }
\ No newline at end of file
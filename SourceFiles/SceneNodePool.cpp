@@ -0,0 +1,77 @@
+#include "../HeaderFiles/SceneNodePool.h"
+
+#include <new>
+
+
+namespace avt {
+
+	uint32_t SceneNodePool::allocate() {
+		if (!_free.empty()) {
+			uint32_t index = _free.back();
+			_free.pop_back();
+			return index;
+		}
+
+		if (_used == capacity()) {
+			_chunks.emplace_back(new Storage[CHUNK_SIZE]);
+			_generation.resize(capacity(), 0);
+			_alive.resize(capacity(), 0);
+		}
+		return static_cast<uint32_t>(_used++);
+	}
+
+	SceneNode* SceneNodePool::create(TransformHierarchy* transforms, EntityRegistry* components, SceneNode* parent, const std::shared_ptr<Renderable>& rend) {
+		uint32_t index = allocate();
+
+		SceneNode* node = new (at(index)) SceneNode(transforms, components, parent, rend);
+		node->_pool = this;
+		node->_poolIndex = index;
+		_alive[index] = 1;
+		_live++;
+		return node;
+	}
+
+	void SceneNodePool::destroy(SceneNode* node) {
+		uint32_t index = node->_poolIndex;
+		node->~SceneNode();
+
+		_alive[index] = 0;
+		_generation[index]++;
+		_free.push_back(index);
+		_live--;
+	}
+
+	void SceneNodePool::clear() {
+		// nodes that were moved under a node from outside the pool leave it the normal way first
+		for (uint32_t i = 0; i < _used; i++) {
+			if (!_alive[i]) continue;
+
+			SceneNode* node = at(i);
+			if (node->_parent && node->_parent->_pool != this) {
+				node->detach();
+				destroy(node);
+			}
+		}
+
+		// what is left hangs from nodes of this pool, links between them are dropped unwalked
+		_clearing = true;
+		for (uint32_t i = 0; i < _used; i++) {
+			if (!_alive[i]) continue;
+
+			at(i)->~SceneNode();
+			_alive[i] = 0;
+			_generation[i]++;
+		}
+		_clearing = false;
+
+		_free.clear();
+		_used = 0;
+		_live = 0;
+	}
+
+	NodeHandle SceneNodePool::handle(const SceneNode* node) const {
+		if (!node || node->_pool != this) return NodeHandle();
+		return { node->_poolIndex, _generation[node->_poolIndex] };
+	}
+
+}
\ No newline at end of file
@@ -72,19 +72,31 @@ namespace avt {
 			glUniformBlockBinding(_program, block_index, el.second);
 		}
 
+		for (auto& el : params._storageBlocks) { // SSBOS
+			auto block_index = glGetProgramResourceIndex(_program, GL_SHADER_STORAGE_BLOCK, el.first.c_str());
+			glShaderStorageBlockBinding(_program, block_index, el.second);
+		}
+
 		for (auto& el : shaderIDs) { // Shader Delete
 			glDetachShader(_program, el);
 			glDeleteShader(el);
 		}
 
-		glUseProgram(_program);
+		GLState::useProgram(_program);
 		for (auto& tex : params._textures) { // set textures
 			auto location = glGetUniformLocation(_program, tex.first.c_str());
 			glUniform1i(location, tex.second);
 		}
-		glUseProgram(0);
+		GLState::useProgram(0);
 
 		_modelUniform = params._model;
+		_normalUniform = params._normal;
+		_lightSpaceUniform = params._lightSpace;
+		_lightViewProjUniform = params._lightViewProj;
+		_objectBuffer = params._objectBlock.length() != 0;
+		_objectBinding = params._objectBinding;
+		_instanced = params._instanceModel.length() != 0 && !_objectBuffer;
+		_instanceLocation = params._instanceLocation;
 	}
 
 	void Shader::computeLayout() const {
@@ -0,0 +1,112 @@
+#include "../HeaderFiles/StaticBatch.h"
+
+#include <cmath>
+#include <map>
+#include <tuple>
+
+#include "../HeaderFiles/Mesh.h" // ahead of SceneNode.h, see SceneFile.cpp
+#include "../HeaderFiles/RenderMesh.h"
+#include "../HeaderFiles/SceneNode.h"
+
+
+namespace avt {
+
+	constexpr float StaticBatch::CHUNK_SIZE;
+
+	StaticBatch::~StaticBatch() {
+		clear();
+	}
+
+	namespace {
+		struct ChunkKey {
+			const Material* material;
+			int x, y, z;
+
+			bool operator<(const ChunkKey& key) const {
+				return std::tie(material, x, y, z) < std::tie(key.material, key.x, key.y, key.z);
+			}
+		};
+
+		struct Building {
+			std::shared_ptr<Material> material;
+			std::vector<Vertex> vertices;
+			AABB bounds;
+			size_t nodes = 0;
+		};
+
+		// the node, then its children, with static inherited from any ancestor
+		template<typename F>
+		void walk(SceneNode* node, bool inStatic, const F& visit) {
+			inStatic = inStatic || node->isStatic();
+			if (inStatic) visit(node);
+			for (auto child : *node) {
+				walk(child, inStatic, visit);
+			}
+		}
+	}
+
+	void StaticBatch::bake(SceneNode* root, float chunkSize) {
+		clear();
+
+		std::map<ChunkKey, Building> building;
+		walk(root, false, [&](SceneNode* node) {
+			auto& rend = node->getRenderable();
+			if (!rend || rend->drawMode() != DrawMode::Triangles || node->getStencilIndex() != 0) return;
+			if (node->_batch) return; // drawn by another batch
+
+			auto& mesh = rend->mesh();
+			auto& material = rend->material();
+			if (!mesh || !material || mesh->data().empty()) return;
+
+			const Affine& world = node->getWorldTransform();
+			AABB box = mesh->bounds().transformed(world);
+			Vector3 center = box.center();
+			ChunkKey key = { material.get(), static_cast<int>(std::floor(center.x / chunkSize)),
+				static_cast<int>(std::floor(center.y / chunkSize)), static_cast<int>(std::floor(center.z / chunkSize)) };
+
+			Building& chunk = building[key];
+			chunk.material = material;
+			chunk.nodes++;
+
+			Mat3 normalMatrix = world.normalMatrix();
+			size_t first = chunk.vertices.size();
+			chunk.vertices.insert(chunk.vertices.end(), mesh->data().begin(), mesh->data().end());
+			for (size_t i = first; i < chunk.vertices.size(); i++) {
+				Vertex& v = chunk.vertices[i];
+				v.position = world * v.position;
+				v.normal = (normalMatrix * v.normal).normalized();
+				chunk.bounds.expand(v.position); // the transformed box can be an ulp tighter
+			}
+
+			node->_batch = this;
+			node->_batchIndex = static_cast<uint32_t>(_batched.size());
+			_batched.push_back(node);
+		});
+
+		_chunks.reserve(building.size());
+		for (auto& entry : building) {
+			Building& chunk = entry.second;
+			auto mesh = std::make_shared<Mesh>();
+			mesh->addVertices(chunk.vertices);
+			_chunks.push_back({ std::make_shared<RenderMesh>(mesh, chunk.material), chunk.bounds, chunk.nodes });
+		}
+	}
+
+	void StaticBatch::clear() {
+		for (SceneNode* node : _batched) {
+			node->_batch = nullptr;
+		}
+		_batched.clear();
+		_chunks.clear();
+	}
+
+	// swaps the last node into its place
+	void StaticBatch::remove(SceneNode* node) {
+		SceneNode* last = _batched.back();
+		last->_batchIndex = node->_batchIndex;
+		_batched[node->_batchIndex] = last;
+		_batched.pop_back();
+		node->_batch = nullptr;
+	}
+
+}
\ No newline at end of file
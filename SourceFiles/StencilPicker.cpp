@@ -97,6 +97,29 @@ namespace avt {
 		}
 	}
 
+	void StencilPicker::removeTargetsIn(const TransformHierarchy* hierarchy) {
+		size_t kept = 0;
+		for (size_t i = 0; i < _targets.size(); i++) {
+			if (_targets[i].first->getHierarchy() == hierarchy) {
+				_targets[i].first->setStencilIndex(0);
+				continue;
+			}
+			_targets[kept++] = _targets[i];
+		}
+		if (kept == _targets.size()) return;
+
+		_targets.resize(kept);
+		for (size_t i = 0; i < _targets.size(); i++)
+			_targets[i].first->setStencilIndex((unsigned int)i + 1);
+	}
+
+	const std::string* StencilPicker::getAlias(const SceneNode* target) {
+		for (auto& t : _targets) {
+			if (t.first == target) return &t.second;
+		}
+		return nullptr;
+	}
+
 	void StencilPicker::clear() {
 		for (auto& t : _targets)
 			t.first->setStencilIndex(0);
@@ -0,0 +1,85 @@
+#include "../HeaderFiles/TaskSystem.h"
+
+
+namespace avt {
+
+	unsigned TaskSystem::defaultWorkers() {
+		unsigned hw = std::thread::hardware_concurrency();
+		return hw > 1 ? hw - 1 : 0;
+	}
+
+	TaskSystem::TaskSystem(unsigned workers) {
+		_workers.reserve(workers);
+		for (unsigned i = 0; i < workers; i++) {
+			_workers.emplace_back(&TaskSystem::work, this);
+		}
+	}
+
+	TaskSystem::~TaskSystem() {
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_stop = true;
+		}
+		_wake.notify_all();
+		for (auto& worker : _workers) {
+			worker.join();
+		}
+	}
+
+	void TaskSystem::runChunks() {
+		for (;;) {
+			size_t begin = _next.fetch_add(_chunk);
+			if (begin >= _count) return;
+			size_t end = _count - begin < _chunk ? _count : begin + _chunk;
+			_body(_context, begin, end);
+		}
+	}
+
+	void TaskSystem::work() {
+		uint64_t seen = 0;
+		std::unique_lock<std::mutex> lock(_mutex);
+
+		for (;;) {
+			_wake.wait(lock, [&] { return _stop || _loop != seen; });
+			if (_stop) return;
+			seen = _loop;
+
+			lock.unlock();
+			runChunks();
+			lock.lock();
+
+			if (--_busy == 0) _done.notify_one();
+		}
+	}
+
+	void TaskSystem::run(size_t count, size_t grain, Body body, const void* context) {
+		if (grain == 0) grain = 1;
+		if (_workers.empty() || count <= grain) {
+			if (count) body(context, 0, count);
+			return;
+		}
+
+		// a few chunks per thread so uneven chunks even out, never below grain
+		size_t chunk = count / (4 * threads());
+		if (chunk < grain) chunk = grain;
+
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_body = body;
+			_context = context;
+			_count = count;
+			_chunk = chunk;
+			_next.store(0);
+			_busy = static_cast<unsigned>(_workers.size());
+			_loop++;
+		}
+		_wake.notify_all();
+
+		runChunks();
+
+		// every worker has to see the loop, even with no chunk left, before the next one may start
+		std::unique_lock<std::mutex> lock(_mutex);
+		_done.wait(lock, [&] { return _busy == 0; });
+	}
+
+}
\ No newline at end of file
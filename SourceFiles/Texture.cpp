@@ -13,7 +13,7 @@ namespace avt {
 		}
 
 		glGenTextures(1, &_texID);
-		glBindTexture(GL_TEXTURE_2D, _texID);
+		GLState::bindTexture(GL_TEXTURE_2D, _texID);
 
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, params._wrap[0]);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, params._wrap[1]);
@@ -37,7 +37,7 @@ namespace avt {
 		_nrChannels = 4;
 
 		glGenTextures(1, &_texID);
-		glBindTexture(GL_TEXTURE_2D, _texID);
+		GLState::bindTexture(GL_TEXTURE_2D, _texID);
 
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, params._wrap[0]);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, params._wrap[1]);
@@ -56,7 +56,7 @@ namespace avt {
 
 	void Texture::clear() {
 		std::vector<unsigned char> fill((size_t)_width * _height * _nrChannels, 0);
-		glBindTexture(GL_TEXTURE_2D, _texID);
+		GLState::bindTexture(GL_TEXTURE_2D, _texID);
 		glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, _width, _height, _nrChannels == 4 ? GL_RGBA : GL_RGB, GL_UNSIGNED_BYTE, fill.data());
 	}
 
@@ -77,7 +77,7 @@ namespace avt {
 		}
 
 
-		glBindTexture(GL_TEXTURE_2D, _texID);
+		GLState::bindTexture(GL_TEXTURE_2D, _texID);
 		glTexSubImage2D(GL_TEXTURE_2D, 0, (GLint)start.x, (GLint)start.y, w, h, _nrChannels == 4 ? GL_RGBA : GL_RGB, GL_UNSIGNED_BYTE, data);
 		if (_params._useMipmap) glGenerateMipmap(GL_TEXTURE_2D);
 
@@ -96,7 +96,7 @@ namespace avt {
 			return;
 		}
 
-		glBindTexture(GL_TEXTURE_2D, _texID);
+		GLState::bindTexture(GL_TEXTURE_2D, _texID);
 		glTexImage2D(GL_TEXTURE_2D, 0, _nrChannels == 4 ? GL_RGBA8 : GL_RGB8, _width, _height, 0, _nrChannels == 4 ? GL_RGBA : GL_RGB, GL_UNSIGNED_BYTE, data);
 		if (_params._useMipmap) glGenerateMipmap(GL_TEXTURE_2D);
 
@@ -0,0 +1,454 @@
+#include "../HeaderFiles/TransformHierarchy.h"
+
+#include <algorithm>
+#include <atomic>
+
+#include "../HeaderFiles/MathKernels.h"
+#include "../HeaderFiles/TaskSystem.h"
+
+
+namespace avt {
+
+	constexpr uint32_t TransformHierarchy::NONE;
+
+	namespace {
+		// values[j] = old values[order[j]]
+		template<typename T>
+		void gather(std::vector<T>& values, const std::vector<uint32_t>& order) {
+			std::vector<T> sorted(order.size());
+			for (size_t j = 0; j < order.size(); j++) {
+				sorted[j] = values[order[j]];
+			}
+			values.swap(sorted);
+		}
+
+		// the 12 floats of affs[i] onward, Affine arrays being packed; valid for an empty array too
+		float* floats(std::vector<Affine>& affs, size_t i) {
+			return reinterpret_cast<float*>(affs.data()) + 12 * i;
+		}
+
+		// slots per task, a few microseconds of matrix work
+		const size_t GRAIN = 2048;
+
+		// body(begin, end) over [0, count), spread over tasks when there are any
+		template<typename F>
+		void forEach(TaskSystem* tasks, size_t count, const F& body) {
+			if (tasks) tasks->parallelFor(count, GRAIN, body);
+			else if (count) body(0, count);
+		}
+	}
+
+	void TransformHierarchy::reserve(size_t capacity) {
+		_translation.reserve(capacity);
+		_rotation.reserve(capacity);
+		_scale.reserve(capacity);
+		_local.reserve(capacity);
+		_world.reserve(capacity);
+		_parent.reserve(capacity);
+		_childBegin.reserve(capacity);
+		_childCount.reserve(capacity);
+		_flags.reserve(capacity);
+		_idOf.reserve(capacity);
+		_slotOf.reserve(capacity);
+		_changed.reserve(capacity);
+	}
+
+	void TransformHierarchy::clear() {
+		_translation.clear();
+		_rotation.clear();
+		_scale.clear();
+		_local.clear();
+		_world.clear();
+		_parent.clear();
+		_childBegin.clear();
+		_childCount.clear();
+		_flags.clear();
+		_idOf.clear();
+		_slotOf.clear();
+		_freeIds.clear();
+		_queuedFreeIds.clear();
+		_changed.clear();
+		_updated.clear();
+		_levelStart.assign(1, 0);
+		_sortedCount = 0;
+		_removedCount = 0;
+		_orderBroken = false;
+		_stats = Stats();
+	}
+
+	TransformHierarchy::Id TransformHierarchy::create(Id parent) {
+		Id id;
+		if (!_freeIds.empty()) {
+			id = _freeIds.back();
+			_freeIds.pop_back();
+		} else {
+			id = static_cast<Id>(_slotOf.size());
+			_slotOf.push_back(NONE);
+		}
+
+		// goes to the tail, parents always exist before their children so the tail stays parent-first
+		uint32_t s = static_cast<uint32_t>(_idOf.size());
+		_translation.push_back(Vector3(0, 0, 0));
+		_rotation.push_back(Quaternion(1.0f, 0, 0, 0));
+		_scale.push_back(Vector3(1.0f, 1.0f, 1.0f));
+		_local.push_back(Affine::identity());
+		_world.push_back(Affine::identity());
+		_parent.push_back(parent == NONE ? NONE : slot(parent));
+		_childBegin.push_back(0);
+		_childCount.push_back(0);
+		_flags.push_back(0);
+		_idOf.push_back(id);
+		_slotOf[id] = s;
+
+		touch(s, LOCAL);
+		return id;
+	}
+
+	void TransformHierarchy::remove(Id id) {
+		uint32_t s = slot(id);
+		// still in _changed: a new node taking the id now would be queued a second time
+		if (_flags[s] & QUEUED) _queuedFreeIds.push_back(id);
+		else _freeIds.push_back(id);
+
+		_idOf[s] = NONE;
+		_flags[s] = 0;
+		_slotOf[id] = NONE;
+		_removedCount++;
+	}
+
+	void TransformHierarchy::setParent(Id id, Id parent) {
+		uint32_t s = slot(id);
+		_parent[s] = parent == NONE ? NONE : slot(parent);
+		touch(s, 0);
+		_orderBroken = true;
+	}
+
+	void TransformHierarchy::sort() {
+		const size_t n = _idOf.size();
+		if (inOrder()) return;
+
+		// children of every slot, grouped by parent
+		std::vector<uint32_t> offset(n + 1, 0);
+		for (size_t i = 0; i < n; i++) {
+			if (_idOf[i] != NONE && _parent[i] != NONE) offset[_parent[i] + 1]++;
+		}
+		for (size_t i = 0; i < n; i++) {
+			offset[i + 1] += offset[i];
+		}
+		std::vector<uint32_t> children(offset[n]);
+		std::vector<uint32_t> cursor(offset.begin(), offset.end() - 1);
+		for (size_t i = 0; i < n; i++) {
+			if (_idOf[i] != NONE && _parent[i] != NONE) children[cursor[_parent[i]]++] = static_cast<uint32_t>(i);
+		}
+
+		// breadth-first from the roots, in their current order
+		std::vector<uint32_t> order;
+		order.reserve(n - _removedCount);
+		for (size_t i = 0; i < n; i++) {
+			if (_idOf[i] != NONE && _parent[i] == NONE) order.push_back(static_cast<uint32_t>(i));
+		}
+
+		std::vector<uint32_t> childBegin(n - _removedCount), childCount(n - _removedCount);
+		_levelStart.assign(1, 0);
+		size_t levelEnd = order.size();
+		for (size_t h = 0; h < order.size(); h++) {
+			if (h == levelEnd) {
+				_levelStart.push_back(static_cast<uint32_t>(h));
+				levelEnd = order.size();
+			}
+
+			uint32_t s = order[h];
+			childBegin[h] = static_cast<uint32_t>(order.size());
+			childCount[h] = offset[s + 1] - offset[s];
+			order.insert(order.end(), children.begin() + offset[s], children.begin() + offset[s + 1]);
+		}
+		if (!order.empty()) _levelStart.push_back(static_cast<uint32_t>(order.size()));
+
+		std::vector<uint32_t> newSlot(n, NONE);
+		for (size_t j = 0; j < order.size(); j++) {
+			newSlot[order[j]] = static_cast<uint32_t>(j);
+		}
+		for (uint32_t& p : _parent) {
+			if (p != NONE) p = newSlot[p];
+		}
+
+		gather(_translation, order);
+		gather(_rotation, order);
+		gather(_scale, order);
+		gather(_local, order);
+		gather(_world, order);
+		gather(_parent, order);
+		gather(_flags, order);
+		gather(_idOf, order);
+		_childBegin.swap(childBegin);
+		_childCount.swap(childCount);
+
+		for (uint32_t s = 0; s < order.size(); s++) {
+			_slotOf[_idOf[s]] = s;
+		}
+
+		_sortedCount = order.size();
+		_removedCount = 0;
+		_orderBroken = false;
+		_stats.sorted = true;
+	}
+
+	// nodes appended breadth-first (a loaded scene file, a flat list under one parent) are already
+	// in the order sort would give them: roots first, then parents never decreasing
+	bool TransformHierarchy::inOrder() {
+		const size_t n = _idOf.size();
+		if (_removedCount) return false;
+
+		size_t roots = 0;
+		while (roots < n && _parent[roots] == NONE) roots++;
+		for (size_t i = roots, last = 0; i < n; i++) {
+			uint32_t p = _parent[i];
+			if (p == NONE || p >= i || p < last) return false;
+			last = p;
+		}
+
+		std::vector<uint32_t> childCount(n, 0);
+		for (size_t i = roots; i < n; i++) {
+			childCount[_parent[i]]++;
+		}
+
+		// same ranges the breadth-first walk of sort computes
+		std::vector<uint32_t> childBegin(n);
+		_levelStart.assign(1, 0);
+		size_t queued = roots, levelEnd = roots;
+		for (size_t h = 0; h < n; h++) {
+			if (h == levelEnd) {
+				_levelStart.push_back(static_cast<uint32_t>(h));
+				levelEnd = queued;
+			}
+			childBegin[h] = static_cast<uint32_t>(queued);
+			queued += childCount[h];
+		}
+		if (n) _levelStart.push_back(static_cast<uint32_t>(n));
+
+		_childBegin.swap(childBegin);
+		_childCount.swap(childCount);
+		_sortedCount = n;
+		_orderBroken = false;
+		_stats.sorted = true;
+		return true;
+	}
+
+	void TransformHierarchy::updateNode(Id id) {
+		uint32_t s = slot(id);
+		uint32_t p = _parent[s];
+
+		Affine local = getLocal(id);
+		_world[s] = p == NONE ? local : _world[p] * local;
+	}
+
+	// the roots from their parents, then one step down from all of them at a time: the children of
+	// a contiguous range are one contiguous range, and the subtrees of two roots never overlap
+	void TransformHierarchy::updateRoots(TaskSystem* tasks) {
+		const KernelTable& kernels = MathKernels::get();
+		const float* local = floats(_local, 0);
+		float* world = floats(_world, 0);
+
+		// a root's parent is never under another root, so no root reads what another writes
+		forEach(tasks, _roots.size(), [&](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; i++) {
+				uint32_t root = _roots[i];
+				if (root >= _sortedCount) continue;
+
+				if (_parent[root] == NONE) _world[root] = _local[root];
+				else kernels.affineMulIndexed(world, &_parent[root], local + 12 * size_t(root), world + 12 * size_t(root), 1);
+			}
+		});
+
+		_ranges.clear();
+		for (uint32_t root : _roots) {
+			if (root >= _sortedCount) continue;
+			_stats.worldUpdates++;
+			markUpdated(root, root + 1);
+			if (_childCount[root]) _ranges.push_back({ _childBegin[root], _childBegin[root] + _childCount[root] });
+		}
+
+		while (!_ranges.empty()) {
+			size_t total = 0;
+			_rangeStart.clear();
+			for (auto& range : _ranges) {
+				_rangeStart.push_back(total);
+				total += range.second - range.first;
+			}
+
+			// the ranges laid end to end, a chunk may span several of them
+			forEach(tasks, total, [&](size_t begin, size_t end) {
+				size_t r = std::upper_bound(_rangeStart.begin(), _rangeStart.end(), begin) - _rangeStart.begin() - 1;
+				while (begin < end) {
+					size_t lo = _ranges[r].first + (begin - _rangeStart[r]);
+					size_t n = _ranges[r].second - lo;
+					if (n > end - begin) n = end - begin;
+
+					kernels.affineMulIndexed(world, &_parent[lo], local + 12 * lo, world + 12 * lo, n);
+					begin += n;
+					r++;
+				}
+			});
+			_stats.worldUpdates += total;
+			for (auto& range : _ranges) {
+				markUpdated(range.first, range.second);
+			}
+
+			_nextRanges.clear();
+			for (auto& range : _ranges) {
+				uint32_t lo = _childBegin[range.first];
+				uint32_t hi = _childBegin[range.second - 1] + _childCount[range.second - 1];
+				if (lo == hi) continue;
+
+				if (!_nextRanges.empty() && _nextRanges.back().second == lo) _nextRanges.back().second = hi;
+				else _nextRanges.push_back({ lo, hi });
+			}
+			_ranges.swap(_nextRanges);
+		}
+	}
+
+	// every level in order, with the changed flag pushed down from parents, for when much has changed.
+	// Tasks only cut the runs into chunks, every slot still goes through the same kernel
+	void TransformHierarchy::updateAll(TaskSystem* tasks) {
+		const KernelTable& kernels = MathKernels::get();
+		const size_t n = _idOf.size();
+		uint8_t* flags = _flags.data();
+		const uint32_t* parent = _parent.data();
+		std::atomic<size_t> localUpdates(0), worldUpdates(0);
+
+		forEach(tasks, n, [&](size_t begin, size_t end) {
+			size_t count = 0;
+			for (size_t i = begin; i < end;) {
+				while (i < end && !(flags[i] & LOCAL)) i++;
+				size_t run = i;
+				while (i < end && (flags[i] & LOCAL)) flags[i++] &= ~LOCAL;
+				if (run == i) break;
+
+				kernels.affineFromTRS(reinterpret_cast<const float*>(&_translation[run]), reinterpret_cast<const float*>(&_rotation[run]),
+					reinterpret_cast<const float*>(&_scale[run]), floats(_local, run), i - run);
+				count += i - run;
+			}
+			localUpdates += count;
+		});
+
+		// a level only reads the one above it, so it can be split freely once that one is done
+		for (size_t d = 0; d < levels(); d++) {
+			const size_t first = _levelStart[d];
+
+			forEach(tasks, _levelStart[d + 1] - first, [&](size_t begin, size_t end) {
+				begin += first;
+				end += first;
+				for (size_t i = begin; i < end; i++) {
+					if ((flags[i] & QUEUED) || (d > 0 && (flags[parent[i]] & DIRTY))) flags[i] |= DIRTY;
+				}
+
+				size_t count = 0;
+				for (size_t i = begin; i < end;) {
+					while (i < end && !(flags[i] & DIRTY)) i++;
+					size_t run = i;
+					while (i < end && (flags[i] & DIRTY)) i++;
+					if (run == i) break;
+
+					if (d == 0) std::copy(_local.begin() + run, _local.begin() + i, _world.begin() + run);
+					else kernels.affineMulIndexed(floats(_world, 0), parent + run, floats(_local, run), floats(_world, run), i - run);
+					count += i - run;
+				}
+				worldUpdates += count;
+			});
+		}
+		_stats.localUpdates = localUpdates.load();
+		_stats.worldUpdates = worldUpdates.load();
+
+		for (size_t s = _sortedCount; s < n; s++) {
+			uint32_t p = parent[s];
+			if (_idOf[s] == NONE) continue;
+			if (!(flags[s] & QUEUED) && (p == NONE || !(flags[p] & DIRTY))) continue;
+
+			flags[s] |= DIRTY;
+			_world[s] = p == NONE ? _local[s] : _world[p] * _local[s];
+			_stats.worldUpdates++;
+		}
+
+		// serial, the dirty runs are the updated ranges
+		for (uint32_t i = 0; i < n;) {
+			while (i < n && !(flags[i] & DIRTY)) flags[i++] &= ~(QUEUED | ROOT);
+			uint32_t run = i;
+			while (i < n && (flags[i] & DIRTY)) flags[i++] &= ~(QUEUED | ROOT | DIRTY);
+			if (run < i) markUpdated(run, i);
+		}
+	}
+
+	void TransformHierarchy::update(TaskSystem* tasks) {
+		_stats = Stats();
+		_updated.clear();
+		if (_changed.empty()) return;
+
+		// the tail and removed slots are folded into the breadth-first order once they grow
+		size_t limit = 64 + _sortedCount / 32;
+		if (_orderBroken || _idOf.size() - _sortedCount > limit || _removedCount > limit) sort();
+
+		if (_changed.size() * 4 >= _sortedCount) {
+			_stats.changedRoots = _changed.size();
+			updateAll(tasks);
+			clearChanged();
+			return;
+		}
+
+		// _changed holds every id once (remove holds back the ids still in it), so its entries can be split across tasks
+		std::atomic<size_t> localUpdates(0);
+		forEach(tasks, _changed.size(), [&](size_t begin, size_t end) {
+			size_t count = 0;
+			for (size_t i = begin; i < end; i++) {
+				uint32_t s = _slotOf[_changed[i]];
+				if (s == NONE || !(_flags[s] & LOCAL)) continue;
+
+				_local[s] = Affine::fromTRS(_translation[s], _rotation[s], _scale[s]);
+				_flags[s] &= ~LOCAL;
+				count++;
+			}
+			localUpdates += count;
+		});
+		_stats.localUpdates = localUpdates.load();
+
+		// nodes under another changed node are covered by its subtree
+		_roots.clear();
+		for (Id id : _changed) {
+			uint32_t s = _slotOf[id];
+			if (s == NONE || (_flags[s] & ROOT)) continue;
+
+			bool covered = false;
+			for (uint32_t p = _parent[s]; p != NONE && !covered; p = _parent[p]) {
+				covered = (_flags[p] & QUEUED) != 0;
+			}
+			if (!covered) {
+				_flags[s] |= ROOT;
+				_roots.push_back(s);
+			}
+		}
+		_stats.changedRoots = _roots.size();
+
+		updateRoots(tasks);
+
+		// the tail isn't in the sibling ranges, refresh it whole in creation order
+		for (size_t s = _sortedCount; s < _idOf.size(); s++) {
+			if (_idOf[s] == NONE) continue;
+			uint32_t p = _parent[s];
+			_world[s] = p == NONE ? _local[s] : _world[p] * _local[s];
+			_stats.worldUpdates++;
+			markUpdated(static_cast<uint32_t>(s), static_cast<uint32_t>(s) + 1);
+		}
+
+		for (Id id : _changed) {
+			uint32_t s = _slotOf[id];
+			if (s != NONE) _flags[s] &= ~(QUEUED | ROOT);
+		}
+		clearChanged();
+	}
+
+	void TransformHierarchy::clearChanged() {
+		_changed.clear();
+		_freeIds.insert(_freeIds.end(), _queuedFreeIds.begin(), _queuedFreeIds.end());
+		_queuedFreeIds.clear();
+	}
+
+}
\ No newline at end of file
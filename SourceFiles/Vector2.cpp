@@ -132,12 +132,6 @@ namespace avt {
 		return Vector2(x / num, y / num);
 	}
 
-	Vector2& Vector2::operator=(const Vector2& vec) {
-		x = vec.x;
-		y = vec.y;
-		return *this;
-	}
-
 	std::ostream& operator<<(std::ostream& os, const Vector2& vec) {
 		os << "(" << vec.x << ", " << vec.y << ")";
 		return os;
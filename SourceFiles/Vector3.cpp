@@ -32,20 +32,6 @@ namespace avt {
 		return x * x + y * y + z * z;
 	}
 
-	Vector3 Vector3::normalized() const {
-		if (length() == 0) {
-			return *this;
-		}
-		return *this / length();
-	}
-
-	Vector3& Vector3::normalize() {
-		if (length() == 0) {
-			return *this;
-		}
-		return *this /= length();
-	}
-
 	Vector3 Vector3::pow(float exp) const {
 		return Vector3(std::pow(x, exp), std::pow(y, exp), std::pow(z, exp));
 	}
@@ -55,10 +41,6 @@ namespace avt {
 		return newV.length();
 	}
 
-	float Vector3::angleTo(const Vector3& vec) const {
-		return std::acos(dot(vec) / (length() * vec.length()));
-	}
-
 	Vector3 Vector3::rotateOnAxis(const Vector3& axis, float rad) const {
 		Mat3 K = Mat3::dual(axis);
 		Mat3 R = Mat3::identity() + sin(rad) * K + (1 - cos(rad)) * (K * K);
@@ -163,13 +145,6 @@ namespace avt {
 		return Vector3(x / num, y / num, z / num);
 	}
 
-	Vector3& Vector3::operator=(const Vector3& vec) {
-		x = vec.x;
-		y = vec.y;
-		z = vec.z;
-		return *this;
-	}
-
 	std::ostream& operator<<(std::ostream& os, const Vector3& vec) {
 		os << "(" << vec.x << ", " << vec.y << ", " << vec.z << ")";
 		return os;
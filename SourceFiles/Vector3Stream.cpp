@@ -0,0 +1,107 @@
+#include "../HeaderFiles/Vector3Stream.h"
+
+#include "../HeaderFiles/Mat4.h"
+
+
+namespace avt {
+
+	void Vector3Stream::gather(const float* xyz, size_t count, size_t stride) {
+		_data.clear();
+		_data.resize(count);
+		float* x = _data[0];
+		float* y = _data[1];
+		float* z = _data[2];
+
+		const char* base = reinterpret_cast<const char*>(xyz);
+		for (size_t i = 0; i < count; i++) {
+			const float* p = reinterpret_cast<const float*>(base + i * stride);
+			x[i] = p[0];
+			y[i] = p[1];
+			z[i] = p[2];
+		}
+	}
+
+	void Vector3Stream::scatter(float* xyz, size_t stride) const {
+		const float* x = _data[0];
+		const float* y = _data[1];
+		const float* z = _data[2];
+
+		char* base = reinterpret_cast<char*>(xyz);
+		for (size_t i = 0; i < _data.size(); i++) {
+			float* p = reinterpret_cast<float*>(base + i * stride);
+			p[0] = x[i];
+			p[1] = y[i];
+			p[2] = z[i];
+		}
+	}
+
+	// plain loops, the compiler vectorizes these on its own
+	Vector3Stream& Vector3Stream::operator+=(const Vector3Stream& stream) {
+		size_t n = size() < stream.size() ? size() : stream.size();
+		for (int c = 0; c < 3; c++) {
+			float* a = _data[c];
+			const float* b = stream._data[c];
+			for (size_t i = 0; i < n; i++) a[i] += b[i];
+		}
+		return *this;
+	}
+
+	Vector3Stream& Vector3Stream::operator-=(const Vector3Stream& stream) {
+		size_t n = size() < stream.size() ? size() : stream.size();
+		for (int c = 0; c < 3; c++) {
+			float* a = _data[c];
+			const float* b = stream._data[c];
+			for (size_t i = 0; i < n; i++) a[i] -= b[i];
+		}
+		return *this;
+	}
+
+	void Vector3Stream::dot(const Vector3Stream& stream, float* out) const {
+		size_t n = size() < stream.size() ? size() : stream.size();
+		if (n == 0) return;
+		MathKernels::get().vec3Dot(view(), stream.view(), out, n);
+	}
+
+	void Vector3Stream::cross(const Vector3Stream& stream, Vector3Stream& out) const {
+		size_t n = size() < stream.size() ? size() : stream.size();
+		if (&out != this && &out != &stream) {
+			out.clear();
+			out.resize(n);
+		}
+		if (n == 0) return;
+		MathKernels::get().vec3Cross(view(), stream.view(), out.view(), n);
+		out.resize(n);
+	}
+
+	void Vector3Stream::length(float* out) const {
+		if (empty()) return;
+		MathKernels::get().vec3Length(view(), out, size());
+	}
+
+	Vector3Stream& Vector3Stream::normalize() {
+		if (empty()) return *this;
+		MathKernels::get().vec3Normalize(view(), size());
+		return *this;
+	}
+
+	Vector3Stream& Vector3Stream::transform(const Mat4& mat) {
+		if (empty()) return *this;
+		MathKernels::get().vec3Transform(mat.data(), view(), size(), 1.0f);
+		return *this;
+	}
+
+	Vector3Stream& Vector3Stream::transformVectors(const Mat4& mat) {
+		if (empty()) return *this;
+		MathKernels::get().vec3Transform(mat.data(), view(), size(), 0.0f);
+		return *this;
+	}
+
+	void Vector3Stream::bounds(Vector3& outMin, Vector3& outMax) const {
+		if (empty()) {
+			outMin = outMax = Vector3();
+			return;
+		}
+		MathKernels::get().vec3MinMax(view(), size(), &outMin.x, &outMax.x);
+	}
+
+}
\ No newline at end of file
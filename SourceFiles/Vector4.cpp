@@ -152,14 +152,6 @@ namespace avt {
 		return Vector4(x / num, y / num, z / num, w / num);
 	}
 
-	Vector4& Vector4::operator=(const Vector4& vec) {
-		x = vec.x;
-		y = vec.y;
-		z = vec.z;
-		w = vec.w;
-		return *this;
-	}
-
 	std::ostream& operator<<(std::ostream& os, const Vector4& vec) {
 		os << "(" << vec.x << ", " << vec.y << ", " << vec.z << ", " << vec.w << ")";
 		return os;
@@ -5,12 +5,13 @@
 namespace avt {
 
 	VertexArray::~VertexArray() {
-		glBindVertexArray(_vaoID);
+		GLState::bindVertexArray(_vaoID);
 		for (unsigned int i = 0; i < _attribNum; i++) {
 			glDisableVertexAttribArray(i);
 		}
 		glDeleteVertexArrays(1, &_vaoID);
-		glBindVertexArray(0);
+		GLState::deleteVertexArray(_vaoID);
+		GLState::bindVertexArray(0);
 
 #ifndef ERROR_CALLBACK
 		ErrorManager::checkOpenGLError("ERROR: Could not destroy Vertex Array.");
@@ -18,7 +19,7 @@ namespace avt {
 	}
 
 	void VertexArray::addVertexBuffer(const std::shared_ptr<VertexBuffer>& vb, bool instanced) {
-		glBindVertexArray(_vaoID);
+		GLState::bindVertexArray(_vaoID);
 		vb->bind();
 
 		auto& layout = vb->layout();
@@ -51,7 +52,7 @@ namespace avt {
 				}
 			}
 		}
-		glBindVertexArray(0);
+		GLState::bindVertexArray(0);
 		_vbs.push_back(vb);
 
 #ifndef ERROR_CALLBACK
@@ -60,9 +61,9 @@ namespace avt {
 	}
 
 	void VertexArray::setIndexBuffer(const std::shared_ptr<IndexBuffer>& ib) {
-		glBindVertexArray(_vaoID);
+		GLState::bindVertexArray(_vaoID);
 		ib->bind();
-		glBindVertexArray(0);
+		GLState::bindVertexArray(0);
 		_ib = ib;
 
 #ifndef ERROR_CALLBACK
@@ -70,4 +71,22 @@ namespace avt {
 #endif
 	}
 
+	void VertexArray::setInstanceMatrices(const VertexBuffer& vb, GLuint location, GLsizei first) {
+		if (_instanceVB == &vb && _instanceLocation == location && _instanceFirst == first) return;
+
+		const GLsizei stride = 16 * sizeof(GLfloat);
+		bool attached = _instanceVB && _instanceLocation == location;
+		vb.bind();
+		for (GLuint i = 0; i < 4; i++) {
+			if (!attached) {
+				glEnableVertexAttribArray(location + i);
+				glVertexAttribDivisor(location + i, 1);
+			}
+			glVertexAttribPointer(location + i, 4, GL_FLOAT, GL_FALSE, stride, (const void*)(stride * (size_t)first + 4 * sizeof(GLfloat) * i));
+		}
+		_instanceVB = &vb;
+		_instanceLocation = location;
+		_instanceFirst = first;
+	}
+
 }
\ No newline at end of file
@@ -10,6 +10,7 @@ class MyApp : public avt::App {
 private:
 	std::shared_ptr<avt::Material> _mtl, _mtl2;
 	avt::Renderer _renderer;
+	avt::TaskSystem _tasks;
 	std::shared_ptr<avt::UniformBuffer> _ub;
 	avt::Scene _scene;
 	std::unique_ptr<avt::Camera> _cam;
@@ -41,9 +42,9 @@ private:
 	void createShaders() {
 		// create regular mesh shader
 		avt::ShaderParams params;
-		params.setVertexShader("./Resources/shaders/basic-vs.glsl")
+		params.setVertexShader("./Resources/shaders/instanced-vs.glsl")
 			.setFragmentShader("./Resources/shaders/basic-fs.glsl")
-			.useModelMatrix("ModelMatrix")
+			.useInstancedModelMatrix("InstanceModel", 4)
 			.addUniformBlock("CameraMatrices", 0);
 		auto shader = std::make_shared<avt::Shader>(params);
 		
@@ -85,6 +86,7 @@ public:
 		createCams(win);
 		createShaders();
 		createScene();
+		_renderer.setTaskSystem(&_tasks);
 		avt::Input::setCursorMode(avt::CursorMode::Captured);
 	}
 
@@ -114,6 +116,10 @@ public:
 			_cam->setPosition(avt::Vector3(5.f, 5.f, 5.f));
 			_cam->lookAt({});
 		}
+		if (avt::Input::keyPressed(avt::KeyCode::R)) { // queue drawn here or recorded on the worker threads
+			auto path = _renderer.renderPath() == avt::RenderPath::Queue ? avt::RenderPath::Recorded : avt::RenderPath::Queue;
+			_renderer.setRenderPath(path);
+		}
 		if (avt::Input::mouseBtnPressed(avt::MouseCode::BtnLeft)) {
 		}
 	}
@@ -127,7 +133,9 @@ public:
 		_frames[FRAME_N - 1] = dt;
 		avg = (avg + dt) / (float)FRAME_N;
 
-		glfwSetWindowTitle(win, std::to_string((int)(1.f/avg)).c_str());
+		auto& gl = avt::GLState::lastFrame();
+		std::string title = std::to_string((int)(1.f/avg)) + " fps, " + std::to_string(gl.issued()) + " binds (" + std::to_string(gl.filtered()) + " skipped)";
+		glfwSetWindowTitle(win, title.c_str());
 	}
 
 	void onUpdate(GLFWwindow* win, float dt) override {